@@ -16,23 +16,36 @@
 #include <vector>
 #include <iomanip>
 #include <omp.h>
+#include "per_thread.hpp"
+#include "vetor_numa.hpp"
+#include "ambiente_omp.hpp"
+
+int main(int, char* argv[]) {
+    // Fixa as threads nos núcleos, se o usuário não escolheu (ver 011_numa_0.0)
+    garantir_ambiente_omp(argv, {{"OMP_PROC_BIND", "close"}, {"OMP_PLACES", "cores"}});
 
-int main() {
     // Aumente N para tempos mais visíveis
     const int N = 1'000'000;
 
-    std::vector<double> x(N), y(N), z(N), a(N);
+    // VetorNuma não zera os vetores: cada página é tocada primeiro pela
+    // thread que vai processá-la (first touch, ver 011_numa_0.0)
+    VetorNuma<double> x(N), y(N), z(N), a(N);
 
-    // Inicialização sequencial (fora do timing principal)
+    // Inicialização paralela com o mesmo schedule(static) do cálculo (fora do timing principal)
+    #pragma omp parallel for schedule(static)
     for (int i = 0; i < N; ++i) {
         x[i] = i * 0.5;
         y[i] = i * 0.5 + 1.0;
         z[i] = i * 0.5 + 2.0;
+        a[i] = 0.0;
     }
 
-    // Vetor para armazenar o tempo gasto por thread
-    // Tamanho = máximo de threads possível neste processo
-    std::vector<double> thread_time(omp_get_max_threads(), 0.0);
+    // Tempo gasto por thread
+    // Tamanho = máximo de threads possível neste processo.
+    // PerThread (per_thread.hpp) põe cada posição numa linha de cache própria:
+    // num std::vector<double> os tempos vizinhos dividiriam a mesma linha
+    // e as escritas de uma thread atrapalhariam as outras (false sharing).
+    PerThread<double> thread_time;
 
     int threads_usadas = 0;
 
@@ -41,8 +54,6 @@ int main() {
 
     #pragma omp parallel
     {
-        int tid = omp_get_thread_num();
-
         // Descobrir o número de threads efetivamente utilizado
         #pragma omp single
         {
@@ -59,7 +70,7 @@ int main() {
         }
 
         double t1 = omp_get_wtime();
-        thread_time[tid] += (t1 - t0);
+        thread_time.local() += (t1 - t0);
     }
 
     double T1 = omp_get_wtime();
@@ -54,6 +54,7 @@ permitindo que threads diferentes atualizem recursos diferentes ao mesmo tempo.
 #include <vector>
 #include <cmath>
 #include <omp.h>
+#include "per_thread.hpp"
 
 // Função resolver_bhaskara 
 double resolver_bhaskara(double a, double b, double c) {
@@ -68,13 +69,24 @@ int main() {
     const int N = 1000;
     std::vector<double> a(N, 1.0), b(N, -5.0), c(N, 6.0);
 
+    // Cada recurso compartilhado = uma soma + o lock que a protege.
+    // LinhaPropria (per_thread.hpp) põe cada recurso numa linha de cache
+    // própria: declaradas lado a lado, soma_pares e soma_impares dividiriam
+    // a mesma linha, e quem atualiza os pares invalidaria a linha de quem
+    // atualiza os ímpares (false sharing), mesmo com locks diferentes.
+    struct Recurso {
+        omp_lock_t lock;
+        double soma = 0.0;
+    };
+    LinhaPropria<Recurso> pares, impares;
+
     // Variáveis que representam dois recursos compartilhados diferentes
-    double soma_pares = 0.0;
-    double soma_impares = 0.0;
+    double& soma_pares = pares.valor.soma;
+    double& soma_impares = impares.valor.soma;
 
-    // Declaração de duas variáveis de lock, uma para cada recurso
-    omp_lock_t lock_pares;
-    omp_lock_t lock_impares;
+    // Duas variáveis de lock, uma para cada recurso
+    omp_lock_t& lock_pares = pares.valor.lock;
+    omp_lock_t& lock_impares = impares.valor.lock;
 
     // 1. Inicializa os locks antes de usá-los.
     // Isso prepara a estrutura do lock para ser utilizada.
@@ -0,0 +1,444 @@
+/*--------------------------------------------
+ Exemplos de sincronização de threads.
+---------------------------------*/
+
+/*--------------------------------------------
+medindo o custo de cada estratégia
+-------------------------------------------*/
+
+/*
+ Os exemplos 006_sincronizacao_0.1 (critical), 0.2 (atomic), 0.5 (locks) e
+ 007_reduction_0.0 (reduction) somam as raízes de Bhaskara do mesmo jeito,
+ cada um com uma forma de proteger a variável compartilhada.
+ Todos dizem qual é "mais rápida" — nenhum mede.
+
+ Este programa mede. Ele roda cada estratégia variando:
+   - n          : número de equações;
+   - threads    : lista de números de threads (curva de escalabilidade);
+   - contencao  : fração das iterações que atualizam a variável compartilhada.
+                  1.0 = toda iteração (o caso dos exemplos 006);
+                  0.01 = uma a cada 100 (as demais somam numa variável local
+                  e entregam uma única vez no final);
+                  0 = nenhuma (só a entrega final de cada thread);
+   - custo      : quantas equações cada iteração resolve antes de atualizar
+                  (simula trabalho útil entre as sincronizações).
+
+ E reporta, para cada combinação:
+   - ns/op      : tempo por iteração, em nanossegundos;
+   - speedup    : tempo serial (sem OpenMP) / tempo da estratégia;
+   - eficiencia : speedup / threads.
+ Saída em tabela (padrão), CSV ou JSON, para virar gráfico.
+*/
+
+/*--------------------------------------------
+ Estratégias medidas
+-------------------------------------------*/
+/*
+   critical     -> #pragma omp critical              (006_sincronizacao_0.1)
+   atomic       -> #pragma omp atomic                (006_sincronizacao_0.2)
+   lock         -> um omp_lock_t                     (006_sincronizacao_0.5, 1 recurso)
+   locks_par    -> dois omp_lock_t, escolhidos i % 2 (006_sincronizacao_0.5)
+   reduction    -> reduction(+:soma)                 (007_reduction_0.0)
+                   (não tem variável compartilhada: ignora a contenção)
+*/
+
+/*--------------------------------------------
+ Uso
+-------------------------------------------*/
+/*
+   ./006_sincronizacao_0.7 [--n=1000000] [--threads=1,2,4,8] [--contencao=1,0.1,0.01]
+                           [--custo=1] [--repeticoes=5] [--formato=tabela|csv|json]
+
+   Exemplos:
+   ./006_sincronizacao_0.7 --formato=csv > sinc.csv
+   ./006_sincronizacao_0.7 --threads=1,2,4,8,16 --contencao=1 --custo=1,10,100
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <omp.h>
+#include <iomanip>
+
+// Função para retornar a SOMA das raízes de Bhaskara (a mesma do 007_reduction_0.0)
+double soma_raizes_bhaskara(double a, double b, double c) {
+    double delta = (b * b) - (4 * a * c);
+    if (delta < 0) return 0.0;
+    double x1 = (-b + std::sqrt(delta)) / (2 * a);
+    double x2 = (-b - std::sqrt(delta)) / (2 * a);
+    return x1 + x2;
+}
+
+struct Dados {
+    std::vector<double> a, b, c;
+};
+
+struct Config {
+    std::int64_t n;
+    int          threads;
+    double       contencao;
+    int          custo;
+
+    // a iteração i atualiza a variável compartilhada quando i % periodo == 0;
+    // periodo = 0 (contencao = 0): nenhuma iteração toca a variável compartilhada
+    std::int64_t periodo() const {
+        if (contencao <= 0.0) return 0;
+        return std::max<std::int64_t>(1, std::llround(1.0 / contencao));
+    }
+};
+
+// Trabalho útil de uma iteração: "custo" equações vizinhas
+inline double carga(const Dados& d, std::int64_t i, int custo) {
+    double s = 0.0;
+    for (int k = 0; k < custo; ++k) {
+        s += soma_raizes_bhaskara(d.a[i], d.b[i] - 1e-3 * k, d.c[i]);
+    }
+    return s;
+}
+
+/*--------------------------------------------
+ As estratégias
+-------------------------------------------*/
+// Todas devolvem a mesma soma: as iterações "sem contenção" somam numa
+// variável local, entregue com a mesma primitiva uma vez por thread no final.
+
+double serial(const Dados& d, const Config& cfg) {
+    double soma = 0.0;
+    for (std::int64_t i = 0; i < cfg.n; ++i) soma += carga(d, i, cfg.custo);
+    return soma;
+}
+
+double com_critical(const Dados& d, const Config& cfg) {
+    double soma_total = 0.0;
+    const std::int64_t periodo = cfg.periodo();
+
+    #pragma omp parallel num_threads(cfg.threads)
+    {
+        double local = 0.0;
+        #pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < cfg.n; ++i) {
+            const double v = carga(d, i, cfg.custo);
+            if (periodo != 0 && i % periodo == 0) {
+                #pragma omp critical
+                soma_total += v;
+            } else {
+                local += v;
+            }
+        }
+        #pragma omp critical
+        soma_total += local;
+    }
+    return soma_total;
+}
+
+double com_atomic(const Dados& d, const Config& cfg) {
+    double soma_total = 0.0;
+    const std::int64_t periodo = cfg.periodo();
+
+    #pragma omp parallel num_threads(cfg.threads)
+    {
+        double local = 0.0;
+        #pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < cfg.n; ++i) {
+            const double v = carga(d, i, cfg.custo);
+            if (periodo != 0 && i % periodo == 0) {
+                #pragma omp atomic
+                soma_total += v;
+            } else {
+                local += v;
+            }
+        }
+        #pragma omp atomic
+        soma_total += local;
+    }
+    return soma_total;
+}
+
+double com_lock(const Dados& d, const Config& cfg) {
+    double soma_total = 0.0;
+    const std::int64_t periodo = cfg.periodo();
+    omp_lock_t lock;
+    omp_init_lock(&lock);
+
+    #pragma omp parallel num_threads(cfg.threads)
+    {
+        double local = 0.0;
+        #pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < cfg.n; ++i) {
+            const double v = carga(d, i, cfg.custo);
+            if (periodo != 0 && i % periodo == 0) {
+                omp_set_lock(&lock);
+                soma_total += v;
+                omp_unset_lock(&lock);
+            } else {
+                local += v;
+            }
+        }
+        omp_set_lock(&lock);
+        soma_total += local;
+        omp_unset_lock(&lock);
+    }
+
+    omp_destroy_lock(&lock);
+    return soma_total;
+}
+
+double com_locks_par_impar(const Dados& d, const Config& cfg) {
+    double soma_pares = 0.0;
+    double soma_impares = 0.0;
+    const std::int64_t periodo = cfg.periodo();
+    omp_lock_t lock_pares, lock_impares;
+    omp_init_lock(&lock_pares);
+    omp_init_lock(&lock_impares);
+
+    #pragma omp parallel num_threads(cfg.threads)
+    {
+        double local = 0.0;
+        #pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < cfg.n; ++i) {
+            const double v = carga(d, i, cfg.custo);
+            // com periodo > 1 as iterações sincronizadas são i = 0, p, 2p, ...:
+            // alterna o lock pela posição na sequência, como o i % 2 do 0.5
+            if (periodo != 0 && i % periodo == 0) {
+                if ((i / periodo) % 2 == 0) {
+                    omp_set_lock(&lock_pares);
+                    soma_pares += v;
+                    omp_unset_lock(&lock_pares);
+                } else {
+                    omp_set_lock(&lock_impares);
+                    soma_impares += v;
+                    omp_unset_lock(&lock_impares);
+                }
+            } else {
+                local += v;
+            }
+        }
+        omp_set_lock(&lock_pares);
+        soma_pares += local;
+        omp_unset_lock(&lock_pares);
+    }
+
+    omp_destroy_lock(&lock_pares);
+    omp_destroy_lock(&lock_impares);
+    return soma_pares + soma_impares;
+}
+
+double com_reduction(const Dados& d, const Config& cfg) {
+    double soma_total = 0.0;
+    #pragma omp parallel for num_threads(cfg.threads) schedule(static) reduction(+:soma_total)
+    for (std::int64_t i = 0; i < cfg.n; ++i) {
+        soma_total += carga(d, i, cfg.custo);
+    }
+    return soma_total;
+}
+
+struct Estrategia {
+    const char* nome;
+    double (*executar)(const Dados&, const Config&);
+};
+
+const Estrategia ESTRATEGIAS[] = {
+    {"critical",  com_critical},
+    {"atomic",    com_atomic},
+    {"lock",      com_lock},
+    {"locks_par", com_locks_par_impar},
+    {"reduction", com_reduction},
+};
+
+/*--------------------------------------------
+ Medição
+-------------------------------------------*/
+// Mediana de várias repetições: um pico de interferência do sistema não distorce o resultado
+template <typename F>
+double medir(F&& f, int repeticoes, double& resultado) {
+    std::vector<double> tempos;
+    for (int r = 0; r < repeticoes; ++r) {
+        const double t0 = omp_get_wtime();
+        resultado = f();
+        tempos.push_back(omp_get_wtime() - t0);
+    }
+    std::sort(tempos.begin(), tempos.end());
+    return tempos[tempos.size() / 2];
+}
+
+struct Linha {
+    std::string  estrategia;
+    std::int64_t n;
+    int          threads;
+    double       contencao;
+    int          custo;
+    double       tempo_s;
+    double       ns_op;
+    double       speedup;
+    double       eficiencia;
+    bool         correto;
+};
+
+/*--------------------------------------------
+ Argumentos
+-------------------------------------------*/
+template <typename T>
+std::vector<T> lista(const std::string& texto) {
+    std::vector<T> valores;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        std::stringstream conv(item);
+        T v{};
+        conv >> v;
+        valores.push_back(v);
+    }
+    return valores;
+}
+
+bool opcao(const char* arg, const char* nome, std::string& valor) {
+    const std::size_t len = std::strlen(nome);
+    if (std::strncmp(arg, nome, len) != 0 || arg[len] != '=') return false;
+    valor = arg + len + 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::int64_t n = 1'000'000;
+    int repeticoes = 5;
+    std::string formato = "tabela";
+    std::vector<int> threads;
+    std::vector<double> contencoes = {1.0, 0.01};
+    std::vector<int> custos = {1};
+
+    for (int k = 1; k < argc; ++k) {
+        std::string v;
+        if      (opcao(argv[k], "--n", v))          n = std::strtoll(v.c_str(), nullptr, 10);
+        else if (opcao(argv[k], "--threads", v))    threads = lista<int>(v);
+        else if (opcao(argv[k], "--contencao", v))  contencoes = lista<double>(v);
+        else if (opcao(argv[k], "--custo", v))      custos = lista<int>(v);
+        else if (opcao(argv[k], "--repeticoes", v)) repeticoes = std::max(1, std::atoi(v.c_str()));
+        else if (opcao(argv[k], "--formato", v))    formato = v;
+        else {
+            std::cerr << "Argumento desconhecido: " << argv[k] << "\n";
+            return 1;
+        }
+    }
+
+    for (int t : threads) {
+        if (t < 1) {
+            std::cerr << "--threads: cada valor deve ser >= 1 (recebido " << t << ")\n";
+            return 1;
+        }
+    }
+    for (double c : contencoes) {
+        if (!(c >= 0.0 && c <= 1.0)) {
+            std::cerr << "--contencao: cada valor deve estar em [0, 1] (recebido " << c << ")\n";
+            return 1;
+        }
+    }
+
+    // padrão: 1, 2, 4, ... até o número de threads disponíveis
+    if (threads.empty()) {
+        for (int t = 1; t < omp_get_max_threads(); t *= 2) threads.push_back(t);
+        threads.push_back(omp_get_max_threads());
+    }
+
+    // Equações do 006_sincronizacao_0.1: raízes 2 e 3, soma 5
+    Dados d;
+    d.a.assign(n, 1.0);
+    d.b.assign(n, -5.0);
+    d.c.assign(n, 6.0);
+
+    std::vector<Linha> linhas;
+    for (int custo : custos) {
+        // a referência serial depende só do custo
+        Config base{n, 1, 1.0, custo};
+        double esperado = 0.0;
+        const double t_serial = medir([&] { return serial(d, base); }, repeticoes, esperado);
+
+        for (double contencao : contencoes) {
+            for (const auto& e : ESTRATEGIAS) {
+                for (int t : threads) {
+                    const Config cfg{n, t, contencao, custo};
+                    double soma = 0.0;
+                    const double tempo = medir([&] { return e.executar(d, cfg); }, repeticoes, soma);
+                    const double speedup = t_serial / tempo;
+                    linhas.push_back({e.nome, n, t, contencao, custo, tempo,
+                                      tempo * 1e9 / static_cast<double>(n), speedup, speedup / t,
+                                      std::fabs(soma - esperado) <= 1e-9 * std::fabs(esperado)});
+                }
+            }
+        }
+    }
+
+    bool tudo_correto = true;
+    for (const auto& l : linhas) tudo_correto = tudo_correto && l.correto;
+
+    if (formato == "csv") {
+        std::cout << "estrategia,n,threads,contencao,custo,tempo_s,ns_op,speedup,eficiencia,correto\n";
+        for (const auto& l : linhas) {
+            std::cout << l.estrategia << ',' << l.n << ',' << l.threads << ',' << l.contencao << ',' << l.custo << ','
+                      << l.tempo_s << ',' << l.ns_op << ',' << l.speedup << ',' << l.eficiencia << ','
+                      << (l.correto ? 1 : 0) << '\n';
+        }
+    } else if (formato == "json") {
+        std::cout << "[\n";
+        for (std::size_t k = 0; k < linhas.size(); ++k) {
+            const auto& l = linhas[k];
+            std::cout << "  {\"estrategia\": \"" << l.estrategia << "\", \"n\": " << l.n
+                      << ", \"threads\": " << l.threads << ", \"contencao\": " << l.contencao
+                      << ", \"custo\": " << l.custo << ", \"tempo_s\": " << l.tempo_s
+                      << ", \"ns_op\": " << l.ns_op << ", \"speedup\": " << l.speedup
+                      << ", \"eficiencia\": " << l.eficiencia << ", \"correto\": " << (l.correto ? "true" : "false")
+                      << "}" << (k + 1 < linhas.size() ? "," : "") << "\n";
+        }
+        std::cout << "]\n";
+    } else {
+        std::cout << "Sincronizacao: n = " << n << ", repeticoes = " << repeticoes << " (mediana)\n";
+        std::cout << "----------------------------------------------------------------------------\n";
+        std::cout << " estrategia | threads | contencao | custo |     ns/op | speedup | eficiencia\n";
+        std::cout << "----------------------------------------------------------------------------\n";
+        for (const auto& l : linhas) {
+            std::cout << " " << std::left << std::setw(10) << l.estrategia << std::right
+                      << " | " << std::setw(7) << l.threads
+                      << " | " << std::setw(9) << l.contencao
+                      << " | " << std::setw(5) << l.custo
+                      << " | " << std::fixed << std::setprecision(2) << std::setw(9) << l.ns_op
+                      << " | " << std::setw(7) << l.speedup
+                      << " | " << std::setw(9) << l.eficiencia * 100 << "%"
+                      << (l.correto ? "" : "  SOMA ERRADA") << "\n"
+                      << std::defaultfloat;
+        }
+        std::cout << "----------------------------------------------------------------------------\n";
+    }
+
+    return tudo_correto ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Com contencao = 1 (toda iteração sincroniza) e custo = 1, a ordem típica é
+   reduction  <<  atomic  <  lock  ≈  critical. Com várias threads, critical e
+   lock costumam ficar MAIS LENTOS que o serial: as threads passam o tempo
+   disputando a mesma linha de cache.
+
+2. locks_par divide a disputa em dois, mas com 8 ou 16 threads dois locks
+   ainda são pouco: a disputa só cai de verdade com muitos locks.
+
+3. Baixando a contenção para 0.01, a diferença entre as estratégias quase
+   some: 99% das iterações somam numa variável local. É o que a reduction
+   faz sempre — por isso ela ignora esse parâmetro.
+
+4. Aumentando o custo (trabalho útil entre as sincronizações), o peso da
+   sincronização cai. Com custo alto até o critical escala: a primitiva
+   certa depende de quanto trabalho existe entre uma atualização e outra.
+
+5. O CSV tem uma linha por (estratégia, threads, contenção, custo):
+   plote ns_op ou speedup por threads, uma curva por estratégia.
+*/
@@ -0,0 +1,171 @@
+/*--------------------------------------------
+ Exemplos de sincronização de threads.
+---------------------------------*/
+
+/*--------------------------------------------
+false sharing: o custo de posições vizinhas
+-------------------------------------------*/
+
+/*
+ Em 005_loop_for_paralell_time cada thread soma o seu tempo em
+ thread_time[tid], e em 006_sincronizacao_0.5 soma_pares e soma_impares
+ ficam lado a lado. Nenhuma dessas variáveis é compartilhada de verdade:
+ cada uma tem um único "dono". Mas o cache trabalha com LINHAS de 64 bytes,
+ e 8 doubles vizinhos moram na mesma linha. Quando a thread 0 escreve na
+ posição 0, a linha inteira é invalidada no núcleo da thread 1, que precisa
+ buscá-la de novo para escrever na posição 1 — e assim por diante.
+ Isso é o FALSE SHARING (compartilhamento falso).
+
+ Este programa mede o mesmo laço de três jeitos:
+   1) contiguo   : std::vector<double> acc(T);  acc[tid] += ...
+                   (o padrão do 005 antes da correção)
+   2) PerThread  : PerThread<double> acc;       acc.local() += ...
+                   (per_thread.hpp: cada posição na sua linha de cache)
+   3) local      : double acc_local na pilha da thread, somado no final
+                   (o ideal; o que a cláusula reduction faz por dentro)
+
+ trabalho() é noinline, mas isso NÃO basta: o GCC percebe que ela não mexe
+ na memória e, com -O2, guarda acc[tid] num registrador durante o laço
+ inteiro (lê a posição uma vez antes e escreve uma vez depois). A linha
+ compartilhada quase não seria escrita e não haveria false sharing para
+ medir. Por isso, nos casos 1 e 2, o acumulador é acessado por uma
+ referência volatile: cada iteração lê e escreve a posição na memória,
+ como faria um contador de tempo ou de progresso lido por outra thread.
+
+ Uso: ./006_sincronizacao_0.8 [iteracoes por thread >= 1]
+*/
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+
+// Trabalho pequeno e opaco (o compilador não enxerga dentro)
+__attribute__((noinline)) double trabalho(std::int64_t i) {
+    return static_cast<double>(i & 7) * 0.5;
+}
+
+double contiguo(int T, std::int64_t iteracoes, double& resultado) {
+    std::vector<double> acc(T, 0.0);
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(T)
+    {
+        volatile double& meu = acc[omp_get_thread_num()];   // uma escrita na memória por iteração
+        for (std::int64_t i = 0; i < iteracoes; ++i) meu = meu + trabalho(i);
+    }
+    const double t = omp_get_wtime() - t0;
+    resultado = 0.0;
+    for (double v : acc) resultado += v;
+    return t;
+}
+
+double com_per_thread(int T, std::int64_t iteracoes, double& resultado) {
+    PerThread<double> acc(T);
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(T)
+    {
+        volatile double& meu = acc.local();
+        for (std::int64_t i = 0; i < iteracoes; ++i) meu = meu + trabalho(i);
+    }
+    const double t = omp_get_wtime() - t0;
+    resultado = acc.soma();
+    return t;
+}
+
+double local(int T, std::int64_t iteracoes, double& resultado) {
+    double total = 0.0;
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(T) reduction(+:total)
+    {
+        double acc_local = 0.0;
+        for (std::int64_t i = 0; i < iteracoes; ++i) acc_local += trabalho(i);
+        total += acc_local;
+    }
+    const double t = omp_get_wtime() - t0;
+    resultado = total;
+    return t;
+}
+
+// Melhor de 5: false sharing é um efeito de hardware, queremos o tempo sem interferência externa
+template <typename F>
+double melhor(F f, int T, std::int64_t iteracoes, double& resultado) {
+    double m = 1e30;
+    for (int r = 0; r < 5; ++r) m = std::min(m, f(T, iteracoes, resultado));
+    return m;
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t ITERACOES = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 20'000'000;
+    if (ITERACOES < 1) {
+        std::cerr << "Uso: " << argv[0] << " [iteracoes por thread >= 1]\n";
+        return 1;
+    }
+
+    std::cout << "False sharing: " << ITERACOES << " atualizacoes por thread, linha de cache = "
+              << TAMANHO_LINHA_CACHE << " bytes\n";
+    std::cout << "ns por atualizacao (menor e melhor)\n";
+    std::cout << "----------------------------------------------------------------\n";
+    std::cout << " threads |  contiguo | PerThread |     local | contiguo/PerThread\n";
+    std::cout << "----------------------------------------------------------------\n";
+
+    std::vector<int> lista_threads;
+    for (int t = 1; t < omp_get_max_threads(); t *= 2) lista_threads.push_back(t);
+    lista_threads.push_back(omp_get_max_threads());
+
+    // soma esperada por thread: (0+0.5+...+3.5) a cada 8 iterações
+    const double por_thread = static_cast<double>(ITERACOES / 8) * 14.0
+                            + [&] { double s = 0; for (std::int64_t i = 0; i < ITERACOES % 8; ++i) s += i * 0.5; return s; }();
+
+    bool ok = true;
+    for (int T : lista_threads) {
+        double r1 = 0, r2 = 0, r3 = 0;
+        const double t1 = melhor(contiguo, T, ITERACOES, r1);
+        const double t2 = melhor(com_per_thread, T, ITERACOES, r2);
+        const double t3 = melhor(local, T, ITERACOES, r3);
+        ok = ok && r1 == por_thread * T && r2 == por_thread * T && r3 == por_thread * T;
+
+        const double n = static_cast<double>(ITERACOES);
+        std::cout << std::fixed << std::setprecision(3)
+                  << " " << std::setw(7) << T
+                  << " | " << std::setw(9) << t1 * 1e9 / n
+                  << " | " << std::setw(9) << t2 * 1e9 / n
+                  << " | " << std::setw(9) << t3 * 1e9 / n
+                  << " | " << std::setw(10) << std::setprecision(2) << t1 / t2 << "x\n";
+    }
+    std::cout << "----------------------------------------------------------------\n";
+    std::cout << (ok ? "Somas conferidas.\n" : "ERRO: somas diferentes.\n");
+
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Com 1 thread (ou com todas as threads no mesmo núcleo) contiguo e
+   PerThread empatam: não há outro núcleo disputando a linha. As duas ficam
+   acima de "local" porque cada iteração passa pela memória (volatile).
+
+2. Com 2 ou mais threads em núcleos diferentes a versão contígua fica mais
+   lenta que PerThread: cada escrita invalida a linha nos outros núcleos.
+   O tamanho da diferença depende do hardware — cresce com o número de
+   núcleos disputando a linha e com a distância entre eles (outro soquete
+   é o pior caso) — e só aparece se as threads rodarem de fato em paralelo;
+   com mais threads que núcleos elas se revezam e a coluna fica perto de 1x.
+   PerThread se mantém perto do tempo de 1 thread: cada núcleo fica com a
+   sua linha.
+
+3. "local" é o melhor caso: o acumulador fica num registrador. Quando dá
+   para escrever assim (ou usar reduction), escreva. PerThread é para quando
+   o valor precisa estar na memória durante a região paralela: tempos lidos
+   por outra parte do programa, vetores de resultados por thread, flags.
+
+4. Com OMP_PROC_BIND=close e hyper-threading, duas threads podem cair no
+   mesmo núcleo físico e dividir o cache L1: aí o efeito some. Use
+   OMP_PLACES=cores para ver o pior caso.
+*/
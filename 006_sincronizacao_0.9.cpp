@@ -0,0 +1,338 @@
+/*--------------------------------------------
+ Exemplos de sincronização de threads.
+---------------------------------*/
+
+/*--------------------------------------------
+tabela com locks listrados (lock striping)
+-------------------------------------------*/
+
+/*
+ O 006_sincronizacao_0.5 divide a disputa entre DOIS locks, escolhidos por
+ i % 2. A ideia generaliza: com milhares de acumuladores (total por
+ departamento, por classe de equação, ...) não dá para ter um critical só,
+ nem precisa de um lock por acumulador.
+
+ Lock striping ("listras" de locks):
+   - a tabela tem K chaves (acumuladores) e S locks (listras), S << K;
+   - a chave k é protegida pelo lock  listra(k) = espalhar(k) & (S − 1);
+   - duas threads só disputam quando suas chaves caem na mesma listra.
+ S = 1 é o critical, S = 2 é o par/ímpar do 0.5; aumentando S a chance de
+ colisão cai ~1/S e a tabela acompanha o número de núcleos.
+
+ Cada lock fica numa linha de cache própria (LinhaPropria, per_thread.hpp):
+ senão, pegar o lock da listra 0 invalidaria a linha do lock da listra 1.
+*/
+
+/*--------------------------------------------
+ Tipos de lock (plugáveis)
+-------------------------------------------*/
+/*
+   LockOmp         : omp_lock_t (006_sincronizacao_0.5). Pode dormir no sistema
+                     operacional quando a espera é longa.
+   LockOmpAninhado : omp_nest_lock_t. A MESMA thread pode travar de novo sem
+                     travar a si mesma (útil quando uma atualização chama outra
+                     da mesma listra); custa um pouco mais.
+   SpinTTAS        : test-and-test-and-set. Espera lendo (sem escrever) até o
+                     lock parecer livre, só então tenta o exchange: a linha não
+                     fica pulando entre núcleos enquanto espera.
+   LockTicket      : senha de banco. Cada thread pega uma senha (fetch_add) e
+                     espera a sua vez: ordem de chegada garantida (justo), mas
+                     sofre se a thread da vez perder o processador.
+
+ Todos têm a mesma interface: travar() / destravar().
+ Os dois spinlocks cedem o processador (yield) depois de muitas voltas: sem
+ isso, com mais threads que núcleos, quem espera gasta o tempo de quem
+ segura o lock.
+*/
+
+/*--------------------------------------------
+ Uso
+-------------------------------------------*/
+/*
+   ./006_sincronizacao_0.9 [atualizacoes] [chaves]
+   Padrão: 4 000 000 atualizações em 2400 chaves (os grupos
+   região × departamento × cargo do 007_reduction_0.4).
+*/
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+
+// Dica ao processador de que estamos num laço de espera
+inline void pausa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+const int VOLTAS_ANTES_DO_YIELD = 1024;
+
+class LockOmp {
+public:
+    LockOmp()  { omp_init_lock(&l_); }
+    ~LockOmp() { omp_destroy_lock(&l_); }
+    LockOmp(const LockOmp&) = delete;
+    LockOmp& operator=(const LockOmp&) = delete;
+
+    void travar()    { omp_set_lock(&l_); }
+    void destravar() { omp_unset_lock(&l_); }
+
+private:
+    omp_lock_t l_;
+};
+
+class LockOmpAninhado {
+public:
+    LockOmpAninhado()  { omp_init_nest_lock(&l_); }
+    ~LockOmpAninhado() { omp_destroy_nest_lock(&l_); }
+    LockOmpAninhado(const LockOmpAninhado&) = delete;
+    LockOmpAninhado& operator=(const LockOmpAninhado&) = delete;
+
+    void travar()    { omp_set_nest_lock(&l_); }
+    void destravar() { omp_unset_nest_lock(&l_); }
+
+private:
+    omp_nest_lock_t l_;
+};
+
+class SpinTTAS {
+public:
+    void travar() {
+        for (int voltas = 0;; ) {
+            // test-and-set: só escreve quando parece livre
+            if (!ocupado_.exchange(true, std::memory_order_acquire)) return;
+            // test: espera só lendo (a linha fica em modo compartilhado no cache)
+            while (ocupado_.load(std::memory_order_relaxed)) {
+                pausa();
+                if (++voltas == VOLTAS_ANTES_DO_YIELD) { std::this_thread::yield(); voltas = 0; }
+            }
+        }
+    }
+    void destravar() { ocupado_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> ocupado_{false};
+};
+
+class LockTicket {
+public:
+    void travar() {
+        const std::uint32_t minha = proxima_.fetch_add(1, std::memory_order_relaxed);
+        for (int voltas = 0; atendendo_.load(std::memory_order_acquire) != minha; ) {
+            pausa();
+            if (++voltas == VOLTAS_ANTES_DO_YIELD) { std::this_thread::yield(); voltas = 0; }
+        }
+    }
+    // só quem tem o lock escreve em atendendo_: load + store basta
+    void destravar() {
+        atendendo_.store(atendendo_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<std::uint32_t> proxima_{0};
+    std::atomic<std::uint32_t> atendendo_{0};
+};
+
+/*--------------------------------------------
+ A tabela
+-------------------------------------------*/
+template <typename Lock, typename T = double>
+class TabelaListrada {
+public:
+    // listras é arredondado para potência de 2 (a escolha da listra vira um AND)
+    TabelaListrada(std::size_t chaves, std::size_t listras)
+        : valores_(chaves, T{}),
+          nlistras_(potencia_de_dois(listras)),
+          mascara_(nlistras_ - 1),
+          locks_(new LinhaPropria<Lock>[nlistras_]) {}
+
+    std::size_t listra(std::size_t chave) const { return espalhar(chave) & mascara_; }
+
+    void adicionar(std::size_t chave, const T& v) {
+        Lock& l = locks_[listra(chave)].valor;
+        l.travar();
+        valores_[chave] += v;
+        l.destravar();
+    }
+
+    // Atualização qualquer sob o lock da chave: f(T&)
+    template <typename F>
+    void atualizar(std::size_t chave, F&& f) {
+        Lock& l = locks_[listra(chave)].valor;
+        l.travar();
+        f(valores_[chave]);
+        l.destravar();
+    }
+
+    // Move v de uma chave para outra. Duas listras: trava sempre a de menor índice
+    // primeiro — duas transferências em sentidos opostos não se travam (deadlock).
+    void transferir(std::size_t de, std::size_t para, const T& v) {
+        std::size_t a = listra(de), b = listra(para);
+        if (a == b) {
+            atualizar(de, [&](T& x) { x -= v; valores_[para] += v; });
+            return;
+        }
+        if (a > b) std::swap(a, b);
+        locks_[a].valor.travar();
+        locks_[b].valor.travar();
+        valores_[de] -= v;
+        valores_[para] += v;
+        locks_[b].valor.destravar();
+        locks_[a].valor.destravar();
+    }
+
+    // Leitura fora da região paralela (sem lock)
+    const T& operator[](std::size_t chave) const { return valores_[chave]; }
+    std::size_t chaves() const { return valores_.size(); }
+    std::size_t listras() const { return nlistras_; }
+
+private:
+    static std::size_t potencia_de_dois(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // mistura os bits: chaves vizinhas (ex.: departamentos 10, 11, 12) caem em listras distantes
+    static std::size_t espalhar(std::size_t x) {
+        std::uint64_t h = static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h ^ (h >> 29));
+    }
+
+    std::vector<T>                           valores_;
+    std::size_t                              nlistras_;
+    std::size_t                              mascara_;
+    std::unique_ptr<LinhaPropria<Lock>[]>    locks_;
+};
+
+/*--------------------------------------------
+ Medição
+-------------------------------------------*/
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+struct Carga {
+    std::vector<std::uint32_t> chave;
+    std::vector<double>        valor;   // salários em centavos inteiros: a soma é exata em qualquer ordem
+    std::vector<double>        esperado;
+};
+
+Carga gerar(std::int64_t n, std::size_t chaves) {
+    Carga c;
+    c.chave.resize(n);
+    c.valor.resize(n);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const std::uint64_t r = splitmix64(static_cast<std::uint64_t>(i));
+        c.chave[i] = static_cast<std::uint32_t>(r % chaves);
+        c.valor[i] = static_cast<double>(400000 + (r >> 40) % 1600000);   // R$ 4 mil a 20 mil
+    }
+    c.esperado.assign(chaves, 0.0);
+    for (std::int64_t i = 0; i < n; ++i) c.esperado[c.chave[i]] += c.valor[i];
+    return c;
+}
+
+template <typename Lock>
+void medir(const char* nome, const Carga& c, std::size_t chaves, const std::vector<std::size_t>& listras, bool& ok) {
+    const std::int64_t n = static_cast<std::int64_t>(c.chave.size());
+    std::cout << " " << std::left << std::setw(16) << nome << std::right;
+
+    for (std::size_t s : listras) {
+        TabelaListrada<Lock> tabela(chaves, s);
+
+        const double t0 = omp_get_wtime();
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < n; ++i) {
+            tabela.adicionar(c.chave[i], c.valor[i]);
+        }
+        const double t = omp_get_wtime() - t0;
+
+        for (std::size_t k = 0; k < chaves; ++k) ok = ok && tabela[k] == c.esperado[k];
+        std::cout << " | " << std::fixed << std::setprecision(1) << std::setw(7) << t * 1e9 / static_cast<double>(n);
+    }
+    std::cout << " |\n";
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 4'000'000;
+    const std::int64_t chaves = (argc > 2) ? std::strtoll(argv[2], nullptr, 10) : 2400;
+    if (N < 1 || chaves < 1) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 1] [CHAVES >= 1]\n";
+        return 1;
+    }
+    const std::size_t CHAVES = static_cast<std::size_t>(chaves);
+
+    const Carga carga = gerar(N, CHAVES);
+    const std::vector<std::size_t> listras = {1, 2, 8, 64, 1024};
+
+    std::cout << "Tabela listrada: " << N << " atualizacoes em " << CHAVES << " chaves, threads = "
+              << omp_get_max_threads() << "\n";
+    std::cout << "ns por atualizacao, por numero de listras (locks)\n";
+    std::cout << "---------------------------------------------------------------------\n";
+    std::cout << " lock            ";
+    for (std::size_t s : listras) std::cout << " | " << std::setw(7) << s;
+    std::cout << " |";
+    std::cout << "\n---------------------------------------------------------------------\n";
+
+    bool ok = true;
+    medir<LockOmp>("omp_lock_t", carga, CHAVES, listras, ok);
+    medir<LockOmpAninhado>("omp_nest_lock_t", carga, CHAVES, listras, ok);
+    medir<SpinTTAS>("spin TTAS", carga, CHAVES, listras, ok);
+    medir<LockTicket>("ticket", carga, CHAVES, listras, ok);
+    std::cout << "---------------------------------------------------------------------\n";
+
+    // transferências cruzadas: nenhuma pode travar, e o total não muda
+    TabelaListrada<SpinTTAS> contas(CHAVES, 64);
+    for (std::size_t k = 0; k < CHAVES; ++k) contas.adicionar(k, 1000.0);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < 1'000'000; ++i) {
+        const std::uint64_t r = splitmix64(static_cast<std::uint64_t>(i) + 12345);
+        contas.transferir(r % CHAVES, (r >> 32) % CHAVES, 1.0);
+    }
+    double total = 0.0;
+    for (std::size_t k = 0; k < CHAVES; ++k) total += contas[k];
+    ok = ok && total == 1000.0 * static_cast<double>(CHAVES);
+
+    std::cout << (ok ? "Totais por chave conferidos; transferencias preservaram o total.\n"
+                     : "ERRO: totais divergentes.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Coluna "1": um lock para tudo, equivalente ao critical. Coluna "2": o
+   par/ímpar do 006_sincronizacao_0.5. Com várias threads as duas colunas
+   são as piores; o tempo cai à medida que as listras aumentam e as threads
+   deixam de se encontrar.
+
+2. Passando de ~(threads × 8) listras o ganho acaba: a chance de colisão já
+   é pequena, e mais locks só ocupam cache.
+
+3. Com uma única thread (ou listras de sobra) o custo é o do lock sem
+   disputa: os spinlocks ficam à frente do omp_lock_t, e o nest_lock é o
+   mais caro (guarda dono e contador).
+
+4. Com mais threads que núcleos, o ticket lock é o que mais sofre: se a
+   thread da vez perder o processador, todas as outras esperam por ela.
+
+5. Se as somas podem ser feitas em parciais por thread e combinadas no
+   final (007_reduction_0.4), prefira: nenhum lock vence "nenhum lock".
+   A tabela listrada é para quando o valor precisa estar atualizado
+   DURANTE a execução (ex.: saldos, contadores consultados por outras threads).
+*/
@@ -124,17 +124,25 @@ O openmp fará isso de forma independente e paralela, cuidando
 #include <cmath>
 #include <omp.h>
 #include <iomanip>
+#include "vetor_numa.hpp"
+#include "ambiente_omp.hpp"
+
+int main(int, char* argv[]) {
+    // Fixa as threads nos núcleos, se o usuário não escolheu (ver 011_numa_0.0)
+    garantir_ambiente_omp(argv, {{"OMP_PROC_BIND", "close"}, {"OMP_PLACES", "cores"}});
 
-int main() {
     // Exemplo: salários empresa fictícia
     const int DEPARTAMENTOS = 100;
     const int FUNCIONARIOS  = 500;
     const int N = DEPARTAMENTOS * FUNCIONARIOS;
 
-    std::vector<double> salarios(N);
+    // VetorNuma não zera o vetor: a inicialização abaixo é o primeiro toque,
+    // e com o mesmo schedule(static) das reduções cada thread fica com as
+    // páginas que vai ler (ver 011_numa_0.0)
+    VetorNuma<double> salarios(N);
 
     // Inicialização parallel apenas para produzir dados de exemplo
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (int i = 0; i < N; ++i) {
         // salário base 4000 + variação com padrão simples
         salarios[i] = 4000.0 + (i % 100) * 20.0;
@@ -145,7 +153,7 @@ int main() {
     // ---------------------------
     double soma = 0.0;
 
-    #pragma omp parallel for reduction(+:soma)
+    #pragma omp parallel for schedule(static) reduction(+:soma)
     for (int i = 0; i < N; ++i) {
         soma += salarios[i];
     }
@@ -158,7 +166,7 @@ int main() {
     // ----------------------------------------------------
     double soma_desvios2 = 0.0;
 
-    #pragma omp parallel for reduction(+:soma_desvios2)
+    #pragma omp parallel for schedule(static) reduction(+:soma_desvios2)
     for (int i = 0; i < N; ++i) {
         const double d = salarios[i] - mu;
         soma_desvios2 += d * d;
@@ -0,0 +1,325 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 007_reduction_0.3.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Single-pass mean/variance with a user-defined OpenMP reduction (Welford + Chan parallel combine)
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+/*---------------------------------------------------
+ Média e variância em UMA passada: reduction definida pelo usuário
+-----------------------------------------------------*/
+
+// No 007_reduction_0.1 a variância é calculada em DUAS passadas:
+//   1) reduction(+:soma)           -> μ
+//   2) reduction(+:soma_desvios2)  -> Σ (xᵢ − μ)²
+// Cada passada lê o vetor de salários inteiro da memória. Com vários GB
+// de salários, o tempo é dominado pela leitura: duas passadas = dobro do tráfego.
+
+// O "atalho" clássico de uma passada, σ² = Σx²/N − μ², é numericamente
+// PERIGOSO: subtrai dois números enormes e quase iguais (ver item 2 do main).
+
+/*---------------------------------------------------
+ Algoritmo de Welford (uma thread)
+-----------------------------------------------------
+ Mantém três números enquanto percorre os dados:
+   n   = quantos valores já vimos
+   μ   = média dos valores vistos
+   M2  = Σ (xᵢ − μ)²  dos valores vistos
+
+ Para cada novo x:
+   n  = n + 1
+   δ  = x − μ
+   μ  = μ + δ / n
+   M2 = M2 + δ · (x − μ)        (com o μ já atualizado)
+
+ Ao final:  σ² populacional = M2 / n     s² amostral = M2 / (n − 1)
+*/
+
+/*---------------------------------------------------
+ Fórmula de Chan (combinar duas threads)
+-----------------------------------------------------
+ Se a thread A tem (nA, μA, M2A) e a thread B tem (nB, μB, M2B):
+   n  = nA + nB
+   δ  = μB − μA
+   μ  = μA + δ · nB / n
+   M2 = M2A + M2B + δ² · nA · nB / n
+
+ Essa é exatamente a operação que o OpenMP precisa para uma reduction:
+ combinar a cópia privada de cada thread no resultado final.
+*/
+
+/*---------------------------------------------------
+ #pragma omp declare reduction
+-----------------------------------------------------
+ As reductions prontas (+, *, max, &&, ...) só funcionam com tipos simples.
+ Para o nosso trio (n, μ, M2) declaramos uma reduction nova:
+
+   #pragma omp declare reduction(nome : Tipo : combinador) initializer(valor_inicial)
+
+   - omp_out : o acumulado (quem recebe o resultado);
+   - omp_in  : a parcial de outra thread;
+   - omp_priv: a cópia privada de cada thread, criada com o valor do initializer.
+
+ Depois é só usar  reduction(nome : variavel)  como nos exemplos anteriores.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <omp.h>
+#include <iomanip>
+
+struct Estatistica {
+    double n     = 0.0;
+    double media = 0.0;
+    double m2    = 0.0;
+};
+
+// Welford: adiciona um valor
+inline void adicionar(Estatistica& e, double x) {
+    e.n += 1.0;
+    const double delta = x - e.media;
+    e.media += delta / e.n;
+    e.m2 += delta * (x - e.media);
+}
+
+// Chan: combina duas parciais
+inline Estatistica combinar(const Estatistica& a, const Estatistica& b) {
+    if (a.n == 0.0) return b;
+    if (b.n == 0.0) return a;
+    Estatistica r;
+    r.n = a.n + b.n;
+    const double delta = b.media - a.media;
+    r.media = a.media + delta * (b.n / r.n);
+    r.m2    = a.m2 + b.m2 + delta * delta * (a.n * b.n / r.n);
+    return r;
+}
+
+#pragma omp declare reduction(welford : Estatistica : omp_out = combinar(omp_out, omp_in)) \
+    initializer(omp_priv = Estatistica{})
+
+/*---------------------------------------------------
+ Versão em blocos (a usada em produção)
+-----------------------------------------------------
+ O Welford elemento a elemento faz uma DIVISÃO por valor e cada passo depende
+ do anterior: não vetoriza. A versão em blocos mantém a leitura única da
+ memória e recupera a vetorização:
+   - cada bloco de 2048 salários (16 KB, cabe no cache L1) é lido da memória;
+   - no bloco: soma -> média do bloco; depois Σ (x − média do bloco)² —
+     essa segunda volta lê o L1, não a memória;
+   - o bloco vira uma parcial (n, μ, M2) e entra na reduction(welford:...).
+*/
+Estatistica estatistica_blocos(const double* x, std::int64_t n) {
+    const std::int64_t BLOCO   = 2048;
+    const std::int64_t nblocos = (n + BLOCO - 1) / BLOCO;
+
+    Estatistica total;
+    #pragma omp parallel for schedule(static) reduction(welford:total)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0  = bl * BLOCO;
+        const std::int64_t len = std::min(BLOCO, n - i0);
+        const double* p = x + i0;
+
+        double soma = 0.0;
+        #pragma omp simd reduction(+:soma)
+        for (std::int64_t i = 0; i < len; ++i) soma += p[i];
+        const double media = soma / static_cast<double>(len);
+
+        double m2 = 0.0;
+        #pragma omp simd reduction(+:m2)
+        for (std::int64_t i = 0; i < len; ++i) {
+            const double d = p[i] - media;
+            m2 += d * d;
+        }
+
+        total = combinar(total, Estatistica{static_cast<double>(len), media, m2});
+    }
+    return total;
+}
+
+// Welford elemento a elemento (didático)
+Estatistica estatistica_welford(const double* x, std::int64_t n) {
+    Estatistica total;
+    #pragma omp parallel for schedule(static) reduction(welford:total)
+    for (std::int64_t i = 0; i < n; ++i) {
+        adicionar(total, x[i]);
+    }
+    return total;
+}
+
+// Duas passadas (igual ao 007_reduction_0.1), para comparação
+Estatistica estatistica_duas_passadas(const double* x, std::int64_t n) {
+    double soma = 0.0;
+    #pragma omp parallel for reduction(+:soma)
+    for (std::int64_t i = 0; i < n; ++i) soma += x[i];
+    const double mu = soma / static_cast<double>(n);
+
+    double soma_desvios2 = 0.0;
+    #pragma omp parallel for reduction(+:soma_desvios2)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const double d = x[i] - mu;
+        soma_desvios2 += d * d;
+    }
+    return {static_cast<double>(n), mu, soma_desvios2};
+}
+
+// "Atalho" de uma passada com soma dos quadrados (instável), para comparação
+Estatistica estatistica_soma_quadrados(const double* x, std::int64_t n) {
+    double soma = 0.0, soma2 = 0.0;
+    #pragma omp parallel for reduction(+:soma, soma2)
+    for (std::int64_t i = 0; i < n; ++i) {
+        soma  += x[i];
+        soma2 += x[i] * x[i];
+    }
+    const double mu = soma / static_cast<double>(n);
+    return {static_cast<double>(n), mu, soma2 - static_cast<double>(n) * mu * mu};
+}
+
+double variancia_populacional(const Estatistica& e) { return e.n > 0 ? e.m2 / e.n : 0.0; }
+double variancia_amostral(const Estatistica& e)     { return e.n > 1 ? e.m2 / (e.n - 1.0) : 0.0; }
+
+int main(int argc, char* argv[]) {
+    // Exercício 007_reduction_0.5: dois milhões de salários
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 2'000'000;
+    // Os dados repetem o ciclo i % 100: μ e σ² "exatos" valem só para ciclos completos
+    if (N < 100 || N % 100 != 0) {
+        std::cerr << "Uso: " << argv[0] << " [N multiplo de 100, N >= 100]\n";
+        return 1;
+    }
+    const int REPETICOES = 5;
+
+    std::vector<double> salarios(N);
+
+    #pragma omp parallel for
+    for (std::int64_t i = 0; i < N; ++i) {
+        // mesmo padrão do 007_reduction_0.1
+        salarios[i] = 4000.0 + static_cast<double>(i % 100) * 20.0;
+    }
+
+    // ---------------------------
+    // 1) Resultado e tempo de cada método
+    // ---------------------------
+    struct Metodo {
+        const char* nome;
+        Estatistica (*funcao)(const double*, std::int64_t);
+    };
+    const Metodo metodos[] = {
+        {"duas passadas (007_0.1)", estatistica_duas_passadas},
+        {"welford por elemento   ", estatistica_welford},
+        {"welford em blocos      ", estatistica_blocos},
+    };
+
+    std::cout << "Analise Salarial, N = " << N << ", threads = " << omp_get_max_threads() << "\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    std::cout << " metodo                  |    media |  var. pop. |  var. amostral | tempo (ms)\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    for (const auto& m : metodos) {
+        Estatistica e;
+        const double t0 = omp_get_wtime();
+        for (int r = 0; r < REPETICOES; ++r) e = m.funcao(salarios.data(), N);
+        const double ms = (omp_get_wtime() - t0) / REPETICOES * 1e3;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << " " << m.nome << " | " << std::setw(8) << e.media
+                  << " | " << std::setw(10) << variancia_populacional(e)
+                  << " | " << std::setw(14) << variancia_amostral(e)
+                  << " | " << std::setw(10) << std::setprecision(3) << ms << "\n";
+    }
+    std::cout << "-------------------------------------------------------------------------------\n";
+
+    const Estatistica e = estatistica_blocos(salarios.data(), N);
+    std::cout << std::setprecision(2);
+    std::cout << "Desvio-padrao populacional : R$ " << std::sqrt(variancia_populacional(e)) << "\n";
+    std::cout << "Desvio-padrao amostral     : R$ " << std::sqrt(variancia_amostral(e)) << "\n";
+
+    // ---------------------------
+    // 2) Estabilidade numérica: valores grandes com pouca variação
+    //    (ex.: salários em centavos de uma moeda desvalorizada)
+    //    Variância exata = 333300 (mesma distribuição deslocada de 1e9).
+    // ---------------------------
+    #pragma omp parallel for
+    for (std::int64_t i = 0; i < N; ++i) {
+        salarios[i] = 1e9 + static_cast<double>(i % 100) * 20.0;
+    }
+
+    const double exata = 20.0 * 20.0 * (100.0 * 100.0 - 1.0) / 12.0;
+    std::cout << "\nEstabilidade (valores em torno de 1e9, variancia exata " << exata << "):\n";
+    std::cout << "  soma dos quadrados : " << variancia_populacional(estatistica_soma_quadrados(salarios.data(), N)) << "\n";
+    std::cout << "  duas passadas      : " << variancia_populacional(estatistica_duas_passadas(salarios.data(), N)) << "\n";
+    std::cout << "  welford em blocos  : " << variancia_populacional(estatistica_blocos(salarios.data(), N)) << "\n";
+
+    return 0;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Os três métodos dão a mesma média e variância para os dados do 007_reduction_0.1
+   (μ = 4990,00; σ² = 333300,00). A variância amostral divide por N − 1.
+
+2. "welford por elemento" costuma ser o mais LENTO: uma divisão por valor e
+   uma cadeia de dependências que impede a vetorização. "welford em blocos"
+   lê a memória uma vez só e vetoriza; com vetores maiores que o cache ele
+   fica perto da metade do tempo das duas passadas.
+
+3. Com valores em torno de 1e9, a soma dos quadrados (Σx² ≈ 2·10²⁴) perde
+   todos os dígitos da variância — o resultado sai absurdo, pode até ser
+   negativo. Welford/Chan trabalham com DESVIOS em relação à média e
+   mantêm a precisão.
+
+4. A mesma reduction(welford:...) serve para qualquer laço: basta que cada
+   iteração produza uma parcial (n, μ, M2) ou chame adicionar().
+*/
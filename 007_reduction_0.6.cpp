@@ -0,0 +1,522 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 007_reduction_0.6.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Median, P90, P99 and IQR: exact parallel selection with OpenMP tasks and a mergeable KLL sketch
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+/*---------------------------------------------------
+ Quantis (mediana, P90, P99, IQR) em paralelo
+-----------------------------------------------------*/
+
+// Média e desvio-padrão (007_reduction_0.1 / 0.3) se calculam com reduction:
+// somas parciais se combinam somando. A MEDIANA não: a mediana de duas
+// metades não é a mediana do todo. O caminho ingênuo é ordenar o vetor
+// inteiro (O(N log N), serial) só para ler 5 posições.
+
+// Definição usada (a mesma do R tipo 7 / NumPy "linear"):
+//   h = (N − 1) · p
+//   Q(p) = x₍⌊h⌋₎ + (h − ⌊h⌋) · (x₍⌊h⌋+1₎ − x₍⌊h⌋₎)      (x₍k₎ = k-ésimo menor, base 0)
+//   IQR  = Q(0,75) − Q(0,25)
+
+/*---------------------------------------------------
+ Modo 1: seleção EXATA com tarefas (multi-quickselect)
+-----------------------------------------------------
+ Precisamos de alguns POSTOS (ranks), não do vetor ordenado:
+   1) escolhe um pivô (mediana de uma amostra);
+   2) particiona em três faixas: < pivô | == pivô | > pivô;
+      (a faixa do meio resolve os valores repetidos, comuns em salários)
+   3) cada posto cai em uma faixa; postos na faixa do meio já estão prontos;
+   4) as faixas da esquerda e da direita que ainda têm postos viram
+      TAREFAS independentes (#pragma omp task).
+
+ Nos níveis de cima há pouca tarefa e muito dado, então a própria partição
+ é paralela (#pragma omp taskloop): cada bloco conta quantos vão para cada
+ faixa, uma soma de prefixos dá a posição de escrita, e cada bloco copia
+ os seus elementos para o destino sem conflito.
+*/
+
+/*---------------------------------------------------
+ Modo 2: sketch KLL (aproximado, mesclável)
+-----------------------------------------------------
+ Um resumo de tamanho fixo (~k·4 valores, independe de N) que responde
+ qualquer quantil com erro de posto limitado (~1/k relativo).
+   - nível 0 recebe os valores; cada valor no nível h "vale" 2^h valores;
+   - quando um nível enche: ordena, descarta metade (os de posição par OU
+     os de posição ímpar, sorteado) e promove o resto para o nível h+1;
+   - dois sketches se combinam juntando nível a nível e compactando.
+ Como se combina, vira uma reduction definida pelo usuário (007_reduction_0.3):
+   #pragma omp declare reduction(kll : SketchKLL : omp_out.combinar(omp_in)) ...
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <omp.h>
+#include <iomanip>
+
+/*---------------------------------------------------
+ Quantil a partir dos postos
+-----------------------------------------------------*/
+struct PostosQuantil {
+    std::int64_t baixo;
+    std::int64_t alto;
+    double       fracao;
+};
+
+PostosQuantil postos(double p, std::int64_t n) {
+    const double h = static_cast<double>(n - 1) * p;
+    const std::int64_t b = static_cast<std::int64_t>(std::floor(h));
+    return {b, std::min(b + 1, n - 1), h - static_cast<double>(b)};
+}
+
+/*---------------------------------------------------
+ Modo 1: multi-quickselect com tarefas
+-----------------------------------------------------*/
+namespace exato {
+
+const std::int64_t CORTE_SERIAL    = 1 << 15;   // abaixo disso: std::nth_element
+const std::int64_t CORTE_PARTICAO  = 1 << 20;   // acima disso: partição com taskloop
+const std::int64_t BLOCO_PARTICAO  = 1 << 16;
+
+double escolher_pivo(const double* a, std::int64_t n) {
+    // mediana de 31 amostras espaçadas: robusto a dados já ordenados
+    double amostra[31];
+    for (int i = 0; i < 31; ++i) amostra[i] = a[(n - 1) * i / 30];
+    std::nth_element(amostra, amostra + 15, amostra + 31);
+    return amostra[15];
+}
+
+// Partição em três faixas de a[0..n) usando tmp como destino; resultado volta para a.
+// Devolve (inicio da faixa ==, inicio da faixa >).
+std::pair<std::int64_t, std::int64_t> particionar(double* a, double* tmp, std::int64_t n, double pivo) {
+    if (n < CORTE_PARTICAO) {
+        double* meio  = std::partition(a, a + n, [pivo](double x) { return x < pivo; });
+        double* maior = std::partition(meio, a + n, [pivo](double x) { return x == pivo; });
+        return {meio - a, maior - a};
+    }
+
+    const std::int64_t nblocos = (n + BLOCO_PARTICAO - 1) / BLOCO_PARTICAO;
+    std::vector<std::int64_t> menores(nblocos), iguais(nblocos);
+
+    // Atenção: dentro de tarefas as variáveis locais são firstprivate por padrão;
+    // sem shared(...) cada tarefa escreveria numa CÓPIA dos vetores.
+    #pragma omp taskloop grainsize(1) shared(menores, iguais)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0 = bl * BLOCO_PARTICAO;
+        const std::int64_t i1 = std::min(n, i0 + BLOCO_PARTICAO);
+        std::int64_t m = 0, e = 0;
+        for (std::int64_t i = i0; i < i1; ++i) {
+            m += a[i] < pivo;
+            e += a[i] == pivo;
+        }
+        menores[bl] = m;
+        iguais[bl]  = e;
+    }
+
+    // soma de prefixos: onde cada bloco escreve em cada faixa
+    std::vector<std::int64_t> pos_menor(nblocos), pos_igual(nblocos), pos_maior(nblocos);
+    std::int64_t total_menor = 0, total_igual = 0;
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) { total_menor += menores[bl]; total_igual += iguais[bl]; }
+    std::int64_t m = 0, e = total_menor, g = total_menor + total_igual;
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t tam = std::min(n, (bl + 1) * BLOCO_PARTICAO) - bl * BLOCO_PARTICAO;
+        pos_menor[bl] = m; m += menores[bl];
+        pos_igual[bl] = e; e += iguais[bl];
+        pos_maior[bl] = g; g += tam - menores[bl] - iguais[bl];
+    }
+
+    #pragma omp taskloop grainsize(1) shared(pos_menor, pos_igual, pos_maior)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0 = bl * BLOCO_PARTICAO;
+        const std::int64_t i1 = std::min(n, i0 + BLOCO_PARTICAO);
+        std::int64_t pm = pos_menor[bl], pe = pos_igual[bl], pg = pos_maior[bl];
+        for (std::int64_t i = i0; i < i1; ++i) {
+            const double x = a[i];
+            if (x < pivo)       tmp[pm++] = x;
+            else if (x == pivo) tmp[pe++] = x;
+            else                tmp[pg++] = x;
+        }
+    }
+
+    #pragma omp taskloop grainsize(1)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0 = bl * BLOCO_PARTICAO;
+        const std::int64_t i1 = std::min(n, i0 + BLOCO_PARTICAO);
+        std::copy(tmp + i0, tmp + i1, a + i0);
+    }
+
+    return {total_menor, total_menor + total_igual};
+}
+
+// Coloca em a[r] o r-ésimo menor para cada r em [r0, r1) da lista de postos (ordenada, relativa a a).
+void selecionar(double* a, double* tmp, std::int64_t n, const std::int64_t* r0, const std::int64_t* r1) {
+    if (r0 == r1 || n <= 1) return;
+
+    if (n < CORTE_SERIAL) {
+        // postos ordenados: cada nth_element restringe a faixa do próximo
+        std::int64_t inicio = 0;
+        for (const std::int64_t* r = r0; r != r1; ++r) {
+            if (*r < inicio) continue;
+            std::nth_element(a + inicio, a + *r, a + n);
+            inicio = *r + 1;
+        }
+        return;
+    }
+
+    const double pivo = escolher_pivo(a, n);
+    const auto [ini_igual, ini_maior] = particionar(a, tmp, n, pivo);
+
+    // divide a lista de postos entre as três faixas
+    const std::int64_t* fim_esq = std::lower_bound(r0, r1, ini_igual);
+    const std::int64_t* ini_dir = std::lower_bound(fim_esq, r1, ini_maior);
+
+    if (r0 != fim_esq) {
+        #pragma omp task
+        selecionar(a, tmp, ini_igual, r0, fim_esq);
+    }
+    if (ini_dir != r1) {
+        // postos da direita ficam relativos ao novo início
+        std::vector<std::int64_t> relativos(ini_dir, r1);
+        for (auto& r : relativos) r -= ini_maior;
+        #pragma omp task firstprivate(relativos)
+        selecionar(a + ini_maior, tmp + ini_maior, n - ini_maior,
+                   relativos.data(), relativos.data() + relativos.size());
+    }
+    #pragma omp taskwait
+}
+
+// Quantis exatos. Reordena parcialmente uma CÓPIA dos dados.
+std::vector<double> quantis(const std::vector<double>& dados, const std::vector<double>& ps) {
+    const std::int64_t n = static_cast<std::int64_t>(dados.size());
+    std::vector<double> a(n), tmp(n);
+
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) { a[i] = dados[i]; tmp[i] = 0.0; }
+
+    std::vector<std::int64_t> rs;
+    for (double p : ps) { auto q = postos(p, n); rs.push_back(q.baixo); rs.push_back(q.alto); }
+    std::sort(rs.begin(), rs.end());
+    rs.erase(std::unique(rs.begin(), rs.end()), rs.end());
+
+    #pragma omp parallel
+    #pragma omp single
+    selecionar(a.data(), tmp.data(), n, rs.data(), rs.data() + rs.size());
+
+    std::vector<double> resultado;
+    for (double p : ps) {
+        auto q = postos(p, n);
+        resultado.push_back(a[q.baixo] + q.fracao * (a[q.alto] - a[q.baixo]));
+    }
+    return resultado;
+}
+
+} // namespace exato
+
+/*---------------------------------------------------
+ Modo 2: sketch KLL
+-----------------------------------------------------*/
+class SketchKLL {
+public:
+    explicit SketchKLL(int k = 200, std::uint64_t semente = 1) : k_(k), estado_(semente | 1) {
+        niveis_.emplace_back();
+        recalcular();
+    }
+
+    int k() const { return k_; }
+    std::int64_t n() const { return n_; }
+
+    void adicionar(double x) {
+        niveis_[0].push_back(x);
+        ++n_;
+        if (++tamanho_ >= capacidade_total_) compactar();
+    }
+
+    SketchKLL& combinar(const SketchKLL& outro) {
+        if (outro.niveis_.size() > niveis_.size()) niveis_.resize(outro.niveis_.size());
+        for (std::size_t h = 0; h < outro.niveis_.size(); ++h) {
+            niveis_[h].insert(niveis_[h].end(), outro.niveis_[h].begin(), outro.niveis_[h].end());
+        }
+        n_ += outro.n_;
+        estado_ ^= outro.estado_;
+        recalcular();
+        while (tamanho_ >= capacidade_total_) compactar();
+        return *this;
+    }
+
+    // Quantis aproximados (mesma definição por postos do modo exato)
+    std::vector<double> quantis(const std::vector<double>& ps) const {
+        std::vector<std::pair<double, std::int64_t>> pesos;   // (valor, peso 2^h)
+        for (std::size_t h = 0; h < niveis_.size(); ++h) {
+            for (double x : niveis_[h]) pesos.emplace_back(x, std::int64_t(1) << h);
+        }
+        std::sort(pesos.begin(), pesos.end());
+
+        auto valor_no_posto = [&](std::int64_t r) {
+            std::int64_t acumulado = 0;
+            for (const auto& [x, w] : pesos) {
+                acumulado += w;
+                if (acumulado > r) return x;
+            }
+            return pesos.back().first;
+        };
+
+        std::vector<double> resultado;
+        for (double p : ps) {
+            auto q = postos(p, n_);
+            const double lo = valor_no_posto(q.baixo);
+            resultado.push_back(lo + q.fracao * (valor_no_posto(q.alto) - lo));
+        }
+        return resultado;
+    }
+
+    std::size_t valores_guardados() const { return tamanho_; }
+
+private:
+    // capacidade do nível h: k·(2/3)^(altura − 1 − h), no mínimo 8.
+    // Só muda quando a altura muda: fica guardada em capacidades_.
+    void recalcular() {
+        const std::size_t altura = niveis_.size();
+        capacidades_.resize(altura);
+        tamanho_ = 0;
+        capacidade_total_ = 0;
+        for (std::size_t h = 0; h < altura; ++h) {
+            const double c = std::pow(2.0 / 3.0, static_cast<double>(altura - 1 - h));
+            capacidades_[h] = std::max<std::size_t>(8, static_cast<std::size_t>(std::ceil(k_ * c)));
+            // nível 0 sempre com k: ordenar bloquinhos de 8 valores a cada 8 inserções custaria caro
+            if (h == 0) capacidades_[0] = static_cast<std::size_t>(k_);
+            tamanho_ += niveis_[h].size();
+            capacidade_total_ += capacidades_[h];
+        }
+    }
+
+    bool moeda() {
+        // xorshift64: barato e suficiente para sortear par/ímpar
+        estado_ ^= estado_ << 13;
+        estado_ ^= estado_ >> 7;
+        estado_ ^= estado_ << 17;
+        return estado_ & 1;
+    }
+
+    // compacta o nível mais baixo que está acima da capacidade
+    void compactar() {
+        for (std::size_t h = 0; h < niveis_.size(); ++h) {
+            if (niveis_[h].size() < capacidades_[h]) continue;
+
+            const bool cresceu = (h + 1 == niveis_.size());
+            if (cresceu) niveis_.emplace_back();
+
+            std::vector<double>& nivel = niveis_[h];
+            std::sort(nivel.begin(), nivel.end());
+
+            // número ímpar de valores: o primeiro fica no nível (não tem par)
+            const std::size_t inicio = nivel.size() % 2;
+            std::vector<double>& acima = niveis_[h + 1];
+            for (std::size_t i = inicio + moeda(); i < nivel.size(); i += 2) acima.push_back(nivel[i]);
+            tamanho_ -= (nivel.size() - inicio) / 2;
+            nivel.resize(inicio);
+
+            if (cresceu) recalcular();
+            return;
+        }
+    }
+
+    int k_;
+    std::uint64_t estado_;
+    std::vector<std::vector<double>> niveis_;
+    std::int64_t n_ = 0;
+    std::size_t tamanho_ = 0;
+    std::vector<std::size_t> capacidades_;
+    std::size_t capacidade_total_ = 0;
+};
+
+// Cada thread recebe um sketch vazio com o mesmo k e semente diferente
+#pragma omp declare reduction(kll : SketchKLL : omp_out.combinar(omp_in)) \
+    initializer(omp_priv = SketchKLL(omp_orig.k(), 0x9E3779B97F4A7C15ull * (omp_get_thread_num() + 1)))
+
+SketchKLL construir_sketch(const std::vector<double>& dados, int k) {
+    const std::int64_t n = static_cast<std::int64_t>(dados.size());
+    SketchKLL sketch(k);
+
+    #pragma omp parallel for schedule(static) reduction(kll:sketch)
+    for (std::int64_t i = 0; i < n; ++i) {
+        sketch.adicionar(dados[i]);
+    }
+    return sketch;
+}
+
+/*---------------------------------------------------
+ Dados de exemplo
+-----------------------------------------------------*/
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Salários log-normais (cauda longa à direita, como folhas reais), arredondados ao centavo
+std::vector<double> gerar_salarios(std::int64_t n) {
+    std::vector<double> s(n);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const std::uint64_t r = splitmix64(static_cast<std::uint64_t>(i));
+        const double u1 = (static_cast<double>(r >> 11) + 0.5) * 0x1.0p-53;
+        const double u2 = static_cast<double>(splitmix64(r) >> 11) * 0x1.0p-53;
+        const double z  = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);  // Box-Muller
+        s[i] = std::round(std::exp(8.8 + 0.55 * z) * 100.0) / 100.0;
+    }
+    return s;
+}
+
+int main(int argc, char* argv[]) {
+    // padrão: os dois milhões de salários do exercício 007_reduction_0.5
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 2'000'000;
+    const int K = (argc > 2) ? std::atoi(argv[2]) : 200;
+    if (N < 2 || K < 1) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 2] [k >= 1]\n";
+        return 1;
+    }
+
+    const std::vector<double> salarios = gerar_salarios(N);
+    const std::vector<double> ps = {0.25, 0.50, 0.75, 0.90, 0.99};
+
+    std::cout << "Quantis de " << N << " salarios, threads = " << omp_get_max_threads() << "\n\n";
+
+    // ---------------------------
+    // 0) Referência: ordenar tudo (serial)
+    // ---------------------------
+    double t0 = omp_get_wtime();
+    std::vector<double> ordenado = salarios;
+    std::sort(ordenado.begin(), ordenado.end());
+    std::vector<double> ref;
+    for (double p : ps) {
+        auto q = postos(p, N);
+        ref.push_back(ordenado[q.baixo] + q.fracao * (ordenado[q.alto] - ordenado[q.baixo]));
+    }
+    const double t_sort = omp_get_wtime() - t0;
+
+    // ---------------------------
+    // 1) Exato com tarefas
+    // ---------------------------
+    t0 = omp_get_wtime();
+    const std::vector<double> exatos = exato::quantis(salarios, ps);
+    const double t_exato = omp_get_wtime() - t0;
+
+    // ---------------------------
+    // 2) Sketch KLL com reduction(kll:...)
+    // ---------------------------
+    t0 = omp_get_wtime();
+    const SketchKLL sketch = construir_sketch(salarios, K);
+    const std::vector<double> aprox = sketch.quantis(ps);
+    const double t_kll = omp_get_wtime() - t0;
+
+    // erro de POSTO: que fração do vetor está abaixo do valor devolvido, comparada a p
+    auto posto_de = [&](double x) {
+        return static_cast<double>(std::lower_bound(ordenado.begin(), ordenado.end(), x) - ordenado.begin())
+               / static_cast<double>(N - 1);
+    };
+
+    bool ok = true;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "-----------------------------------------------------------------------\n";
+    std::cout << " quantil |  std::sort |  exato (tasks) |   KLL (k=" << std::setw(4) << K << ") | erro de posto\n";
+    std::cout << "-----------------------------------------------------------------------\n";
+    for (std::size_t j = 0; j < ps.size(); ++j) {
+        ok = ok && (exatos[j] == ref[j]);
+        std::cout << "  P" << std::setw(2) << std::left << static_cast<int>(ps[j] * 100 + 0.5) << std::right << "    | "
+                  << std::setw(10) << ref[j] << " | " << std::setw(14) << exatos[j] << " | "
+                  << std::setw(14) << aprox[j] << " | " << std::setw(10) << std::setprecision(4)
+                  << std::fabs(posto_de(aprox[j]) - ps[j]) * 100 << " %\n" << std::setprecision(2);
+    }
+    std::cout << "-----------------------------------------------------------------------\n";
+    std::cout << " IQR     | " << std::setw(10) << ref[2] - ref[0] << " | " << std::setw(14) << exatos[2] - exatos[0]
+              << " | " << std::setw(14) << aprox[2] - aprox[0] << " |\n\n";
+
+    std::cout << std::setprecision(3);
+    std::cout << "std::sort (serial)   : " << t_sort * 1e3 << " ms\n";
+    std::cout << "Exato com tarefas    : " << t_exato * 1e3 << " ms  " << (ok ? "(identico ao sort)" : "(DIVERGENTE!)") << "\n";
+    std::cout << "KLL com reduction    : " << t_kll * 1e3 << " ms  (" << sketch.valores_guardados()
+              << " valores guardados de " << sketch.n() << ")\n";
+
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. O modo exato devolve EXATAMENTE os mesmos valores do std::sort: ele só
+   deixa de ordenar o que não interessa. O trabalho cai de O(N log N) para
+   ~O(N) por nível de recursão, e as partições grandes usam todas as threads.
+
+2. A faixa "== pivô" é essencial: salários arredondados ao centavo repetem
+   muito. Sem ela, um pivô repetido em milhares de posições faria a
+   recursão andar quase nada a cada nível.
+
+3. O KLL guarda poucos milhares de valores, não importa se N é 2 milhões ou
+   2 bilhões. O erro de posto típico fica abaixo de ~1% com k = 200;
+   dobrar k reduz o erro pela metade e dobra a memória. Por valor ele custa
+   parecido com uma ordenação (cada compactação ordena um nível), mas em
+   memória constante e com uma única leitura dos dados: é a escolha quando
+   os salários chegam em fluxo (010_pipeline_0.0) ou não cabem na RAM.
+
+4. reduction(kll:sketch) funciona como reduction(+:soma): cada thread
+   preenche a sua cópia privada e o OpenMP chama combinar() no final.
+   O mesmo sketch pode ser combinado entre processos ou entre dias
+   (relatórios incrementais), coisa que a ordenação não permite.
+
+5. Uso: ./007_reduction_0.6 [N >= 2] [k >= 1]   (o erro de posto divide por N - 1)
+*/
@@ -0,0 +1,478 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 007_reduction_0.7.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Salary audit engine: rule set, vectorized checks, early exit with omp cancel and violation collection
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+/*---------------------------------------------------
+ Motor de auditoria com parada antecipada
+-----------------------------------------------------*/
+
+// No 007_reduction_0.2 as regras de piso, teto e positividade são avaliadas
+// com reduction(||:...) e reduction(&&:...). Funciona, mas o laço SEMPRE
+// percorre os N salários — mesmo quando, logo no começo, todas as regras
+// já foram violadas e nada mais pode mudar a resposta.
+
+/*---------------------------------------------------
+ Regras como dados
+-----------------------------------------------------
+ Cada regra é "existe algum salário que a viola?":
+   Regra 1: s <  1500      (abaixo do piso)
+   Regra 2: s >  20000     (acima do teto)
+   Regra 3: s <= 0         (não positivo — o && do 0.2 é o "não existe violação")
+   Regra 4: s != s         (NaN: valor não numérico vindo da importação)
+ Uma lista de Regra{nome, comparação, limite} substitui os ifs fixos:
+ acrescentar uma regra não exige mexer no laço.
+*/
+
+/*---------------------------------------------------
+ Comparações vetorizadas: um resumo decide todas as regras
+-----------------------------------------------------
+ Todas as regras comparam o salário com um limite. Então, para um bloco,
+ basta conhecer o MÍNIMO, o MÁXIMO e se há algum NaN:
+     s <  limite  em algum salário   <=>  mínimo <  limite
+     s >  limite  em algum salário   <=>  máximo >  limite
+     s <= limite  em algum salário   <=>  mínimo <= limite
+ Esse resumo sai de UM laço sem desvio, qualquer que seja o número de regras:
+     #pragma omp simd reduction(min:mn) reduction(max:mx) reduction(|:nan)
+ O compilador troca isso por comparações de 2, 4 ou 8 doubles por instrução.
+ (Um laço por regra leria o bloco uma vez para cada regra.)
+*/
+
+/*---------------------------------------------------
+ Parada antecipada: #pragma omp cancel for
+-----------------------------------------------------
+ - Um inteiro atômico de 64 bits guarda um bit por regra já decidida
+   (por isso auditar() aceita no máximo 64 regras).
+ - Cada bloco calcula o resumo e testa só as regras ainda em aberto.
+ - Quando todos os bits estão ligados, a thread executa
+       #pragma omp cancel for
+   e as demais, ao passarem por
+       #pragma omp cancellation point for
+   abandonam as iterações que faltam.
+
+ Atenção: o cancelamento só funciona com a variável de ambiente
+ OMP_CANCELLATION=true, lida quando o programa inicia. Por isso o main
+ chama garantir_ambiente_omp (ambiente_omp.hpp): no Linux ela define a
+ variável e reinicia o programa, avisando no stderr; nos demais sistemas
+ só mostra o que definir.
+ Sem ela o código continua correto: os blocos restantes são pulados pelo
+ teste do inteiro atômico, só um pouco mais devagar.
+*/
+
+/*---------------------------------------------------
+ Modo "coletar todas as violações"
+-----------------------------------------------------
+ Para o relatório de correção, não basta o booleano: precisamos dos ÍNDICES.
+   - cada thread acumula índices num vetor próprio (por regra) — sem lock;
+   - schedule(static) dá a cada thread uma faixa contígua e em ordem,
+     então juntar os vetores na ordem das threads já deixa tudo ordenado;
+   - uma soma de prefixos dá a posição de cada thread no vetor final e
+     a cópia é feita em paralelo.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+#include "ambiente_omp.hpp"
+
+enum class Comparacao { MENOR, MAIOR, MENOR_IGUAL, NAO_NUMERO };
+
+struct Regra {
+    std::string nome;
+    Comparacao  comparacao;
+    double      limite;
+};
+
+// Chama f com um predicado especializado para a comparação da regra:
+// o laço dentro de f é compilado uma vez por comparação e vetoriza.
+template <typename F>
+auto com_predicado(const Regra& r, F&& f) {
+    const double lim = r.limite;
+    switch (r.comparacao) {
+        case Comparacao::MENOR:       return f([lim](double x) { return x <  lim; });
+        case Comparacao::MAIOR:       return f([lim](double x) { return x >  lim; });
+        case Comparacao::MENOR_IGUAL: return f([lim](double x) { return x <= lim; });
+        case Comparacao::NAO_NUMERO:  break;
+    }
+    return f([](double x) { return x != x; });
+}
+
+// Mínimo, máximo e presença de NaN de um bloco
+struct Resumo {
+    double mn;
+    double mx;
+    bool   tem_nan;
+};
+
+Resumo resumir(const double* x, std::int64_t n) {
+    double mn = std::numeric_limits<double>::infinity();
+    double mx = -std::numeric_limits<double>::infinity();
+    int nan = 0;
+    #pragma omp simd reduction(min:mn) reduction(max:mx) reduction(|:nan)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const double v = x[i];
+        mn = v < mn ? v : mn;      // NaN falha toda comparação: não entra no min/max
+        mx = v > mx ? v : mx;
+        nan |= (v != v);
+    }
+    return {mn, mx, nan != 0};
+}
+
+// A regra é violada em algum salário do bloco?
+bool violada(const Regra& r, const Resumo& b) {
+    switch (r.comparacao) {
+        case Comparacao::MENOR:       return b.mn <  r.limite;
+        case Comparacao::MAIOR:       return b.mx >  r.limite;
+        case Comparacao::MENOR_IGUAL: return b.mn <= r.limite;
+        case Comparacao::NAO_NUMERO:  return b.tem_nan;
+    }
+    return false;
+}
+
+// Acrescenta a saida os índices violados de x[i0..i1): escrita sem desvio,
+// o contador só avança quando a regra é violada.
+void coletar_violados(const Regra& r, const double* x, std::int64_t i0, std::int64_t i1,
+                      std::int64_t* temp, std::vector<std::int64_t>& saida) {
+    com_predicado(r, [&](auto viola) {
+        std::int64_t c = 0;
+        for (std::int64_t i = i0; i < i1; ++i) {
+            temp[c] = i;
+            c += viola(x[i]);
+        }
+        saida.insert(saida.end(), temp, temp + c);
+        return 0;
+    });
+}
+
+struct ResultadoAuditoria {
+    std::vector<bool>                      violada;      // por regra
+    std::vector<std::vector<std::int64_t>> indices;      // só no modo coletar, ordenados
+    std::int64_t                           lidos = 0;    // salários efetivamente examinados
+};
+
+const std::int64_t BLOCO    = 16384;   // unidade de distribuição (e de cancelamento) entre threads
+const std::int64_t SUBBLOCO = 2048;    // modo coletar: 16 KB, o bloco relido fica no cache L1
+const std::size_t  MAX_REGRAS = 64;    // um bit por regra na máscara de auditar()
+
+/*---------------------------------------------------
+ Modo 1: booleano com parada antecipada
+-----------------------------------------------------*/
+ResultadoAuditoria auditar(const std::vector<double>& salarios, const std::vector<Regra>& regras) {
+    const std::int64_t N = static_cast<std::int64_t>(salarios.size());
+    const std::int64_t nblocos = (N + BLOCO - 1) / BLOCO;
+    if (regras.size() > MAX_REGRAS) throw std::invalid_argument("auditar: no maximo 64 regras");
+    const std::uint64_t TODAS = (regras.size() == MAX_REGRAS) ? ~std::uint64_t{0}
+                                                              : ((std::uint64_t{1} << regras.size()) - 1);
+
+    std::atomic<std::uint64_t> decididas{0};
+    std::atomic<std::int64_t>  lidos{0};
+    const double* x = salarios.data();
+
+    #pragma omp parallel
+    {
+        std::int64_t lidos_local = 0;
+
+        // dynamic: os blocos saem mais ou menos em ordem, então as violações
+        // do começo do vetor são vistas cedo
+        #pragma omp for schedule(dynamic, 1)
+        for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+            std::uint64_t mascara = decididas.load(std::memory_order_relaxed);
+
+            if (mascara != TODAS) {
+                const std::int64_t i0  = bl * BLOCO;
+                const std::int64_t len = std::min(BLOCO, N - i0);
+
+                const Resumo resumo = resumir(x + i0, len);
+                std::uint64_t novas = 0;
+                for (std::size_t r = 0; r < regras.size(); ++r) {
+                    const std::uint64_t bit = std::uint64_t{1} << r;
+                    if (mascara & bit) continue;   // regra já decidida
+                    if (violada(regras[r], resumo)) novas |= bit;
+                }
+                if (novas) mascara = decididas.fetch_or(novas, std::memory_order_relaxed) | novas;
+                lidos_local += len;
+            }
+
+            #pragma omp cancel for if(mascara == TODAS)
+            #pragma omp cancellation point for
+        }
+
+        lidos.fetch_add(lidos_local, std::memory_order_relaxed);
+    }
+
+    ResultadoAuditoria res;
+    const std::uint64_t mascara = decididas.load();
+    for (std::size_t r = 0; r < regras.size(); ++r) res.violada.push_back((mascara >> r) & 1u);
+    res.lidos = lidos.load();
+    return res;
+}
+
+/*---------------------------------------------------
+ Modo 2: coletar todas as violações
+-----------------------------------------------------*/
+ResultadoAuditoria auditar_coletando(const std::vector<double>& salarios, const std::vector<Regra>& regras) {
+    const std::int64_t N = static_cast<std::int64_t>(salarios.size());
+    const std::size_t  R = regras.size();
+    const int T = omp_get_max_threads();
+    const double* x = salarios.data();
+
+    // parciais[t][r] = índices violados da regra r encontrados pela thread t.
+    // PerThread (per_thread.hpp): cada push_back altera o tamanho guardado no
+    // cabeçalho do vetor; sem o alinhamento, os cabeçalhos de threads vizinhas
+    // dividiriam a mesma linha de cache.
+    PerThread<std::vector<std::vector<std::int64_t>>> parciais(T, std::vector<std::vector<std::int64_t>>(R));
+
+    #pragma omp parallel num_threads(T)
+    {
+        auto& minhas = parciais.local();
+        std::vector<std::int64_t> temp(SUBBLOCO);
+
+        // static sem tamanho de bloco: faixa contígua por thread, em ordem de thread
+        #pragma omp for schedule(static)
+        for (std::int64_t bl = 0; bl < (N + BLOCO - 1) / BLOCO; ++bl) {
+            const std::int64_t i0 = bl * BLOCO;
+            const std::int64_t i1 = std::min(N, i0 + BLOCO);
+            for (std::int64_t j0 = i0; j0 < i1; j0 += SUBBLOCO) {
+                const std::int64_t j1 = std::min(i1, j0 + SUBBLOCO);
+                // sub-bloco sem violação (o caso comum): só o resumo vetorizado
+                const Resumo resumo = resumir(x + j0, j1 - j0);
+                for (std::size_t r = 0; r < R; ++r) {
+                    if (violada(regras[r], resumo)) {
+                        coletar_violados(regras[r], x, j0, j1, temp.data(), minhas[r]);
+                    }
+                }
+            }
+        }
+    }
+
+    // compactação: soma de prefixos por regra e cópia paralela
+    ResultadoAuditoria res;
+    res.indices.resize(R);
+    res.lidos = N;
+    for (std::size_t r = 0; r < R; ++r) {
+        std::vector<std::size_t> inicio(T + 1, 0);
+        for (int t = 0; t < T; ++t) inicio[t + 1] = inicio[t] + parciais[t][r].size();
+
+        std::vector<std::int64_t>& destino = res.indices[r];
+        destino.resize(inicio[T]);
+
+        #pragma omp parallel for num_threads(T) schedule(static, 1)
+        for (int t = 0; t < T; ++t) {
+            std::copy(parciais[t][r].begin(), parciais[t][r].end(), destino.begin() + inicio[t]);
+        }
+        res.violada.push_back(!destino.empty());
+    }
+    return res;
+}
+
+/*---------------------------------------------------
+ Referência: o mesmo laço do 007_reduction_0.2
+-----------------------------------------------------*/
+ResultadoAuditoria auditar_reduction(const std::vector<double>& salarios) {
+    const std::int64_t N = static_cast<std::int64_t>(salarios.size());
+    bool piso_violado = false, teto_violado = false, dados_validos = true, nao_numero = false;
+
+    #pragma omp parallel for \
+        reduction(||:piso_violado, teto_violado, nao_numero) \
+        reduction(&&:dados_validos)
+    for (std::int64_t i = 0; i < N; ++i) {
+        const double s = salarios[i];
+        if (s < 1500.0)  piso_violado = true;
+        if (s > 20000.0) teto_violado = true;
+        if (s <= 0)      dados_validos = false;
+        if (s != s)      nao_numero = true;
+    }
+
+    ResultadoAuditoria res;
+    res.violada = {piso_violado, teto_violado, !dados_validos, nao_numero};
+    res.lidos = N;
+    return res;
+}
+
+int main(int argc, char* argv[]) {
+    // N >= 100: as quatro posições "ruins" (N/100, N/20, N/5, N/2) ficam distintas e dentro do vetor
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 20'000'000;
+    if (N < 100) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 100]\n";
+        return 1;
+    }
+
+    garantir_ambiente_omp(argv, {{"OMP_CANCELLATION", "true"}});
+    const int REPETICOES = 5;
+
+    const std::vector<Regra> regras = {
+        {"Regra 1: abaixo do piso de R$ 1500", Comparacao::MENOR,       1500.0},
+        {"Regra 2: acima do teto de R$ 20000", Comparacao::MAIOR,       20000.0},
+        {"Regra 3: salario nao positivo",      Comparacao::MENOR_IGUAL, 0.0},
+        {"Regra 4: valor nao numerico (NaN)",  Comparacao::NAO_NUMERO,  0.0},
+    };
+
+    std::cout << "Auditoria salarial, N = " << N << ", threads = " << omp_get_max_threads()
+              << ", cancelamento = " << (omp_get_cancellation() ? "ligado" : "desligado") << "\n\n";
+
+    std::vector<double> salarios(N);
+
+    // Cenários: onde os dados "ruins" aparecem (mesmas posições relativas do 007_reduction_0.2)
+    struct Cenario {
+        const char* nome;
+        bool com_violacoes;
+    };
+    const Cenario cenarios[] = {
+        {"todas as regras violadas", true},
+        {"nenhuma violacao        ", false},
+    };
+
+    std::cout << "------------------------------------------------------------------------------\n";
+    std::cout << " cenario                   | reduction (ms) | parada antecipada (ms) | lido\n";
+    std::cout << "------------------------------------------------------------------------------\n";
+    for (const auto& c : cenarios) {
+        #pragma omp parallel for
+        for (std::int64_t i = 0; i < N; ++i) salarios[i] = 5000.0;
+        if (c.com_violacoes) {
+            salarios[N / 100] = 1400.0;                                    // Regra 1
+            salarios[N / 20]  = std::numeric_limits<double>::quiet_NaN();  // Regra 4
+            salarios[N / 5]   = -50.0;                                     // Regra 3
+            salarios[N / 2]   = 25000.0;                                   // Regra 2
+        }
+
+        ResultadoAuditoria ref, rapido;
+        double t0 = omp_get_wtime();
+        for (int r = 0; r < REPETICOES; ++r) ref = auditar_reduction(salarios);
+        const double t_ref = (omp_get_wtime() - t0) / REPETICOES;
+
+        t0 = omp_get_wtime();
+        for (int r = 0; r < REPETICOES; ++r) rapido = auditar(salarios, regras);
+        const double t_rapido = (omp_get_wtime() - t0) / REPETICOES;
+
+        if (ref.violada != rapido.violada) {
+            std::cerr << "ERRO: resultados diferentes no cenario " << c.nome << "\n";
+            return 1;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << " " << c.nome << "  | " << std::setw(14) << t_ref * 1e3
+                  << " | " << std::setw(22) << t_rapido * 1e3
+                  << " | " << std::setw(5) << std::setprecision(1)
+                  << 100.0 * static_cast<double>(rapido.lidos) / static_cast<double>(N) << " %\n";
+    }
+    std::cout << "------------------------------------------------------------------------------\n\n";
+
+    // ---------------------------
+    // Modo coletar: muitas violações (1 a cada 1000 abaixo do piso)
+    // ---------------------------
+    #pragma omp parallel for
+    for (std::int64_t i = 0; i < N; ++i) salarios[i] = (i % 1000 == 7) ? 1200.0 : 5000.0;
+    salarios[N / 5] = -50.0;
+    salarios[N / 2] = 25000.0;
+
+    double t0 = omp_get_wtime();
+    const ResultadoAuditoria todos = auditar_coletando(salarios, regras);
+    const double t_coleta = omp_get_wtime() - t0;
+
+    std::cout << "Relatorio de auditoria salarial (modo coletar, " << std::setprecision(3) << t_coleta * 1e3 << " ms)\n";
+    bool ordenado = true;
+    for (std::size_t r = 0; r < regras.size(); ++r) {
+        const auto& idx = todos.indices[r];
+        ordenado = ordenado && std::is_sorted(idx.begin(), idx.end());
+        std::cout << (todos.violada[r] ? "[ALERTA] " : "[OK]     ") << std::left << std::setw(36) << regras[r].nome
+                  << std::right << " violacoes: " << std::setw(8) << idx.size();
+        for (std::size_t k = 0; k < std::min<std::size_t>(3, idx.size()); ++k) std::cout << (k ? ", " : "  indices: ") << idx[k];
+        if (idx.size() > 3) std::cout << ", ...";
+        std::cout << "\n";
+    }
+
+    // conferência com uma contagem serial simples
+    bool ok = ordenado;
+    for (std::size_t r = 0; r < regras.size(); ++r) {
+        const auto esperado = com_predicado(regras[r], [&](auto viola) {
+            return std::count_if(salarios.begin(), salarios.end(), viola);
+        });
+        ok = ok && todos.indices[r].size() == static_cast<std::size_t>(esperado);
+    }
+    std::cout << (ok ? "Indices ordenados e contagem conferida.\n" : "ERRO na coleta de violacoes.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Com as violações espalhadas até a metade do vetor, a parada antecipada
+   lê ~50% dos salários e termina em ~metade do tempo. Quanto mais cedo as
+   regras são decididas, maior o ganho.
+
+2. Sem nenhuma violação não há o que antecipar: todas as regras ficam em
+   aberto até o fim e o motor lê 100%. Mesmo assim ele fica à frente do
+   laço com reduction: o resumo (min, max, NaN) vetoriza, enquanto os ifs
+   do 0.2 testam as regras uma a uma para cada salário.
+
+3. Se uma única regra nunca é violada (ex.: nenhum NaN), ela também mantém
+   a leitura até o fim. A parada antecipada depende de TODAS as regras.
+
+4. Rode com OMP_CANCELLATION=false para ver a diferença: o resultado é o
+   mesmo, mas cada thread ainda percorre (e pula) os blocos que sobram.
+
+5. O modo coletar devolve os índices já ordenados, sem ordenar nada:
+   a ordem vem do schedule(static) + concatenação na ordem das threads.
+*/
@@ -0,0 +1,528 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 007_reduction_0.8.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Compensated (Kahan/Neumaier) and blocked pairwise summation as user-defined OpenMP reductions
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+
+/*---------------------------------------------------
+ Somas reproduzíveis: reductions compensadas e pareadas
+-----------------------------------------------------*/
+
+// No 007_reduction_0.0 e no 007_reduction_0.1 a soma é feita com
+//   #pragma omp parallel for reduction(+:soma)
+// Cada thread soma a sua fatia num double e o OpenMP soma as parciais.
+// Cada adição arredonda; o erro acumulado depende de QUANTAS parcelas cada
+// acumulador recebeu e de QUAIS parciais foram juntadas em que ordem.
+// Resultado: com 10⁹ salários, o total da folha muda alguns centavos quando
+// muda o número de threads — e o fechamento do mês não bate de uma
+// execução para outra.
+
+/*---------------------------------------------------
+ Soma compensada (Kahan e Neumaier)
+-----------------------------------------------------
+ Guarda, ao lado da soma s, um segundo double c com o que o arredondamento
+ jogou fora:
+   Kahan:     y = x − c;  t = s + y;  c = (t − s) − y;  s = t
+   Neumaier:  t = s + x;
+              c += |s| >= |x| ? (s − t) + x : (x − t) + s;   s = t
+ O Neumaier também acerta quando a parcela é maior que a soma (ex.: sinais
+ trocados). Erro final: ~2u·|Σx| + n·u²·Σ|x|, com u = 2⁻⁵³ — na prática o
+ total exato arredondado, QUALQUER que seja o número de threads.
+
+ Para juntar duas parciais (s1, c1) e (s2, c2) sem perder nada usamos a
+ TwoSum de Knuth, que devolve a soma arredondada E o seu erro exato:
+   s = s1 + s2;  z = s − s1;  e = (s1 − (s − z)) + (s2 − z)
+   resultado = (s, c1 + c2 + e)
+ Esse é o combinador da reduction:
+
+   #pragma omp declare reduction(compensada : SomaCompensada : omp_out = combinar(omp_out, omp_in))
+
+ Para não pagar a cadeia de dependências de uma soma por vez, cada bloco
+ de 2048 salários é somado em 16 pistas independentes (dois registradores
+ AVX-512 de doubles): o laço das pistas vetoriza, e com duas cadeias por
+ vez o processador não fica esperando a latência de cada adição.
+*/
+
+/*---------------------------------------------------
+ Soma pareada em blocos
+-----------------------------------------------------
+ Soma em árvore: (x0 + x1) + (x2 + x3) ... cada valor passa por ~log₂(n)
+ adições em vez de n, e o erro fica <= γ(h)·Σ|x| com h ~ log₂(n).
+   - blocos de 128 valores: 16 pistas de 8 valores, depois as pistas se
+     juntam 2 a 2 (h = 12 no bloco, igual ao 017_precisao_mista_0.0);
+   - as somas dos blocos entram num CONTADOR BINÁRIO: nivel[k] guarda a
+     soma de 2^k blocos; chegando um bloco no nível ocupado, os dois se
+     somam e sobem um nível, como o "vai um" de uma soma binária.
+ O combinador da reduction junta dois contadores nível a nível, e a árvore
+ continua balanceada:
+
+   #pragma omp declare reduction(pareada : SomaPareada : combinar(omp_out, omp_in))
+
+ Custo: uma soma por valor, como a ingênua. Precisão: um pouco abaixo da
+ compensada, mas o limite do erro não cresce com n nem com as threads.
+*/
+
+/*
+ Compilar:
+   g++ -O3 -march=native -fopenmp 007_reduction_0.8.cpp -o 007_reduction_0.8
+   (NUNCA com -ffast-math: ele "simplifica" (t − s) − y para zero e a
+   compensação desaparece)
+
+ Executar:
+   ./007_reduction_0.8
+   ./007_reduction_0.8 --n=1000000000 --threads=1,2,4,8,16
+   ./007_reduction_0.8 --modos=ingenua,neumaier --formato=csv > somas.csv
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <algorithm>
+#include <omp.h>
+
+/*---------------------------------------------------
+ Soma compensada
+-----------------------------------------------------*/
+struct SomaCompensada {
+    double soma = 0.0;
+    double erro = 0.0;      // o que o arredondamento de soma deixou de fora
+    double valor() const { return soma + erro; }
+};
+
+// TwoSum (Knuth): s + e == a + b exatamente
+inline void dois_soma(double a, double b, double& s, double& e) {
+    s = a + b;
+    const double z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+inline SomaCompensada combinar(const SomaCompensada& a, const SomaCompensada& b) {
+    SomaCompensada r;
+    double e;
+    dois_soma(a.soma, b.soma, r.soma, e);
+    r.erro = a.erro + b.erro + e;
+    return r;
+}
+
+#pragma omp declare reduction(compensada : SomaCompensada : omp_out = combinar(omp_out, omp_in)) \
+    initializer(omp_priv = SomaCompensada{})
+
+constexpr int          PISTAS = 16;     // doubles em dois registradores AVX-512
+constexpr std::int64_t BLOCO  = 2048;   // 16 KB: cabe no cache L1
+
+// Kahan em 16 pistas; c guarda o NEGATIVO do que se perdeu
+SomaCompensada kahan_bloco(const double* p, std::int64_t len) {
+    double s[PISTAS] = {}, c[PISTAS] = {};
+    std::int64_t i = 0;
+    for (; i + PISTAS <= len; i += PISTAS) {
+        #pragma omp simd
+        for (int j = 0; j < PISTAS; ++j) {
+            const double y = p[i + j] - c[j];
+            const double t = s[j] + y;
+            c[j] = (t - s[j]) - y;
+            s[j] = t;
+        }
+    }
+    SomaCompensada r;
+    for (int j = 0; j < PISTAS; ++j) r = combinar(r, SomaCompensada{s[j], -c[j]});
+    for (; i < len; ++i) r = combinar(r, SomaCompensada{p[i], 0.0});
+    return r;
+}
+
+// Neumaier em 16 pistas; o "?:" vira uma seleção vetorial (blend)
+SomaCompensada neumaier_bloco(const double* p, std::int64_t len) {
+    double s[PISTAS] = {}, c[PISTAS] = {};
+    std::int64_t i = 0;
+    for (; i + PISTAS <= len; i += PISTAS) {
+        #pragma omp simd
+        for (int j = 0; j < PISTAS; ++j) {
+            const double x = p[i + j];
+            const double t = s[j] + x;
+            c[j] += (std::fabs(s[j]) >= std::fabs(x)) ? (s[j] - t) + x : (x - t) + s[j];
+            s[j] = t;
+        }
+    }
+    SomaCompensada r;
+    for (int j = 0; j < PISTAS; ++j) r = combinar(r, SomaCompensada{s[j], c[j]});
+    for (; i < len; ++i) r = combinar(r, SomaCompensada{p[i], 0.0});
+    return r;
+}
+
+template <SomaCompensada (*SomarBloco)(const double*, std::int64_t)>
+double soma_compensada(const double* x, std::int64_t n, int threads) {
+    const std::int64_t nblocos = (n + BLOCO - 1) / BLOCO;
+    SomaCompensada total;
+    #pragma omp parallel for num_threads(threads) schedule(static) reduction(compensada:total)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0 = bl * BLOCO;
+        total = combinar(total, SomarBloco(x + i0, std::min(BLOCO, n - i0)));
+    }
+    return total.valor();
+}
+
+/*---------------------------------------------------
+ Soma pareada
+-----------------------------------------------------*/
+constexpr int          PISTAS_PAREADA = 16;
+constexpr std::int64_t BLOCO_PAREADA  = 128;   // 16 pistas x 8 valores
+
+struct SomaPareada {
+    double        nivel[64] = {};   // nivel[k] = soma de 2^k blocos, se o bit k de blocos estiver ligado
+    std::uint64_t blocos    = 0;
+
+    // Soma parcial de 2^k blocos: "vai um" enquanto o nível estiver ocupado
+    void juntar(int k, double s) {
+        while ((blocos >> k) & 1) {
+            s += nivel[k];
+            blocos -= std::uint64_t{1} << k;
+            ++k;
+        }
+        nivel[k] = s;
+        blocos += std::uint64_t{1} << k;
+    }
+    void adicionar(double soma_bloco) { juntar(0, soma_bloco); }
+
+    // Do nível mais baixo (somas menores) para o mais alto
+    double valor() const {
+        double s = 0.0;
+        for (int k = 0; k < 64; ++k)
+            if ((blocos >> k) & 1) s += nivel[k];
+        return s;
+    }
+};
+
+inline void combinar(SomaPareada& a, const SomaPareada& b) {
+    for (int k = 0; k < 64; ++k)
+        if ((b.blocos >> k) & 1) a.juntar(k, b.nivel[k]);
+}
+
+#pragma omp declare reduction(pareada : SomaPareada : combinar(omp_out, omp_in)) \
+    initializer(omp_priv = SomaPareada{})
+
+// 16 pistas de 8 valores e árvore sobre as pistas: 16 -> 8 -> 4 -> 2 -> 1
+inline double pareada_bloco(const double* p, std::int64_t len) {
+    double s[PISTAS_PAREADA] = {};
+    std::int64_t i = 0;
+    for (; i + PISTAS_PAREADA <= len; i += PISTAS_PAREADA) {
+        #pragma omp simd
+        for (int j = 0; j < PISTAS_PAREADA; ++j) s[j] += p[i + j];
+    }
+    for (int j = 0; i < len; ++i, ++j) s[j] += p[i];
+    for (int largura = PISTAS_PAREADA / 2; largura > 0; largura /= 2) {
+        #pragma omp simd
+        for (int j = 0; j < largura; ++j) s[j] += s[j + largura];
+    }
+    return s[0];
+}
+
+double soma_pareada(const double* x, std::int64_t n, int threads) {
+    const std::int64_t nblocos = (n + BLOCO_PAREADA - 1) / BLOCO_PAREADA;
+    SomaPareada total;
+    #pragma omp parallel for num_threads(threads) schedule(static) reduction(pareada:total)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::int64_t i0 = bl * BLOCO_PAREADA;
+        total.adicionar(pareada_bloco(x + i0, std::min(BLOCO_PAREADA, n - i0)));
+    }
+    return total.valor();
+}
+
+/*---------------------------------------------------
+ Soma ingênua (007_reduction_0.1) e escolha do modo
+-----------------------------------------------------*/
+double soma_ingenua(const double* x, std::int64_t n, int threads) {
+    double soma = 0.0;
+    #pragma omp parallel for simd num_threads(threads) schedule(static) reduction(+:soma)
+    for (std::int64_t i = 0; i < n; ++i) soma += x[i];
+    return soma;
+}
+
+enum class Modo { INGENUA, KAHAN, NEUMAIER, PAREADA };
+
+struct InfoModo {
+    const char* nome;
+    Modo        modo;
+};
+
+const InfoModo MODOS[] = {
+    {"ingenua",  Modo::INGENUA},
+    {"kahan",    Modo::KAHAN},
+    {"neumaier", Modo::NEUMAIER},
+    {"pareada",  Modo::PAREADA},
+};
+
+double somar(const double* x, std::int64_t n, Modo modo, int threads) {
+    switch (modo) {
+        case Modo::INGENUA:  return soma_ingenua(x, n, threads);
+        case Modo::KAHAN:    return soma_compensada<kahan_bloco>(x, n, threads);
+        case Modo::NEUMAIER: return soma_compensada<neumaier_bloco>(x, n, threads);
+        case Modo::PAREADA:  return soma_pareada(x, n, threads);
+    }
+    return 0.0;
+}
+
+// Referência: uma thread, TwoSum em cada valor (erro ~ n·u²·Σ|x|)
+SomaCompensada referencia(const double* x, std::int64_t n) {
+    SomaCompensada r;
+    for (std::int64_t i = 0; i < n; ++i) {
+        double e;
+        dois_soma(r.soma, x[i], r.soma, e);
+        r.erro += e;
+    }
+    return r;
+}
+
+/*---------------------------------------------------
+ Medição
+-----------------------------------------------------*/
+struct Ponto {
+    const char*  modo;
+    int          threads;
+    double       soma;
+    double       menor, maior; // extremos entre as repetições
+    double       erro_rel;
+    double       diferenca;   // soma - referência, em reais
+    double       segundos;    // melhor execução
+    double       gbs;
+    double       custo;       // tempo / tempo da ingênua com as mesmas threads
+};
+
+Ponto medir(const InfoModo& m, const double* x, std::int64_t n, int threads, double exata, int repeticoes) {
+    Ponto p{};
+    p.modo    = m.nome;
+    p.threads = threads;
+    p.soma    = somar(x, n, m.modo, threads);   // aquecimento
+    p.menor   = p.maior = p.soma;
+    double melhor = 1e30;
+    for (int r = 0; r < repeticoes; ++r) {
+        const double t0 = omp_get_wtime();
+        const double s  = somar(x, n, m.modo, threads);
+        melhor  = std::min(melhor, omp_get_wtime() - t0);
+        p.menor = std::min(p.menor, s);   // a ordem em que o OpenMP junta as parciais
+        p.maior = std::max(p.maior, s);   // pode mudar de uma execução para outra
+    }
+    p.segundos  = melhor;
+    p.gbs       = static_cast<double>(n) * sizeof(double) / melhor * 1e-9;
+    p.diferenca = p.soma - exata;
+    p.erro_rel  = std::fabs(p.diferenca) / std::fabs(exata);
+    return p;
+}
+
+/*--------------------------------------------
+ Argumentos
+-------------------------------------------*/
+template <typename T>
+std::vector<T> lista(const std::string& texto) {
+    std::vector<T> valores;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        std::stringstream conv(item);
+        T v{};
+        conv >> v;
+        valores.push_back(v);
+    }
+    return valores;
+}
+
+bool opcao(const char* arg, const char* nome, std::string& valor) {
+    const std::size_t len = std::strlen(nome);
+    if (std::strncmp(arg, nome, len) != 0 || arg[len] != '=') return false;
+    valor = arg + len + 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::int64_t N = 100'000'000;
+    std::string formato = "tabela";
+    std::vector<int> threads;
+    std::vector<InfoModo> modos(std::begin(MODOS), std::end(MODOS));
+
+    for (int k = 1; k < argc; ++k) {
+        std::string v;
+        if      (opcao(argv[k], "--n", v))       N = std::max<std::int64_t>(1, std::strtoll(v.c_str(), nullptr, 10));
+        else if (opcao(argv[k], "--threads", v)) threads = lista<int>(v);
+        else if (opcao(argv[k], "--formato", v)) formato = v;
+        else if (opcao(argv[k], "--modos", v)) {
+            modos.clear();
+            for (const std::string& nome : lista<std::string>(v)) {
+                const auto m = std::find_if(std::begin(MODOS), std::end(MODOS),
+                                            [&](const InfoModo& i) { return nome == i.nome; });
+                if (m == std::end(MODOS)) {
+                    std::cerr << "Modo desconhecido: " << nome << " (ingenua, kahan, neumaier, pareada)\n";
+                    return 1;
+                }
+                modos.push_back(*m);
+            }
+        }
+        else {
+            std::cerr << "Argumento desconhecido: " << argv[k] << "\n";
+            return 1;
+        }
+    }
+
+    // padrão: 1, 2, 4, ... até o número de threads disponíveis, e pelo menos até 8:
+    // o erro depende só da divisão do trabalho, que muda mesmo sem núcleos sobrando
+    if (threads.empty()) {
+        const int t_max = std::max(8, omp_get_max_threads());
+        for (int t = 1; t < t_max; t *= 2) threads.push_back(t);
+        threads.push_back(t_max);
+    }
+    if (std::find_if(modos.begin(), modos.end(), [](const InfoModo& m) { return m.modo == Modo::INGENUA; }) == modos.end())
+        modos.insert(modos.begin(), MODOS[0]);   // a ingênua é a base do custo relativo
+
+    // Salários com centavos (007_reduction_0.1), inicialização paralela (first touch)
+    std::vector<double> salarios(N);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < N; ++i) salarios[i] = 4000.0 + (i % 100) * 20.0 + (i % 37) * 0.37;
+
+    const double exata = referencia(salarios.data(), N).valor();
+    const int REPETICOES = 3;
+
+    std::vector<Ponto> pontos;
+    for (const InfoModo& m : modos)
+        for (int T : threads) pontos.push_back(medir(m, salarios.data(), N, T, exata, REPETICOES));
+    for (Ponto& p : pontos) {
+        const auto base = std::find_if(pontos.begin(), pontos.end(), [&](const Ponto& b) {
+            return b.threads == p.threads && std::strcmp(b.modo, MODOS[0].nome) == 0;
+        });
+        p.custo = p.segundos / base->segundos;
+    }
+
+    if (formato == "csv") {
+        std::cout << "modo,threads,n,soma,referencia,erro_rel,diferenca,segundos,gbs,custo\n";
+        std::cout << std::setprecision(17);
+        for (const Ponto& p : pontos) {
+            std::cout << p.modo << "," << p.threads << "," << N << "," << p.soma << "," << exata << ","
+                      << p.erro_rel << "," << p.diferenca << "," << p.segundos << "," << p.gbs << "," << p.custo << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << "Soma da folha, N = " << N << " salarios, referencia (TwoSum sequencial): R$ "
+              << std::fixed << std::setprecision(2) << exata << "\n";
+    std::cout << "---------------------------------------------------------------------------------------------------\n";
+    std::cout << " modo     | thr |               soma (R$) |  erro rel | dif. (centavos) |  tempo ms |  GB/s | custo\n";
+    std::cout << "---------------------------------------------------------------------------------------------------\n";
+    for (const Ponto& p : pontos) {
+        std::cout << " " << std::left << std::setw(8) << p.modo << std::right
+                  << " | " << std::setw(3) << p.threads
+                  << " | " << std::fixed << std::setprecision(2) << std::setw(23) << p.soma
+                  << " | " << std::scientific << std::setprecision(1) << std::setw(9) << p.erro_rel
+                  << " | " << std::fixed << std::setprecision(2) << std::setw(15) << 100.0 * p.diferenca
+                  << " | " << std::setw(9) << p.segundos * 1e3
+                  << " | " << std::setw(5) << std::setprecision(1) << p.gbs
+                  << " | " << std::setw(4) << std::setprecision(2) << p.custo << "x\n";
+    }
+    std::cout << "---------------------------------------------------------------------------------------------------\n";
+
+    // ---------------------------
+    // Reprodutibilidade: o total muda com o número de threads?
+    // ---------------------------
+    std::cout << "\nVariacao do total entre " << threads.size() << " contagens de threads (e entre repeticoes)\n";
+    std::cout << "------------------------------------------------------------------\n";
+    std::cout << " modo     | maior - menor (centavos) | mesmo double em todas?\n";
+    std::cout << "------------------------------------------------------------------\n";
+    for (const InfoModo& m : modos) {
+        double menor = 1e300, maior = -1e300;
+        for (const Ponto& p : pontos) {
+            if (std::strcmp(p.modo, m.nome) != 0) continue;
+            menor = std::min(menor, p.menor);
+            maior = std::max(maior, p.maior);
+        }
+        std::cout << " " << std::left << std::setw(8) << m.nome << std::right
+                  << " | " << std::fixed << std::setprecision(4) << std::setw(24) << 100.0 * (maior - menor)
+                  << " | " << (maior == menor ? "sim" : "nao") << "\n";
+    }
+    std::cout << "------------------------------------------------------------------\n";
+    return 0;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. "dif. (centavos)" é a diferença para a referência. Com 10⁸ salários a
+   ingênua erra de ~1 a ~15 reais, e o erro MUDA com o número de threads
+   (com uma thread costuma ser o maior: cada acumulador recebe mais parcelas).
+   Kahan e Neumaier dão o total exato arredondado com qualquer número de
+   threads; a pareada fica a 1 ulp dele (0,006 centavos em 5·10¹¹ reais).
+
+2. "custo" é o tempo dividido pelo da ingênua com as mesmas threads. Com
+   N grande o laço é limitado pela memória (8 bytes por valor): as contas
+   extras cabem no tempo de espera da memória e o custo fica em ~1,05x
+   (Kahan) e ~1,1x (Neumaier). Com os dados no cache (--n=100000) aparece
+   o trabalho a mais: ~1,2x no Kahan e ~2x no Neumaier (a comparação dos
+   módulos e a seleção por valor).
+
+3. A pareada faz uma soma por valor, como a ingênua; o contador binário
+   roda uma vez a cada 128 valores. É a escolha quando basta um limite de
+   erro baixo; Kahan ou Neumaier, quando o total tem que ser o MESMO até
+   o último centavo em qualquer número de threads.
+
+4. A reduction(+) do OpenMP não garante em que ordem as parciais são
+   juntadas (o GCC junta na ordem em que as threads terminam), por isso a
+   ingênua pode mudar até entre duas execuções com as mesmas threads. Nas
+   somas compensadas a ordem não importa: o erro de cada junção é guardado
+   pela TwoSum e devolvido no final.
+
+5. Mais threads que núcleos (o padrão vai até 8) não muda a precisão,
+   só o tempo: cada thread continua somando a sua fatia.
+*/
@@ -0,0 +1,451 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 008_sections_0.2.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Boot orchestrator: subsystems with dependencies scheduled as OpenMP tasks, critical path first
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+Exemplo: boot com dependências (grafo de tarefas)
+-----------------------------------------------------
+Em 008_sections_0.1 as quatro tarefas de inicialização eram independentes,
+e cada uma virava uma section. Num sistema real:
+
+  - há dependências: o cache precisa da configuração; as migrações precisam
+    do banco; o servidor HTTP só sobe quando quase tudo está pronto;
+  - há mais subsistemas do que núcleos;
+  - acrescentar um subsistema não deveria exigir reescrever o bloco sections.
+
+Aqui cada subsistema é REGISTRADO com nome, custo estimado e de quem depende:
+
+    boot.registrar("banco", 200, {"configuracao"}, carregarBancoDeDados);
+
+e o Orquestrador:
+  1) confere o grafo (nomes conhecidos, sem ciclos);
+  2) calcula o CAMINHO CRÍTICO: a maior soma de custos de uma cadeia de
+     dependências. Nenhum número de threads termina o boot antes disso;
+  3) cria uma "omp task" por subsistema com depend(out: exec[i]) e
+     depend(in: exec[d]) para cada dependência d — o runtime só libera a
+     tarefa quando as dependências terminarem;
+  4) dá prioridade a quem está no começo das cadeias mais longas
+     (clause priority), para o caminho crítico nunca esperar na fila.
+
+No fim compara o tempo obtido com os limites inferiores:
+    caminho crítico   e   soma dos custos / threads.
+
+Uso: ./008_sections_0.2 [escala]      (multiplica os custos; padrão 1.0)
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <omp.h>
+#include <iomanip>
+#include "ambiente_omp.hpp"
+
+enum class Estado { PENDENTE, OK, FALHOU, PULADO };
+
+const char* nome_estado(Estado e) {
+    switch (e) {
+        case Estado::OK:     return "ok";
+        case Estado::FALHOU: return "FALHOU";
+        case Estado::PULADO: return "pulado";
+        default:             return "pendente";
+    }
+}
+
+// O que aconteceu com cada subsistema num boot
+struct Execucao {
+    Estado estado = Estado::PENDENTE;
+    double inicio = 0.0;   // segundos desde o começo do boot
+    double fim    = 0.0;
+    int    thread = -1;
+};
+
+struct Relatorio {
+    std::vector<Execucao> execucoes;
+    double total = 0.0;
+    bool sucesso() const {
+        return std::all_of(execucoes.begin(), execucoes.end(),
+                           [](const Execucao& e) { return e.estado == Estado::OK; });
+    }
+};
+
+class Orquestrador {
+public:
+    enum class Ordem { REGISTRO, CAMINHO_CRITICO };
+
+    void registrar(std::string nome, double custo_ms, std::vector<std::string> depende_de,
+                   std::function<bool()> iniciar) {
+        subsistemas_.push_back({std::move(nome), custo_ms, std::move(depende_de), std::move(iniciar)});
+        preparado_ = false;
+    }
+
+    // Resolve os nomes, procura ciclos e calcula o caminho crítico.
+    // Devolve false (e a mensagem em erro) se o grafo for inválido.
+    bool preparar(std::string& erro) {
+        const int n = static_cast<int>(subsistemas_.size());
+        std::unordered_map<std::string, int> indice;
+        for (int i = 0; i < n; ++i) {
+            if (!indice.emplace(subsistemas_[i].nome, i).second) {
+                erro = "subsistema registrado duas vezes: " + subsistemas_[i].nome;
+                return false;
+            }
+        }
+
+        dependencias_.assign(n, {});
+        dependentes_.assign(n, {});
+        for (int i = 0; i < n; ++i) {
+            for (const auto& d : subsistemas_[i].depende_de) {
+                auto it = indice.find(d);
+                if (it == indice.end()) {
+                    erro = subsistemas_[i].nome + " depende de '" + d + "', que não foi registrado";
+                    return false;
+                }
+                dependencias_[i].push_back(it->second);
+                dependentes_[it->second].push_back(i);
+            }
+        }
+
+        // Ordem topológica (Kahn) na ordem de registro; se sobrar alguém, há ciclo
+        std::vector<int> topologica = ordenar(Ordem::REGISTRO);
+        if (static_cast<int>(topologica.size()) != n) {
+            erro = "dependência circular entre os subsistemas";
+            return false;
+        }
+
+        // nível[i] = custo[i] + maior nível entre os que dependem de i
+        //          = tamanho da cadeia mais longa que COMEÇA em i
+        nivel_.assign(n, 0.0);
+        for (auto it = topologica.rbegin(); it != topologica.rend(); ++it) {
+            double maior = 0.0;
+            for (int s : dependentes_[*it]) maior = std::max(maior, nivel_[s]);
+            nivel_[*it] = subsistemas_[*it].custo_ms + maior;
+        }
+        preparado_ = true;
+        return true;
+    }
+
+    // Cadeia de custo máximo, do primeiro ao último subsistema
+    std::vector<int> caminho_critico() const {
+        std::vector<int> caminho;
+        int atual = -1;
+        for (int i = 0; i < static_cast<int>(nivel_.size()); ++i) {
+            if (dependencias_[i].empty() && (atual < 0 || nivel_[i] > nivel_[atual])) atual = i;
+        }
+        while (atual >= 0) {
+            caminho.push_back(atual);
+            int proximo = -1;
+            for (int s : dependentes_[atual]) {
+                if (proximo < 0 || nivel_[s] > nivel_[proximo]) proximo = s;
+            }
+            atual = proximo;
+        }
+        return caminho;
+    }
+
+    double limite_caminho_critico() const {
+        return nivel_.empty() ? 0.0 : *std::max_element(nivel_.begin(), nivel_.end());
+    }
+
+    double soma_custos() const {
+        double s = 0.0;
+        for (const auto& sub : subsistemas_) s += sub.custo_ms;
+        return s;
+    }
+
+    Relatorio executar(Ordem ordem, int threads) const {
+        const int n = static_cast<int>(subsistemas_.size());
+        Relatorio r;
+        r.execucoes.assign(n, Execucao{});
+        if (!preparado_) return r;
+
+        const std::vector<int> criacao = ordenar(ordem);
+        const std::vector<int> prioridade = prioridades(ordem);
+
+        // O depend usa o próprio registro de execução: a tarefa i escreve
+        // exec[i] e lê exec[d] de cada dependência d
+        Execucao* exec = r.execucoes.data();
+
+        const double t0 = omp_get_wtime();
+        #pragma omp parallel num_threads(threads)
+        #pragma omp single
+        {
+            // As tarefas precisam ser criadas em ordem topológica: um depend(in)
+            // só enxerga tarefas irmãs criadas ANTES dele.
+            for (int i : criacao) {
+                const int* deps = dependencias_[i].data();
+                const int nd = static_cast<int>(dependencias_[i].size());
+                #pragma omp task firstprivate(i) depend(out: exec[i]) \
+                                 depend(iterator(j = 0:nd), in: exec[deps[j]]) priority(prioridade[i])
+                executar_um(i, exec, t0);
+            }
+        }   // barreira: todas as tarefas terminaram
+        r.total = omp_get_wtime() - t0;
+        return r;
+    }
+
+    int tamanho() const { return static_cast<int>(subsistemas_.size()); }
+    const std::string& nome(int i) const { return subsistemas_[i].nome; }
+    double custo(int i) const { return subsistemas_[i].custo_ms; }
+    double nivel(int i) const { return nivel_[i]; }
+    const std::vector<std::string>& depende_de(int i) const { return subsistemas_[i].depende_de; }
+
+private:
+    struct Subsistema {
+        std::string              nome;
+        double                   custo_ms;
+        std::vector<std::string> depende_de;
+        std::function<bool()>    iniciar;
+    };
+
+    // Kahn: entre os subsistemas prontos escolhe o primeiro registrado (REGISTRO)
+    // ou o de maior nível, isto é, o mais adiantado no caminho crítico.
+    std::vector<int> ordenar(Ordem ordem) const {
+        const int n = static_cast<int>(subsistemas_.size());
+        std::vector<int> faltam(n), prontos, saida;
+        for (int i = 0; i < n; ++i) {
+            faltam[i] = static_cast<int>(dependencias_[i].size());
+            if (faltam[i] == 0) prontos.push_back(i);
+        }
+        while (!prontos.empty()) {
+            auto escolhido = prontos.begin();
+            for (auto it = prontos.begin(); it != prontos.end(); ++it) {
+                const bool melhor = (ordem == Ordem::CAMINHO_CRITICO && nivel_[*it] != nivel_[*escolhido])
+                                        ? nivel_[*it] > nivel_[*escolhido]
+                                        : *it < *escolhido;
+                if (melhor) escolhido = it;
+            }
+            const int i = *escolhido;
+            prontos.erase(escolhido);
+            saida.push_back(i);
+            for (int s : dependentes_[i]) {
+                if (--faltam[s] == 0) prontos.push_back(s);
+            }
+        }
+        return saida;
+    }
+
+    // Prioridade = posição do subsistema quando ordenado por nível (maior nível,
+    // maior prioridade), limitada por OMP_MAX_TASK_PRIORITY. Na ordem de
+    // registro todos ficam com prioridade 0 (fila por ordem de chegada).
+    std::vector<int> prioridades(Ordem ordem) const {
+        const int n = static_cast<int>(subsistemas_.size());
+        std::vector<int> p(n, 0);
+        if (ordem == Ordem::REGISTRO) return p;
+        std::vector<int> por_nivel(n);
+        for (int i = 0; i < n; ++i) por_nivel[i] = i;
+        std::stable_sort(por_nivel.begin(), por_nivel.end(), [&](int a, int b) { return nivel_[a] < nivel_[b]; });
+        const int maxima = omp_get_max_task_priority();
+        for (int k = 0; k < n; ++k) p[por_nivel[k]] = std::min(k, maxima);
+        return p;
+    }
+
+    // Corpo de cada tarefa. As dependências já terminaram (depend garante a
+    // ordem e a visibilidade do que elas escreveram em exec[]).
+    void executar_um(int i, Execucao* exec, double t0) const {
+        Execucao& e = exec[i];
+        for (int d : dependencias_[i]) {
+            if (exec[d].estado != Estado::OK) {
+                e.estado = Estado::PULADO;   // dependência falhou: nem tenta
+                e.inicio = e.fim = omp_get_wtime() - t0;
+                return;
+            }
+        }
+        e.thread = omp_get_thread_num();
+        e.inicio = omp_get_wtime() - t0;
+        const bool ok = subsistemas_[i].iniciar();
+        e.fim = omp_get_wtime() - t0;
+        e.estado = ok ? Estado::OK : Estado::FALHOU;
+    }
+
+    std::vector<Subsistema>        subsistemas_;
+    std::vector<std::vector<int>>  dependencias_;   // de quem i depende
+    std::vector<std::vector<int>>  dependentes_;    // quem depende de i
+    std::vector<double>            nivel_;
+    bool                           preparado_ = false;
+};
+
+// Simula um subsistema que leva 'ms' milissegundos para iniciar
+std::function<bool()> simular(double ms) {
+    return [ms] {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(ms * 1000.0)));
+        return true;
+    };
+}
+
+// Linha do tempo: um caractere = 'passo' ms
+void imprimir_linha_do_tempo(const Orquestrador& boot, const Relatorio& r, double passo) {
+    for (int i = 0; i < boot.tamanho(); ++i) {
+        const Execucao& e = r.execucoes[i];
+        if (e.estado != Estado::OK) {
+            std::cout << " " << std::left << std::setw(15) << boot.nome(i) << std::right
+                      << "    | " << nome_estado(e.estado) << "\n";
+            continue;
+        }
+        const int ini = static_cast<int>(e.inicio * 1e3 / passo + 0.5);
+        const int fim = std::max(ini + 1, static_cast<int>(e.fim * 1e3 / passo + 0.5));
+        std::cout << " " << std::left << std::setw(15) << boot.nome(i) << std::right
+                  << " T" << e.thread << " |" << std::string(ini, ' ') << std::string(fim - ini, '#') << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // priority só tem efeito se OMP_MAX_TASK_PRIORITY > 0 (o padrão é 0)
+    garantir_ambiente_omp(argv, {{"OMP_MAX_TASK_PRIORITY", "1000"}});
+    const double escala = (argc > 1) ? std::strtod(argv[1], nullptr) : 1.0;
+
+    // Registrados na ordem em que alguém escreveria à mão — não na melhor ordem.
+    Orquestrador boot;
+    boot.registrar("configuracao",   50 * escala, {},                                   simular(50 * escala));
+    boot.registrar("log",            30 * escala, {"configuracao"},                     simular(30 * escala));
+    boot.registrar("metricas",       60 * escala, {"log"},                              simular(60 * escala));
+    boot.registrar("traducoes",     120 * escala, {},                                   simular(120 * escala));
+    boot.registrar("temas",         100 * escala, {},                                   simular(100 * escala));
+    boot.registrar("cache",         100 * escala, {"configuracao"},                     simular(100 * escala));
+    boot.registrar("banco",         200 * escala, {"configuracao"},                     simular(200 * escala));
+    boot.registrar("api_externa",   150 * escala, {"configuracao"},                     simular(150 * escala));
+    boot.registrar("migracoes",     150 * escala, {"banco"},                            simular(150 * escala));
+    boot.registrar("autenticacao",   60 * escala, {"api_externa", "banco"},             simular(60 * escala));
+    boot.registrar("cache_aquecido", 80 * escala, {"cache", "banco"},                   simular(80 * escala));
+    boot.registrar("servidor_http",  40 * escala, {"migracoes", "autenticacao", "cache_aquecido", "log"},
+                   simular(40 * escala));
+
+    std::string erro;
+    if (!boot.preparar(erro)) {
+        std::cout << "[FALHA] Grafo de boot inválido: " << erro << "\n";
+        return 1;
+    }
+
+    std::cout << "--- Boot com grafo de dependências (" << boot.tamanho() << " subsistemas) ---\n";
+    std::cout << "OMP_MAX_TASK_PRIORITY = " << omp_get_max_task_priority() << "\n\n";
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << " subsistema      | custo (ms) | nível (ms) | depende de\n";
+    std::cout << "-----------------------------------------------------------------\n";
+    for (int i = 0; i < boot.tamanho(); ++i) {
+        std::cout << " " << std::left << std::setw(15) << boot.nome(i) << std::right
+                  << " | " << std::setw(10) << boot.custo(i) << " | " << std::setw(10) << boot.nivel(i) << " | ";
+        for (const auto& d : boot.depende_de(i)) std::cout << d << " ";
+        std::cout << "\n";
+    }
+
+    std::cout << "\nCaminho crítico: ";
+    for (int i : boot.caminho_critico()) std::cout << boot.nome(i) << " -> ";
+    std::cout << "pronto (" << boot.limite_caminho_critico() << " ms)\n";
+    std::cout << "Soma dos custos (serial): " << boot.soma_custos() << " ms\n\n";
+
+    std::cout << std::setprecision(1);
+    std::cout << " threads | limite (ms) | ordem de registro (ms) | caminho crítico (ms) | eficiência\n";
+    std::cout << "------------------------------------------------------------------------------------\n";
+    bool ok = true;
+    Relatorio ultimo;
+    for (int T : {1, 2, 3, 4}) {
+        const double limite = std::max(boot.limite_caminho_critico(), boot.soma_custos() / T);
+        const Relatorio registro = boot.executar(Orquestrador::Ordem::REGISTRO, T);
+        const Relatorio critico  = boot.executar(Orquestrador::Ordem::CAMINHO_CRITICO, T);
+        ok = ok && registro.sucesso() && critico.sucesso();
+        std::cout << " " << std::setw(7) << T << " | " << std::setw(11) << limite
+                  << " | " << std::setw(22) << registro.total * 1e3
+                  << " | " << std::setw(20) << critico.total * 1e3
+                  << " | " << std::setw(9) << 100.0 * limite / (critico.total * 1e3) << "%\n";
+        ultimo = critico;
+    }
+
+    std::cout << "\nLinha do tempo (caminho crítico primeiro, 4 threads; # = 10 ms x escala):\n";
+    imprimir_linha_do_tempo(boot, ultimo, 10.0 * escala);
+
+    if (ok) {
+        std::cout << "\n[SUCESSO] Todos os subsistemas foram inicializados corretamente. O programa pode continuar.\n";
+    } else {
+        std::cout << "\n[FALHA] Um ou mais subsistemas falharam na inicialização. O programa será encerrado.\n";
+    }
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. "limite" é o menor tempo possível com T threads:
+       max(caminho crítico, soma dos custos / T).
+   Com 1 thread é a soma; a partir de 3 threads, aqui, é o caminho crítico
+   (configuracao -> banco -> migracoes -> servidor_http = 440 ms).
+
+2. Com poucas threads a ordem importa. Na ordem de registro, "traducoes" e
+   "temas" (que ninguém espera) ocupam as threads logo no início, e o banco
+   — o começo da cadeia mais longa — fica na fila. Com o caminho crítico
+   primeiro, o banco sai assim que a configuração termina e o resto preenche
+   as folgas.
+
+3. A ordem de criação sozinha não basta: com OMP_MAX_TASK_PRIORITY=0 as
+   tarefas liberadas no meio do boot entram no fim da fila, e com 2 threads
+   o "caminho crítico" pode até perder da ordem de registro. Por isso, no
+   Linux, o programa se reexecuta com OMP_MAX_TASK_PRIORITY=1000 (ver
+   ambiente_omp.hpp); nos outros sistemas, defina a variável antes.
+
+4. Os custos são estimativas: se um subsistema demorar mais que o previsto,
+   o depend continua garantindo a ordem correta; só a prioridade fica menos
+   acertada.
+
+5. Se uma tarefa falhar, quem depende dela é marcado como "pulado" sem
+   ser executado (executar_um confere o estado das dependências).
+
+6. Os subsistemas aqui só dormem (como no 008_sections_0.0): por isso o ganho
+   aparece mesmo numa máquina com um núcleo. Com trabalho de CPU de verdade,
+   use no máximo uma thread por núcleo.
+*/
@@ -0,0 +1,531 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 008_sections_0.3.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Subsystem init runner: deadlines, retry with backoff, cancel taskgroup on fatal failure, status report
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+Exemplo: boot que tolera falhas
+-----------------------------------------------------
+Em 008_sections_0.1 cada section devolve um bool e a barreira implícita
+espera todas. Dois problemas:
+
+  - se conectarServicoExterno() travar (rede que não responde), a barreira
+    espera para sempre;
+  - se o banco falhar, as outras sections continuam trabalhando à toa: o
+    programa vai ser encerrado de qualquer jeito.
+
+Aqui cada subsistema tem uma POLÍTICA:
+  prazo_ms         tempo máximo do subsistema, somando todas as tentativas
+  limite_ms        tempo máximo de UMA tentativa
+  tentativas       quantas vezes tentar
+  espera_ms        espera antes da 2ª tentativa (dobra a cada nova falha)
+  essencial        se falhar, o boot inteiro é abortado
+
+Como não dá para interromper uma função C++ bloqueada, cada tentativa roda
+numa thread auxiliar. A tarefa OpenMP espera o resultado até o limite; se
+ele passar, pede o cancelamento (Sinal) e ABANDONA a tentativa: o boot segue
+sem ela. Funções bem comportadas consultam sinal.cancelado() e param cedo.
+
+Falha de um subsistema essencial:
+  - "#pragma omp cancel taskgroup": tarefas que ainda não começaram são
+    descartadas pelo runtime;
+  - a flag abortar avisa as que já estão rodando (cancelamento cooperativo).
+Dependência que falhou: quem depende dela é marcado como "pulado".
+
+Os serviços são simulados por ServicoFalso (latência, falhas iniciais,
+travamento), para testar cada caso sem rede.
+
+Uso: ./008_sections_0.3 [--json]
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <omp.h>
+#include <iomanip>
+#include "ambiente_omp.hpp"
+
+using Relogio = std::chrono::steady_clock;
+
+// Pedido de cancelamento que a função de inicialização pode consultar
+class Sinal {
+public:
+    bool cancelado() const { return pedido_.load(std::memory_order_acquire); }
+    void pedir() { pedido_.store(true, std::memory_order_release); }
+private:
+    std::atomic<bool> pedido_{false};
+};
+
+// Devolve true se iniciou; false ou exceção = falha desta tentativa
+using Inicializacao = std::function<bool(const Sinal&)>;
+
+struct Politica {
+    double prazo_ms   = 1000.0;
+    double limite_ms  = 1000.0;
+    int    tentativas = 1;
+    double espera_ms  = 20.0;
+    bool   essencial  = true;
+};
+
+enum class Estado { PENDENTE, OK, FALHOU, TEMPO_ESGOTADO, CANCELADO, PULADO };
+
+const char* nome_estado(Estado e) {
+    switch (e) {
+        case Estado::OK:             return "ok";
+        case Estado::FALHOU:         return "falhou";
+        case Estado::TEMPO_ESGOTADO: return "tempo esgotado";
+        case Estado::CANCELADO:      return "cancelado";
+        case Estado::PULADO:         return "pulado";
+        default:                     return "pendente";
+    }
+}
+
+struct Status {
+    Estado      estado = Estado::PENDENTE;
+    int         tentativas = 0;
+    double      inicio = 0.0;   // ms desde o começo do boot
+    double      fim    = 0.0;
+    std::string erro;
+};
+
+struct RelatorioBoot {
+    std::vector<std::string> nomes;
+    std::vector<bool>        essenciais;
+    std::vector<Status>      status;
+    double                   total_ms = 0.0;
+    bool                     abortado = false;
+
+    bool sucesso() const {
+        for (std::size_t i = 0; i < status.size(); ++i) {
+            if (essenciais[i] && status[i].estado != Estado::OK) return false;
+        }
+        return true;
+    }
+    bool degradado() const {
+        return sucesso() && std::any_of(status.begin(), status.end(),
+                                        [](const Status& s) { return s.estado != Estado::OK; });
+    }
+};
+
+/*---------------------------------------------------
+ Uma tentativa com limite de tempo
+-----------------------------------------------------*/
+enum class Desfecho { SUCESSO, FALHA, TEMPO, ABORTADA };
+
+Desfecho tentar(const Inicializacao& funcao, Relogio::time_point limite,
+                const std::atomic<bool>& abortar, std::string& erro) {
+    // Estado dividido com a thread auxiliar: sobrevive mesmo se a tentativa for abandonada
+    struct Tentativa {
+        Sinal                   sinal;
+        std::mutex              m;
+        std::condition_variable cv;
+        bool                    terminou = false;
+        bool                    ok = false;
+        std::string             erro;
+    };
+    auto t = std::make_shared<Tentativa>();
+
+    std::thread auxiliar([t, funcao] {
+        bool ok = false;
+        std::string e;
+        try {
+            ok = funcao(t->sinal);
+            if (!ok) e = "retornou false";
+        } catch (const std::exception& ex) {
+            e = ex.what();
+        }
+        std::lock_guard<std::mutex> guarda(t->m);
+        t->terminou = true;
+        t->ok = ok;
+        t->erro = std::move(e);
+        t->cv.notify_all();
+    });
+
+    std::unique_lock<std::mutex> lk(t->m);
+    for (;;) {
+        // acorda a cada 5 ms para ver se o boot foi abortado
+        const auto proxima = std::min(limite, Relogio::now() + std::chrono::milliseconds(5));
+        if (t->cv.wait_until(lk, proxima, [&] { return t->terminou; })) break;
+        if (abortar.load(std::memory_order_acquire) || Relogio::now() >= limite) {
+            const bool abortada = abortar.load(std::memory_order_acquire);
+            t->sinal.pedir();
+            lk.unlock();
+            auxiliar.detach();   // não esperamos: ela termina sozinha (ou nunca)
+            erro = abortada ? "boot abortado" : "sem resposta dentro do limite";
+            return abortada ? Desfecho::ABORTADA : Desfecho::TEMPO;
+        }
+    }
+    lk.unlock();
+    auxiliar.join();
+    erro = t->erro;
+    return t->ok ? Desfecho::SUCESSO : Desfecho::FALHA;
+}
+
+// Espera 'ms' ou até o boot ser abortado (o que vier primeiro); false se abortou
+bool esperar(double ms, const std::atomic<bool>& abortar) {
+    const auto fim = Relogio::now() + std::chrono::microseconds(static_cast<long long>(ms * 1000.0));
+    while (Relogio::now() < fim) {
+        if (abortar.load(std::memory_order_acquire)) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return !abortar.load(std::memory_order_acquire);
+}
+
+/*---------------------------------------------------
+ O executor do boot
+-----------------------------------------------------*/
+class ExecutorBoot {
+public:
+    // Dependências precisam ter sido registradas antes: assim a ordem de
+    // registro já é topológica e não há como formar ciclos.
+    bool registrar(std::string nome, Politica politica, std::vector<std::string> depende_de,
+                   Inicializacao funcao, std::string& erro) {
+        std::vector<int> deps;
+        for (const auto& d : depende_de) {
+            auto it = std::find_if(subsistemas_.begin(), subsistemas_.end(),
+                                   [&](const Subsistema& s) { return s.nome == d; });
+            if (it == subsistemas_.end()) {
+                erro = nome + " depende de '" + d + "', que não foi registrado antes";
+                return false;
+            }
+            deps.push_back(static_cast<int>(it - subsistemas_.begin()));
+        }
+        subsistemas_.push_back({std::move(nome), politica, std::move(deps), std::move(funcao)});
+        return true;
+    }
+
+    RelatorioBoot executar(int threads) {
+        const int n = static_cast<int>(subsistemas_.size());
+        RelatorioBoot r;
+        for (const auto& s : subsistemas_) {
+            r.nomes.push_back(s.nome);
+            r.essenciais.push_back(s.politica.essencial);
+        }
+        r.status.assign(n, Status{});
+        Status* st = r.status.data();
+        abortar_.store(false);
+        inicio_ = Relogio::now();
+
+        #pragma omp parallel num_threads(threads)
+        #pragma omp single
+        #pragma omp taskgroup
+        {
+            for (int i = 0; i < n; ++i) {
+                const int* deps = subsistemas_[i].deps.data();
+                const int nd = static_cast<int>(subsistemas_[i].deps.size());
+                #pragma omp task firstprivate(i) depend(out: st[i]) depend(iterator(j = 0:nd), in: st[deps[j]])
+                {
+                    executar_um(i, st);
+                    if (st[i].estado != Estado::OK && st[i].estado != Estado::CANCELADO
+                        && subsistemas_[i].politica.essencial) {
+                        abortar_.store(true, std::memory_order_release);
+                        #pragma omp cancel taskgroup
+                    }
+                }
+            }
+        }   // fim do taskgroup: todas terminaram ou foram descartadas
+
+        r.total_ms = ms_desde_inicio();
+        r.abortado = abortar_.load();
+        // Tarefas descartadas pelo cancel nunca rodaram
+        for (auto& s : r.status) {
+            if (s.estado == Estado::PENDENTE) {
+                s.estado = Estado::CANCELADO;
+                s.erro = "descartado pelo cancel taskgroup";
+            }
+        }
+        return r;
+    }
+
+private:
+    struct Subsistema {
+        std::string      nome;
+        Politica         politica;
+        std::vector<int> deps;
+        Inicializacao    funcao;
+    };
+
+    double ms_desde_inicio() const {
+        return std::chrono::duration<double, std::milli>(Relogio::now() - inicio_).count();
+    }
+
+    void executar_um(int i, Status* st) {
+        Status& s = st[i];
+        const Subsistema& sub = subsistemas_[i];
+        s.inicio = ms_desde_inicio();
+
+        if (abortar_.load(std::memory_order_acquire)) {
+            s.estado = Estado::CANCELADO;
+            s.erro = "boot abortado antes de começar";
+            s.fim = s.inicio;
+            return;
+        }
+        for (int d : sub.deps) {
+            if (st[d].estado != Estado::OK) {
+                s.estado = Estado::PULADO;
+                s.erro = "dependência '" + subsistemas_[d].nome + "' não iniciou";
+                s.fim = s.inicio;
+                return;
+            }
+        }
+
+        const auto prazo = Relogio::now() + std::chrono::microseconds(static_cast<long long>(sub.politica.prazo_ms * 1000.0));
+        double espera = sub.politica.espera_ms;
+        for (int k = 1; k <= sub.politica.tentativas; ++k) {
+            s.tentativas = k;
+            const auto limite = std::min(prazo, Relogio::now() + std::chrono::microseconds(
+                                                    static_cast<long long>(sub.politica.limite_ms * 1000.0)));
+            const Desfecho d = tentar(sub.funcao, limite, abortar_, s.erro);
+            if (d == Desfecho::SUCESSO) { s.estado = Estado::OK; s.erro.clear(); break; }
+            if (d == Desfecho::ABORTADA) { s.estado = Estado::CANCELADO; break; }
+
+            s.estado = (d == Desfecho::TEMPO) ? Estado::TEMPO_ESGOTADO : Estado::FALHOU;
+            if (k == sub.politica.tentativas) break;
+
+            // Backoff: só espera se ainda couber uma tentativa dentro do prazo
+            const double resta = std::chrono::duration<double, std::milli>(prazo - Relogio::now()).count();
+            if (resta <= espera) { s.estado = Estado::TEMPO_ESGOTADO; s.erro += " (prazo do subsistema esgotado)"; break; }
+            if (!esperar(espera, abortar_)) { s.estado = Estado::CANCELADO; s.erro = "boot abortado"; break; }
+            espera *= 2.0;
+        }
+        s.fim = ms_desde_inicio();
+    }
+
+    std::vector<Subsistema> subsistemas_;
+    std::atomic<bool>       abortar_{false};
+    Relogio::time_point     inicio_;
+};
+
+/*---------------------------------------------------
+ Serviço falso (para testar sem rede)
+-----------------------------------------------------*/
+struct ServicoFalso {
+    double           latencia_ms = 50.0;
+    int              falhas_iniciais = 0;   // as primeiras chamadas lançam erro
+    bool             falha_sempre = false;
+    bool             trava = false;         // não responde e ignora o Sinal
+    std::atomic<int> chamadas{0};
+
+    bool operator()(const Sinal& sinal) {
+        const int c = ++chamadas;
+        if (trava) {
+            std::this_thread::sleep_for(std::chrono::seconds(3));   // "preso" numa chamada de sistema
+            return true;
+        }
+        // Trabalha em fatias de 1 ms, atendendo ao pedido de cancelamento
+        const auto fim = Relogio::now() + std::chrono::microseconds(static_cast<long long>(latencia_ms * 1000.0));
+        while (Relogio::now() < fim) {
+            if (sinal.cancelado()) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (falha_sempre || c <= falhas_iniciais) throw std::runtime_error("conexão recusada (chamada " + std::to_string(c) + ")");
+        return true;
+    }
+};
+
+// A função guarda um shared_ptr: uma tentativa abandonada ainda pode usar o serviço
+Inicializacao usar(std::shared_ptr<ServicoFalso> servico) {
+    return [servico](const Sinal& s) { return (*servico)(s); };
+}
+
+void imprimir_tabela(const char* cenario, const RelatorioBoot& r) {
+    std::cout << "\n=== " << cenario << " ===\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << " subsistema      | essencial | estado          | tent. | início (ms) | fim (ms) | detalhe\n";
+    std::cout << "-----------------------------------------------------------------------------------------------\n";
+    for (std::size_t i = 0; i < r.status.size(); ++i) {
+        const Status& s = r.status[i];
+        std::cout << " " << std::left << std::setw(15) << r.nomes[i]
+                  << " | " << std::setw(9) << (r.essenciais[i] ? "sim" : "nao")
+                  << " | " << std::setw(15) << nome_estado(s.estado) << std::right
+                  << " | " << std::setw(5) << s.tentativas
+                  << " | " << std::setw(11) << s.inicio
+                  << " | " << std::setw(8) << s.fim
+                  << " | " << s.erro << "\n";
+    }
+    std::cout << "Boot: " << (r.sucesso() ? (r.degradado() ? "OK (degradado)" : "OK") : "FALHOU")
+              << (r.abortado ? ", abortado" : "") << " em " << r.total_ms << " ms\n";
+}
+
+std::string escapar_json(const std::string& s) {
+    std::string o;
+    for (char c : s) {
+        if (c == '"' || c == '\\') o += '\\';
+        o += c;
+    }
+    return o;
+}
+
+void imprimir_json(const char* cenario, const RelatorioBoot& r, bool ultimo) {
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  {\"cenario\": \"" << escapar_json(cenario) << "\", \"sucesso\": " << (r.sucesso() ? "true" : "false")
+              << ", \"degradado\": " << (r.degradado() ? "true" : "false")
+              << ", \"abortado\": " << (r.abortado ? "true" : "false")
+              << ", \"total_ms\": " << r.total_ms << ", \"subsistemas\": [\n";
+    for (std::size_t i = 0; i < r.status.size(); ++i) {
+        const Status& s = r.status[i];
+        std::cout << "    {\"nome\": \"" << escapar_json(r.nomes[i]) << "\", \"essencial\": " << (r.essenciais[i] ? "true" : "false")
+                  << ", \"estado\": \"" << nome_estado(s.estado) << "\", \"tentativas\": " << s.tentativas
+                  << ", \"inicio_ms\": " << s.inicio << ", \"fim_ms\": " << s.fim
+                  << ", \"erro\": \"" << escapar_json(s.erro) << "\"}" << (i + 1 < r.status.size() ? ",\n" : "\n");
+    }
+    std::cout << "  ]}" << (ultimo ? "\n" : ",\n");
+}
+
+int main(int argc, char* argv[]) {
+    // cancel só tem efeito se OMP_CANCELLATION=true (o padrão é false);
+    // sem ela a flag abortar continua funcionando
+    garantir_ambiente_omp(argv, {{"OMP_CANCELLATION", "true"}});
+    const bool json = argc > 1 && std::strcmp(argv[1], "--json") == 0;
+
+    struct Cenario {
+        const char* nome;
+        bool        api_falha_duas_vezes;
+        bool        api_trava;
+        bool        banco_falha;
+        bool        espera_sucesso;
+    };
+    const Cenario cenarios[] = {
+        {"API falha 2x e se recupera",         true,  false, false, true},
+        {"API travada (opcional, prazo 300 ms)", false, true,  false, true},
+        {"Banco falha sempre (essencial)",     false, false, true,  false},
+    };
+
+    if (json) std::cout << "[\n";
+    else std::cout << "--- Boot com prazos, novas tentativas e cancelamento (OMP_CANCELLATION = "
+                   << (omp_get_cancellation() ? "ligado" : "desligado") << ") ---\n";
+
+    bool ok = true;
+    for (std::size_t c = 0; c < std::size(cenarios); ++c) {
+        const Cenario& cen = cenarios[c];
+
+        auto config = std::make_shared<ServicoFalso>();
+        config->latencia_ms = 30;
+        auto banco = std::make_shared<ServicoFalso>();
+        banco->latencia_ms = cen.banco_falha ? 40 : 200;   // conexão recusada responde rápido
+        banco->falha_sempre = cen.banco_falha;
+        auto api = std::make_shared<ServicoFalso>();
+        api->latencia_ms = 60;
+        api->falhas_iniciais = cen.api_falha_duas_vezes ? 2 : 0;
+        api->trava = cen.api_trava;
+        auto cache = std::make_shared<ServicoFalso>();
+        cache->latencia_ms = 400;
+        auto relatorios = std::make_shared<ServicoFalso>();
+        relatorios->latencia_ms = 50;
+
+        //                      prazo  limite  tent.  espera  essencial
+        const Politica p_config {  200,   100,    2,     10,   true  };
+        const Politica p_banco  {  600,   300,    2,     20,   true  };
+        const Politica p_api    {  300,   120,    4,     10,   false };
+        const Politica p_cache  {  800,   800,    1,     10,   true  };
+        const Politica p_relat  {  200,   200,    1,     10,   false };
+
+        ExecutorBoot boot;
+        std::string erro;
+        bool registrou = boot.registrar("configuracao", p_config, {}, usar(config), erro)
+                      && boot.registrar("banco", p_banco, {"configuracao"}, usar(banco), erro)
+                      && boot.registrar("api_externa", p_api, {"configuracao"}, usar(api), erro)
+                      && boot.registrar("cache", p_cache, {"configuracao"}, usar(cache), erro)
+                      && boot.registrar("relatorios", p_relat, {"banco"}, usar(relatorios), erro);
+        if (!registrou) {
+            std::cout << "[FALHA] " << erro << "\n";
+            return 1;
+        }
+
+        const RelatorioBoot r = boot.executar(4);
+        if (json) imprimir_json(cen.nome, r, c + 1 == std::size(cenarios));
+        else imprimir_tabela(cen.nome, r);
+        ok = ok && r.sucesso() == cen.espera_sucesso;
+    }
+    if (json) std::cout << "]\n";
+    else std::cout << (ok ? "\nTodos os cenários terminaram como esperado.\n" : "\nERRO: algum cenário terminou diferente do esperado.\n");
+
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. API falha 2x: as duas primeiras tentativas lançam exceção; a terceira,
+   depois de 10 + 20 ms de espera, funciona (3 x 60 + 30 = 210 ms, dentro
+   do prazo de 300 ms). O boot termina OK.
+
+2. API travada: cada tentativa é abandonada após 120 ms e o prazo de 300 ms
+   do subsistema acaba antes da 3ª. Como a API não é essencial, o boot
+   termina "OK (degradado)" — no tempo do cache (400 ms), e não nos 3 s que
+   o serviço levaria para responder. A thread auxiliar presa é abandonada
+   (detach) e termina sozinha depois.
+
+3. Banco falha sempre: depois da 2ª falha (~40 + 20 + 40 ms) o banco aborta o boot. O cache,
+   que estava no meio dos seus 400 ms, recebe o Sinal e para; "relatorios"
+   (que depende do banco) não chega a rodar. O boot termina bem antes dos
+   400 ms do cache.
+
+4. O prazo limita o subsistema, não só a tentativa: a espera entre tentativas
+   (backoff) também conta, e não se começa uma tentativa que já não cabe.
+
+5. Com --json o relatório sai estruturado, para ser lido por outro programa
+   (monitoramento, CI).
+*/
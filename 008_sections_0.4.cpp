@@ -0,0 +1,354 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 008_sections_0.4.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Lazy subsystem handles warmed by OpenMP tasks: time-to-first-work vs full warm-up
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+Exemplo: inicialização preguiçosa (lazy)
+-----------------------------------------------------
+Em 008_sections_0.1 o programa só começa a trabalhar depois da barreira,
+isto é, depois do subsistema MAIS LENTO (o banco, 2 s). Mas boa parte do
+trabalho real precisa só da configuração e do cache, que ficam prontos
+muito antes.
+
+Aqui cada subsistema vira um Recurso<T> ("handle"):
+  - aquecer() : cria o objeto (chamado por uma omp task em segundo plano);
+  - obter()   : devolve o objeto; se ainda não está pronto, espera SÓ por
+                ele. Se ninguém começou a criá-lo, a própria thread cria
+                (sob demanda). Se a criação lançou uma exceção, obter()
+                a relança (para quem chamar, sempre a mesma).
+
+Três modos de boot, atendendo a mesma fila de requisições:
+  1) ansioso   : parallel sections + barreira (008_sections_0.1), depois atende
+  2) aquecendo : cada recurso vira uma task; a thread principal começa a
+                 atender na hora, enquanto as outras aquecem
+  3) sob demanda: nada é criado antes; o primeiro acesso paga a criação
+
+Métricas:
+  primeiro trabalho : quando a primeira requisição termina
+  fila atendida     : quando a última requisição termina
+  aquecimento total : quando o último recurso ficou pronto
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <omp.h>
+#include <iomanip>
+
+/*---------------------------------------------------
+ Recurso<T>: handle com inicialização preguiçosa
+-----------------------------------------------------*/
+class Aquecivel {
+public:
+    virtual ~Aquecivel() = default;
+    virtual void aquecer() = 0;
+    virtual bool pronto() const = 0;
+    virtual double pronto_em() const = 0;   // omp_get_wtime() de quando ficou pronto (0 se nunca)
+    virtual const std::string& nome() const = 0;
+};
+
+template <typename T>
+class Recurso : public Aquecivel {
+public:
+    Recurso(std::string nome, std::function<T()> criar)
+        : nome_(std::move(nome)), criar_(std::move(criar)) {}
+
+    // Cria o objeto, se ninguém começou ainda (quem perder a corrida só retorna).
+    // Não lança: roda dentro de uma omp task, de onde uma exceção não pode sair.
+    // Se criar_() falhar, a exceção é guardada e o estado vai para FALHOU.
+    void aquecer() override {
+        int esperado = NAO_INICIADO;
+        if (!estado_.compare_exchange_strong(esperado, CRIANDO, std::memory_order_acq_rel)) return;
+        try {
+            objeto_ = std::make_unique<T>(criar_());
+        } catch (...) {
+            erro_ = std::current_exception();
+            estado_.store(FALHOU, std::memory_order_release);   // publica erro_
+            return;
+        }
+        pronto_em_ = omp_get_wtime();
+        estado_.store(PRONTO, std::memory_order_release);   // publica objeto_
+    }
+
+    // Espera só por este recurso. Se a task de aquecimento ainda não rodou
+    // (todas as threads ocupadas), a própria thread cria: nunca trava.
+    // Se a criação falhou, relança a exceção original.
+    T& obter() {
+        int estado = estado_.load(std::memory_order_acquire);
+        if (estado != PRONTO) {
+            aquecer();
+            while ((estado = estado_.load(std::memory_order_acquire)) == CRIANDO) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            if (estado == FALHOU) std::rethrow_exception(erro_);
+        }
+        return *objeto_;
+    }
+
+    bool pronto() const override { return estado_.load(std::memory_order_acquire) == PRONTO; }
+    double pronto_em() const override { return pronto() ? pronto_em_ : 0.0; }
+    const std::string& nome() const override { return nome_; }
+
+private:
+    enum { NAO_INICIADO, CRIANDO, PRONTO, FALHOU };
+    std::string         nome_;
+    std::function<T()>  criar_;
+    std::atomic<int>    estado_{NAO_INICIADO};
+    std::unique_ptr<T>  objeto_;
+    std::exception_ptr  erro_;
+    double              pronto_em_ = 0.0;
+};
+
+/*---------------------------------------------------
+ Os subsistemas do 008_sections_0.1 (tempos / 10)
+-----------------------------------------------------*/
+struct Configuracao { int porta; std::string ambiente; };
+struct Cache        { std::vector<int> tabela; };
+struct ClienteApi   { double cotacao; };
+struct BancoDeDados { std::vector<double> saldos; };
+
+void demorar(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+struct Subsistemas {
+    Recurso<Configuracao> config{"configuracao", [] { demorar(50);  return Configuracao{8080, "producao"}; }};
+    Recurso<Cache>        cache {"cache",        [] { demorar(100); return Cache{std::vector<int>(1024, 7)}; }};
+    Recurso<ClienteApi>   api   {"api_externa",  [] { demorar(150); return ClienteApi{5.27}; }};
+    Recurso<BancoDeDados> banco {"banco",        [] { demorar(200); return BancoDeDados{std::vector<double>(1000, 100.0)}; }};
+
+    std::vector<Aquecivel*> todos() { return {&config, &cache, &api, &banco}; }
+};
+
+/*---------------------------------------------------
+ A fila de requisições
+-----------------------------------------------------*/
+enum class Tipo { STATUS, COTACAO, EXTRATO };   // precisam de: config+cache, config+api, config+banco
+
+const char* nome_tipo(Tipo t) {
+    switch (t) {
+        case Tipo::STATUS:  return "status  (config+cache)";
+        case Tipo::COTACAO: return "cotacao (config+api)";
+        default:            return "extrato (config+banco)";
+    }
+}
+
+struct Medicao {
+    double primeiro_trabalho = 0.0;
+    double fila_atendida = 0.0;
+    double aquecimento_total = 0.0;
+    int    nao_criados = 0;
+    double primeira_por_tipo[3] = {0.0, 0.0, 0.0};
+    double soma = 0.0;   // checagem: todos os modos devem calcular o mesmo
+};
+
+// Atende em ordem; cada requisição obtém só o que precisa e gasta 5 ms
+void atender(Subsistemas& s, const std::vector<Tipo>& fila, double t0, Medicao& m) {
+    for (Tipo tipo : fila) {
+        double valor = s.config.obter().porta;
+        switch (tipo) {
+            case Tipo::STATUS:  valor += s.cache.obter().tabela[3];   break;
+            case Tipo::COTACAO: valor += s.api.obter().cotacao;       break;
+            case Tipo::EXTRATO: valor += s.banco.obter().saldos[10];  break;
+        }
+        demorar(5);
+        const double agora = omp_get_wtime() - t0;
+        m.soma += valor;
+        if (m.primeiro_trabalho == 0.0) m.primeiro_trabalho = agora;
+        double& primeira = m.primeira_por_tipo[static_cast<int>(tipo)];
+        if (primeira == 0.0) primeira = agora;
+    }
+    m.fila_atendida = omp_get_wtime() - t0;
+}
+
+void fechar(Subsistemas& s, double t0, Medicao& m) {
+    for (Aquecivel* r : s.todos()) {
+        if (r->pronto()) m.aquecimento_total = std::max(m.aquecimento_total, r->pronto_em() - t0);
+        else ++m.nao_criados;
+    }
+}
+
+// 1) Ansioso: como o 008_sections_0.1
+Medicao ansioso(const std::vector<Tipo>& fila) {
+    Subsistemas s;
+    Medicao m;
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel sections num_threads(4)
+    {
+        #pragma omp section
+        s.config.aquecer();
+        #pragma omp section
+        s.cache.aquecer();
+        #pragma omp section
+        s.api.aquecer();
+        #pragma omp section
+        s.banco.aquecer();
+    }   // barreira: espera o banco
+    atender(s, fila, t0, m);
+    fechar(s, t0, m);
+    return m;
+}
+
+// 2) Aquecendo em segundo plano: uma thread atende, as outras aquecem
+Medicao aquecendo(const std::vector<Tipo>& fila) {
+    Subsistemas s;
+    Medicao m;
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(5)
+    #pragma omp single
+    {
+        // Quem é usado primeiro é criado primeiro
+        for (Aquecivel* r : s.todos()) {
+            #pragma omp task firstprivate(r)
+            r->aquecer();
+        }
+        atender(s, fila, t0, m);   // a thread do single não espera as tasks
+    }   // barreira: as tasks de aquecimento que faltavam terminam aqui
+    fechar(s, t0, m);
+    return m;
+}
+
+// 3) Sob demanda: nada é aquecido antes
+Medicao sob_demanda(const std::vector<Tipo>& fila) {
+    Subsistemas s;
+    Medicao m;
+    const double t0 = omp_get_wtime();
+    atender(s, fila, t0, m);
+    fechar(s, t0, m);
+    return m;
+}
+
+int main() {
+    // Muitos "status" no começo, cotações e extratos mais tarde
+    std::vector<Tipo> fila;
+    for (int i = 0; i < 8; ++i) fila.push_back(Tipo::STATUS);
+    fila.push_back(Tipo::COTACAO);
+    for (int i = 0; i < 8; ++i) fila.push_back(Tipo::STATUS);
+    fila.push_back(Tipo::EXTRATO);
+    for (int i = 0; i < 4; ++i) { fila.push_back(Tipo::STATUS); fila.push_back(Tipo::COTACAO); fila.push_back(Tipo::EXTRATO); }
+
+    std::cout << "--- Boot ansioso x preguiçoso (" << fila.size() << " requisições de 5 ms) ---\n";
+    std::cout << "Tempos de criação: configuracao 50, cache 100, api 150, banco 200 ms\n\n";
+
+    struct Modo {
+        const char* nome;
+        Medicao (*rodar)(const std::vector<Tipo>&);
+    };
+    const Modo modos[] = {
+        {"ansioso (sections)", ansioso},
+        {"aquecendo (tasks)", aquecendo},
+        {"sob demanda", sob_demanda},
+    };
+
+    std::vector<Medicao> medicoes;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << " modo               | primeiro trabalho | fila atendida | aquecimento total\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    for (const Modo& modo : modos) {
+        const Medicao m = modo.rodar(fila);
+        medicoes.push_back(m);
+        std::cout << " " << std::left << std::setw(18) << modo.nome << std::right
+                  << " | " << std::setw(14) << m.primeiro_trabalho * 1e3 << " ms"
+                  << " | " << std::setw(10) << m.fila_atendida * 1e3 << " ms"
+                  << " | " << std::setw(14) << m.aquecimento_total * 1e3 << " ms"
+                  << (m.nao_criados ? "  (" + std::to_string(m.nao_criados) + " nunca usados)" : std::string()) << "\n";
+    }
+
+    std::cout << "\nPrimeira requisição concluída de cada tipo (ms):\n";
+    std::cout << " tipo                    | ansioso | aquecendo | sob demanda\n";
+    std::cout << "--------------------------------------------------------------\n";
+    for (int t = 0; t < 3; ++t) {
+        std::cout << " " << std::left << std::setw(23) << nome_tipo(static_cast<Tipo>(t)) << std::right
+                  << " | " << std::setw(7) << medicoes[0].primeira_por_tipo[t] * 1e3
+                  << " | " << std::setw(9) << medicoes[1].primeira_por_tipo[t] * 1e3
+                  << " | " << std::setw(11) << medicoes[2].primeira_por_tipo[t] * 1e3 << "\n";
+    }
+
+    const bool ok = medicoes[0].soma == medicoes[1].soma && medicoes[1].soma == medicoes[2].soma;
+    std::cout << (ok ? "\nOs três modos atenderam as mesmas requisições com os mesmos resultados.\n"
+                     : "\nERRO: resultados diferentes entre os modos.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Ansioso: nada acontece antes de ~200 ms (o banco). O primeiro trabalho
+   sai em ~205 ms, mesmo sendo um "status" que só precisa de config e cache.
+
+2. Aquecendo: o primeiro "status" espera só o cache (~100 ms) e sai em
+   ~105 ms. O aquecimento total continua ~200 ms — só deixou de bloquear
+   quem não precisa do banco. É o melhor dos três para o primeiro trabalho
+   e para a fila inteira.
+
+3. Sob demanda: nenhum custo antecipado, mas o primeiro acesso a cada
+   recurso paga a criação INTEIRA no caminho da requisição, em série:
+   config + cache antes do 1º status, api antes da 1ª cotação, banco antes
+   do 1º extrato. Bom para recursos raramente usados; ruim para os
+   essenciais.
+
+4. A fila é atendida em ordem por uma só thread: um "extrato" que chega
+   antes do banco ficar pronto segura os que vêm atrás dele (bloqueio na
+   cabeça da fila). Com mais threads atendendo, só ele esperaria.
+
+5. obter() nunca trava: se a task de aquecimento ainda não começou (todas
+   as threads ocupadas), a thread que pediu cria o recurso ela mesma.
+   Teste com OMP_THREAD_LIMIT=1 para ver o "aquecendo" virar "sob demanda".
+*/
@@ -0,0 +1,959 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 009_bhaskara_lote_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Batch quadratic solver: branch-free omp simd / AVX2 / AVX-512 kernels with runtime dispatch
+ * Semester  : 2026/2
+ * Version   : 1.2
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : EquationBatch (aligned SoA columns, optional huge pages); root-class column.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Bhaskara em LOTE (batch) com SIMD
+-----------------------------------------------------
+ Nos exemplos 006 e 007 a função resolver_bhaskara(a, b, c) é chamada
+ uma vez por equação dentro de um #pragma omp parallel for:
+
+     #pragma omp parallel for
+     for (int i = 0; i < N; ++i)
+         soma_local = resolver_bhaskara(a[i], b[i], c[i]);
+
+ Isso funciona, mas tem dois problemas quando N chega a centenas de milhões:
+
+ 1. O if (delta < 0) return 0.0; é um DESVIO que depende do dado.
+    O compilador não consegue vetorizar o laço (cada elemento pode seguir
+    um caminho diferente) e o preditor de desvios erra muito quando os
+    dados misturam equações com e sem raízes reais.
+
+ 2. A chamada é feita elemento a elemento. Cada thread usa só 1 das
+    4 (AVX2) ou 8 (AVX-512) "pistas" (lanes) do registrador vetorial.
+
+ A ideia deste script é um MOTOR DE LOTE:
+   - recebe os vetores inteiros a[], b[], c[];
+   - preenche x1[], x2[] e uma coluna de bytes classe[]
+     (0 = sem raízes reais, 1 = raiz dupla, 2 = duas raízes distintas);
+   - não tem desvios: calcula as duas "respostas" e seleciona com máscara
+     (a raiz quadrada é feita só nas pistas com delta >= 0 — "sqrt mascarada");
+   - escolhe, em TEMPO DE EXECUÇÃO, o melhor kernel que a CPU suporta:
+        AVX-512  ->  AVX2 + FMA  ->  omp simd (portável).
+
+ O resultado é idêntico ao de resolver_bhaskara: quando delta < 0,
+ x1 = x2 = 0 e classe = 0.
+
+ Dois MODOS de cálculo (mesma vazão, mesmos kernels SIMD):
+
+   RAPIDO  -> a fórmula da aula:  x = (-b ± √Δ) / 2a
+   ESTAVEL -> a forma "citardauq" (Vieta), sem cancelamento catastrófico:
+
+                 q  = -(b + sinal(b)·√Δ) / 2
+                 x_grande  = q / a
+                 x_pequena = c / q            (pois x1·x2 = c/a)
+
+   Por que existe o modo ESTAVEL?
+   Quando b² é muito maior que 4ac, √Δ ≈ |b| e a conta (-b + √Δ) subtrai
+   dois números quase iguais: quase todos os dígitos significativos se
+   perdem (cancelamento catastrófico). Ex.: x² - 10⁸x + 1 = 0 tem raiz
+   pequena 10⁻⁸, mas a fórmula direta em double devolve ~7.45·10⁻⁹ (erro de 25%).
+   Na forma citardauq, -b e sinal(b)·√Δ têm o MESMO sinal: é uma soma, não
+   uma subtração, e a raiz pequena sai de c/q sem cancelamento.
+
+   O discriminante também é calculado com FMA (algoritmo de Kahan):
+       w = 4ac (arredondado)
+       e = fma(-4a, c, w)       -> erro exato do produto 4ac
+       Δ = fma(b, b, -w) + e
+   Assim Δ fica correto mesmo quando b² ≈ 4ac (raízes quase duplas).
+
+   Para manter os dois modos intercambiáveis, x1 continua sendo a raiz
+   "(-b + √Δ) / 2a" e x2 a raiz "(-b - √Δ) / 2a": quando b < 0 a raiz
+   grande é x1, quando b >= 0 a raiz grande é x2.
+
+ Divisão do trabalho:
+   - o #pragma omp parallel for divide o lote em BLOCOS entre as threads;
+   - dentro de cada bloco, o kernel SIMD processa 4 ou 8 equações por instrução.
+
+ Armazenamento: EquationBatch (estrutura de vetores, SoA)
+   Os exemplos anteriores usam std::vector<double> a(N), b(N), c(N) e, no
+   006_sincronizacao_0.6, guardam o resultado em std::pair<double,double>
+   (um vetor de estruturas, AoS: x1 e x2 intercalados na memória).
+   O EquationBatch guarda cada coluna (a, b, c, x1, x2, classe) contígua e
+   alinhada a 64 bytes (uma linha de cache / um registrador AVX-512):
+     - cada instrução SIMD lê ou escreve uma coluna inteira de 8 valores;
+     - nenhuma carga vetorial atravessa duas linhas de cache;
+     - a escrita de x1 e x2 é sequencial (streaming), sem intercalação.
+   Opcionalmente a memória é marcada para PÁGINAS GRANDES transparentes
+   (Transparent Huge Pages, 2 MB no Linux). Com páginas de 4 KB, 10⁹
+   equações (~41 GB) ocupam ~10 milhões de páginas e a TLB erra a cada
+   4 KB percorridos; com 2 MB são ~20 mil páginas.
+
+ Escrita de x1 e x2 (política Escrita, escrita_nt.hpp)
+   x1, x2 são só escritos pelo motor. Com escrita normal cada linha de
+   x1/x2 é LIDA da memória antes de ser sobrescrita (write-allocate) e
+   expulsa a, b, c da cache. Com escrita não temporal as linhas vão direto
+   para a memória. A política AUTOMATICA (padrão) liga o streaming quando o
+   lote (41 bytes por equação) não cabe na última cache. Só os kernels
+   AVX2/AVX-512 têm versão streaming (kernel_avx2<true>, kernel_avx512<true>).
+
+ Compilar (GCC/MinGW/WSL):
+   g++ -O3 -fopenmp -fno-math-errno 009_bhaskara_lote_0.0.cpp -o 009_bhaskara_lote_0.0
+
+   (-fno-math-errno permite que std::sqrt vire uma instrução vetorial no kernel omp simd;
+    os kernels AVX2/AVX-512 não precisam de flags extras, pois usam __attribute__((target)).)
+
+ Executar (N opcional, padrão 10 milhões de equações):
+   ./009_bhaskara_lote_0.0 50000000
+
+ Escolher o modo (padrão "rapido") e páginas grandes (padrão: desligado):
+   ./009_bhaskara_lote_0.0 50000000 estavel
+   ./009_bhaskara_lote_0.0 50000000 estavel thp
+
+ Forçar a escrita de x1/x2 (padrão: automática pelo tamanho do lote):
+   ./009_bhaskara_lote_0.0 50000000 normal
+   ./009_bhaskara_lote_0.0 50000000 nt
+
+ Forçar um kernel específico (para comparar):
+   BHASKARA_KERNEL=simd   ./009_bhaskara_lote_0.0
+   BHASKARA_KERNEL=avx2   ./009_bhaskara_lote_0.0
+   BHASKARA_KERNEL=avx512 ./009_bhaskara_lote_0.0
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <iomanip>
+#include <new>
+#include <omp.h>
+
+#if defined(_WIN32)
+#include <malloc.h>      // _aligned_malloc
+#elif defined(__linux__)
+#include <sys/mman.h>    // madvise(MADV_HUGEPAGE)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BHASKARA_X86 1
+#endif
+
+#include "escrita_nt.hpp"
+
+// Versão original (006_sincronizacao_0.6), usada como referência de corretude.
+std::pair<double, double> resolver_bhaskara(double a, double b, double c) {
+    double delta = (b * b) - (4 * a * c);
+
+    if (delta < 0) {
+        return {0.0, 0.0};
+    }
+
+    double x1 = (-b + std::sqrt(delta)) / (2 * a);
+    double x2 = (-b - std::sqrt(delta)) / (2 * a);
+
+    return {x1, x2};
+}
+
+/*---------------------------------------------------
+ EquationBatch: lote de equações em colunas (SoA)
+-----------------------------------------------------
+ Uma única alocação contém as seis colunas, uma após a outra, cada uma
+ começando em um endereço múltiplo de 64 bytes.
+
+ A memória NÃO é inicializada aqui: quem escreve primeiro em cada página
+ (a inicialização paralela no main) decide onde ela fica fisicamente.
+ Com páginas grandes, o bloco todo é alinhado a 2 MB e marcado com
+ madvise(MADV_HUGEPAGE) — o kernel do Linux passa a usar páginas de 2 MB
+ quando possível. Em outros sistemas o pedido é ignorado.
+*/
+class EquationBatch {
+public:
+    static constexpr std::size_t ALINHAMENTO   = 64;
+    static constexpr std::size_t PAGINA_GRANDE = 2u << 20;   // 2 MB
+
+    explicit EquationBatch(std::size_t n, bool paginas_grandes = false) : n_(n) {
+        const std::size_t col_double = arredondar(n * sizeof(double), ALINHAMENTO);
+        const std::size_t col_byte   = arredondar(n * sizeof(std::uint8_t), ALINHAMENTO);
+        const std::size_t alinhamento = paginas_grandes ? PAGINA_GRANDE : ALINHAMENTO;
+        bytes_ = arredondar(5 * col_double + col_byte, alinhamento);
+
+#if defined(_WIN32)
+        base_ = _aligned_malloc(bytes_, alinhamento);
+#else
+        if (posix_memalign(&base_, alinhamento, bytes_) != 0) base_ = nullptr;
+#endif
+        if (!base_) throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (paginas_grandes) paginas_grandes_ = (madvise(base_, bytes_, MADV_HUGEPAGE) == 0);
+#endif
+
+        char* p = static_cast<char*>(base_);
+        a  = reinterpret_cast<double*>(p + 0 * col_double);
+        b  = reinterpret_cast<double*>(p + 1 * col_double);
+        c  = reinterpret_cast<double*>(p + 2 * col_double);
+        x1 = reinterpret_cast<double*>(p + 3 * col_double);
+        x2 = reinterpret_cast<double*>(p + 4 * col_double);
+        classe = reinterpret_cast<std::uint8_t*>(p + 5 * col_double);
+    }
+
+    ~EquationBatch() {
+#if defined(_WIN32)
+        _aligned_free(base_);
+#else
+        std::free(base_);
+#endif
+    }
+
+    // Dono exclusivo da memória: não copia.
+    EquationBatch(const EquationBatch&) = delete;
+    EquationBatch& operator=(const EquationBatch&) = delete;
+
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return bytes_; }
+    bool usa_paginas_grandes() const { return paginas_grandes_; }
+
+    // Colunas (acesso direto, como em um std::vector::data())
+    double* a  = nullptr;
+    double* b  = nullptr;
+    double* c  = nullptr;
+    double* x1 = nullptr;
+    double* x2 = nullptr;
+    std::uint8_t* classe = nullptr;
+
+private:
+    static std::size_t arredondar(std::size_t x, std::size_t m) { return (x + m - 1) / m * m; }
+
+    std::size_t n_     = 0;
+    std::size_t bytes_ = 0;
+    void* base_        = nullptr;
+    bool paginas_grandes_ = false;
+};
+
+/*---------------------------------------------------
+ Assinatura comum dos kernels
+-----------------------------------------------------
+ Cada kernel resolve n equações contíguas, sem threads.
+ Quem divide o trabalho entre threads é resolver_lote().
+*/
+using KernelBhaskara = void (*)(const double* a, const double* b, const double* c,
+                                double* x1, double* x2, std::uint8_t* classe,
+                                std::size_t n);
+
+/*---------------------------------------------------
+ Kernel 1: omp simd (portável)
+-----------------------------------------------------
+ Sem if/else: o operador ?: vira uma instrução de SELEÇÃO (blend) no vetor.
+ A raiz quadrada recebe 0 nas pistas sem raiz real, então nunca é
+ calculada sobre um número negativo.
+
+ "!(delta < 0)" em vez de "delta >= 0" mantém o mesmo comportamento do
+ código original quando delta é NaN (a conta segue e o resultado é NaN).
+*/
+void kernel_simd(const double* a, const double* b, const double* c,
+                 double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        const double delta = (b[i] * b[i]) - (4 * a[i] * c[i]);
+        const bool   ok    = !(delta < 0);
+        const double raiz  = std::sqrt(ok ? delta : 0.0);
+        const double dois_a = 2 * a[i];
+
+        x1[i] = ok ? (-b[i] + raiz) / dois_a : 0.0;
+        x2[i] = ok ? (-b[i] - raiz) / dois_a : 0.0;
+        classe[i] = ok + (delta > 0);   // 0: sem raízes reais, 1: raiz dupla, 2: duas raízes
+    }
+}
+
+/*---------------------------------------------------
+ Kernel 1b: omp simd, modo ESTAVEL
+-----------------------------------------------------
+ std::fma vira uma única instrução quando o compilador pode usar FMA
+ (ex.: -march=native). Nas CPUs com AVX2/AVX-512 o kernel escolhido é um
+ dos kernels abaixo, que já usam FMA diretamente.
+*/
+void kernel_simd_estavel(const double* a, const double* b, const double* c,
+                         double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        // Discriminante de Kahan: Δ = (b² - w) + erro(4ac)
+        const double quatro_a = 4 * a[i];
+        const double w     = quatro_a * c[i];
+        const double e     = std::fma(-quatro_a, c[i], w);
+        const double delta = std::fma(b[i], b[i], -w) + e;
+
+        const bool   ok   = !(delta < 0);
+        const double raiz = std::sqrt(ok ? delta : 0.0);
+
+        // q = -(b + sinal(b)·√Δ) / 2  -> soma de termos de mesmo sinal
+        const double q         = -0.5 * (b[i] + std::copysign(raiz, b[i]));
+        const double x_grande  = q / a[i];
+        const double x_pequena = (q != 0) ? c[i] / q : 0.0;   // q == 0 só quando b = c = 0
+
+        const bool b_negativo = std::signbit(b[i]);
+        x1[i] = ok ? (b_negativo ? x_grande : x_pequena) : 0.0;
+        x2[i] = ok ? (b_negativo ? x_pequena : x_grande) : 0.0;
+        classe[i] = ok + (delta > 0);   // 0: sem raízes reais, 1: raiz dupla, 2: duas raízes
+    }
+}
+
+#ifdef BHASKARA_X86
+/*---------------------------------------------------
+ Kernel 2: AVX2 (4 doubles por registrador)
+-----------------------------------------------------
+ __attribute__((target("avx2,fma"))) gera esta função com instruções AVX2
+ mesmo que o restante do programa seja compilado para x86-64 básico.
+ Ela só é chamada se a CPU suportar AVX2 (ver escolher_kernel()).
+*/
+template <bool NT>
+__attribute__((target("avx2,fma")))
+inline void guardar_avx2(double* destino, __m256d v) {
+    if (NT) _mm256_stream_pd(destino, v);   // exige destino alinhado a 32 bytes
+    else    _mm256_storeu_pd(destino, v);
+}
+
+template <bool NT>
+__attribute__((target("avx2,fma")))
+void kernel_avx2(const double* a, const double* b, const double* c,
+                 double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    if (NT && (!alinhado_linha(x1) || !alinhado_linha(x2))) {
+        kernel_avx2<false>(a, b, c, x1, x2, classe, n);
+        return;
+    }
+    const __m256d zero   = _mm256_setzero_pd();
+    const __m256d dois   = _mm256_set1_pd(2.0);
+    const __m256d quatro = _mm256_set1_pd(4.0);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        // delta = b*b - 4*a*c (mesma ordem de operações do código original)
+        const __m256d delta = _mm256_sub_pd(_mm256_mul_pd(vb, vb),
+                                            _mm256_mul_pd(_mm256_mul_pd(quatro, va), vc));
+
+        // ok = !(delta < 0): todos os bits 1 nas pistas com raízes reais
+        const __m256d ok = _mm256_cmp_pd(delta, zero, _CMP_NLT_UQ);
+
+        // sqrt mascarada: pistas sem raiz real calculam sqrt(0)
+        const __m256d raiz   = _mm256_sqrt_pd(_mm256_and_pd(delta, ok));
+        const __m256d dois_a = _mm256_mul_pd(dois, va);
+        const __m256d menos_b = _mm256_sub_pd(zero, vb);
+
+        // AND com a máscara zera x1/x2 onde não há raiz real
+        guardar_avx2<NT>(x1 + i, _mm256_and_pd(_mm256_div_pd(_mm256_add_pd(menos_b, raiz), dois_a), ok));
+        guardar_avx2<NT>(x2 + i, _mm256_and_pd(_mm256_div_pd(_mm256_sub_pd(menos_b, raiz), dois_a), ok));
+
+        // classe = (delta >= 0) + (delta > 0), uma pista por bit
+        const int bits_ok = _mm256_movemask_pd(ok);
+        const int bits_gt = _mm256_movemask_pd(_mm256_cmp_pd(delta, zero, _CMP_GT_OQ));
+        for (int k = 0; k < 4; ++k) {
+            classe[i + k] = static_cast<std::uint8_t>(((bits_ok >> k) & 1) + ((bits_gt >> k) & 1));
+        }
+    }
+
+    // Sobra (n não múltiplo de 4): kernel portável
+    kernel_simd(a + i, b + i, c + i, x1 + i, x2 + i, classe + i, n - i);
+    if (NT) cerca_nt();
+}
+
+/*---------------------------------------------------
+ Kernel 2b: AVX2, modo ESTAVEL
+-----------------------------------------------------
+ _mm256_blendv_pd escolhe pela posição do bit de SINAL do terceiro
+ argumento; passando o próprio b, a seleção "b < 0 ?" sai de graça.
+*/
+template <bool NT>
+__attribute__((target("avx2,fma")))
+void kernel_avx2_estavel(const double* a, const double* b, const double* c,
+                         double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    if (NT && (!alinhado_linha(x1) || !alinhado_linha(x2))) {
+        kernel_avx2_estavel<false>(a, b, c, x1, x2, classe, n);
+        return;
+    }
+    const __m256d zero       = _mm256_setzero_pd();
+    const __m256d quatro     = _mm256_set1_pd(4.0);
+    const __m256d menos_meio = _mm256_set1_pd(-0.5);
+    const __m256d bit_sinal  = _mm256_set1_pd(-0.0);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        // Discriminante de Kahan com FMA
+        const __m256d quatro_a = _mm256_mul_pd(quatro, va);
+        const __m256d w        = _mm256_mul_pd(quatro_a, vc);
+        const __m256d e        = _mm256_fnmadd_pd(quatro_a, vc, w);   // w - 4a·c (exato)
+        const __m256d delta    = _mm256_add_pd(_mm256_fmsub_pd(vb, vb, w), e);
+
+        const __m256d ok   = _mm256_cmp_pd(delta, zero, _CMP_NLT_UQ);
+        const __m256d raiz = _mm256_sqrt_pd(_mm256_and_pd(delta, ok));
+
+        // sinal(b)·√Δ: copia o bit de sinal de b para √Δ (que é >= 0)
+        const __m256d raiz_sinal = _mm256_or_pd(raiz, _mm256_and_pd(vb, bit_sinal));
+        const __m256d q          = _mm256_mul_pd(menos_meio, _mm256_add_pd(vb, raiz_sinal));
+
+        const __m256d x_grande  = _mm256_div_pd(q, va);
+        const __m256d q_nao_0   = _mm256_cmp_pd(q, zero, _CMP_NEQ_UQ);
+        const __m256d x_pequena = _mm256_and_pd(_mm256_div_pd(vc, q), q_nao_0);
+
+        const __m256d r1 = _mm256_blendv_pd(x_pequena, x_grande, vb);   // b < 0 -> x_grande
+        const __m256d r2 = _mm256_blendv_pd(x_grande, x_pequena, vb);
+
+        guardar_avx2<NT>(x1 + i, _mm256_and_pd(r1, ok));
+        guardar_avx2<NT>(x2 + i, _mm256_and_pd(r2, ok));
+
+        // classe = (delta >= 0) + (delta > 0), uma pista por bit
+        const int bits_ok = _mm256_movemask_pd(ok);
+        const int bits_gt = _mm256_movemask_pd(_mm256_cmp_pd(delta, zero, _CMP_GT_OQ));
+        for (int k = 0; k < 4; ++k) {
+            classe[i + k] = static_cast<std::uint8_t>(((bits_ok >> k) & 1) + ((bits_gt >> k) & 1));
+        }
+    }
+
+    kernel_simd_estavel(a + i, b + i, c + i, x1 + i, x2 + i, classe + i, n - i);
+    if (NT) cerca_nt();
+}
+
+/*---------------------------------------------------
+ Kernel 3: AVX-512 (8 doubles por registrador)
+-----------------------------------------------------
+ O AVX-512 tem registradores de MÁSCARA (__mmask8): cada bit liga/desliga
+ uma pista. Com eles:
+   - a sobra do final do bloco é tratada com carga/escrita mascarada
+     (não precisa de laço extra);
+   - a raiz quadrada e a divisão são feitas SOMENTE nas pistas com
+     delta >= 0 (_mm512_maskz_sqrt_pd / _mm512_maskz_div_pd); as demais
+     pistas recebem 0 diretamente.
+*/
+// Pistas completas com NT: grava o registrador direto na memória (destino
+// alinhado a 64 bytes); a sobra mascarada usa escrita normal.
+template <bool NT>
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+inline void guardar_avx512(double* destino, __mmask8 carga, __m512d v) {
+    if (NT && carga == 0xFF) _mm512_stream_pd(destino, v);
+    else                     _mm512_mask_storeu_pd(destino, carga, v);
+}
+
+template <bool NT>
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+void kernel_avx512(const double* a, const double* b, const double* c,
+                   double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    if (NT && (!alinhado_linha(x1) || !alinhado_linha(x2))) {
+        kernel_avx512<false>(a, b, c, x1, x2, classe, n);
+        return;
+    }
+    const __m512d zero   = _mm512_setzero_pd();
+    const __m512d dois   = _mm512_set1_pd(2.0);
+    const __m512d quatro = _mm512_set1_pd(4.0);
+    const __m128i um     = _mm_set1_epi8(1);
+
+    for (std::size_t i = 0; i < n; i += 8) {
+        const std::size_t resto = n - i;
+        const __mmask8 carga = resto >= 8 ? static_cast<__mmask8>(0xFF)
+                                          : static_cast<__mmask8>((1u << resto) - 1);
+
+        const __m512d va = _mm512_maskz_loadu_pd(carga, a + i);
+        const __m512d vb = _mm512_maskz_loadu_pd(carga, b + i);
+        const __m512d vc = _mm512_maskz_loadu_pd(carga, c + i);
+
+        const __m512d delta = _mm512_sub_pd(_mm512_mul_pd(vb, vb),
+                                            _mm512_mul_pd(_mm512_mul_pd(quatro, va), vc));
+
+        const __mmask8 ok = _mm512_mask_cmp_pd_mask(carga, delta, zero, _CMP_NLT_UQ);
+
+        const __m512d raiz    = _mm512_maskz_sqrt_pd(ok, delta);
+        const __m512d dois_a  = _mm512_mul_pd(dois, va);
+        const __m512d menos_b = _mm512_sub_pd(zero, vb);
+
+        guardar_avx512<NT>(x1 + i, carga, _mm512_maskz_div_pd(ok, _mm512_add_pd(menos_b, raiz), dois_a));
+        guardar_avx512<NT>(x2 + i, carga, _mm512_maskz_div_pd(ok, _mm512_sub_pd(menos_b, raiz), dois_a));
+
+        // Converte as máscaras de bits em bytes (classe 0/1/2) e grava só as pistas válidas
+        const __mmask8 gt = _mm512_mask_cmp_pd_mask(carga, delta, zero, _CMP_GT_OQ);
+        _mm_mask_storeu_epi8(classe + i, carga,
+                             _mm_add_epi8(_mm_maskz_mov_epi8(ok, um), _mm_maskz_mov_epi8(gt, um)));
+    }
+    if (NT) cerca_nt();
+}
+/*---------------------------------------------------
+ Kernel 3b: AVX-512, modo ESTAVEL
+-----------------------------------------------------
+ As operações lógicas em double (and/or) do AVX-512 exigem a extensão DQ;
+ para depender só de F/BW/VL, o bit de sinal é manipulado como inteiro.
+*/
+template <bool NT>
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+void kernel_avx512_estavel(const double* a, const double* b, const double* c,
+                           double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    if (NT && (!alinhado_linha(x1) || !alinhado_linha(x2))) {
+        kernel_avx512_estavel<false>(a, b, c, x1, x2, classe, n);
+        return;
+    }
+    const __m512d zero       = _mm512_setzero_pd();
+    const __m512d quatro     = _mm512_set1_pd(4.0);
+    const __m512d menos_meio = _mm512_set1_pd(-0.5);
+    const __m512i bit_sinal  = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ULL));
+    const __m128i um         = _mm_set1_epi8(1);
+
+    for (std::size_t i = 0; i < n; i += 8) {
+        const std::size_t resto = n - i;
+        const __mmask8 carga = resto >= 8 ? static_cast<__mmask8>(0xFF)
+                                          : static_cast<__mmask8>((1u << resto) - 1);
+
+        const __m512d va = _mm512_maskz_loadu_pd(carga, a + i);
+        const __m512d vb = _mm512_maskz_loadu_pd(carga, b + i);
+        const __m512d vc = _mm512_maskz_loadu_pd(carga, c + i);
+
+        const __m512d quatro_a = _mm512_mul_pd(quatro, va);
+        const __m512d w        = _mm512_mul_pd(quatro_a, vc);
+        const __m512d e        = _mm512_fnmadd_pd(quatro_a, vc, w);
+        const __m512d delta    = _mm512_add_pd(_mm512_fmsub_pd(vb, vb, w), e);
+
+        const __mmask8 ok   = _mm512_mask_cmp_pd_mask(carga, delta, zero, _CMP_NLT_UQ);
+        const __m512d  raiz = _mm512_maskz_sqrt_pd(ok, delta);
+
+        const __m512i sinal_b    = _mm512_and_si512(_mm512_castpd_si512(vb), bit_sinal);
+        const __mmask8 b_negativo = _mm512_test_epi64_mask(_mm512_castpd_si512(vb), bit_sinal);
+        const __m512d raiz_sinal = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(raiz), sinal_b));
+        const __m512d q          = _mm512_mul_pd(menos_meio, _mm512_add_pd(vb, raiz_sinal));
+
+        const __mmask8 q_nao_0  = _mm512_mask_cmp_pd_mask(ok, q, zero, _CMP_NEQ_UQ);
+        const __m512d x_grande  = _mm512_maskz_div_pd(ok, q, va);
+        const __m512d x_pequena = _mm512_maskz_div_pd(q_nao_0, vc, q);
+
+        // mask_blend(k, x, y): pista com bit 1 em k recebe y
+        guardar_avx512<NT>(x1 + i, carga, _mm512_mask_blend_pd(b_negativo, x_pequena, x_grande));
+        guardar_avx512<NT>(x2 + i, carga, _mm512_mask_blend_pd(b_negativo, x_grande, x_pequena));
+
+        const __mmask8 gt = _mm512_mask_cmp_pd_mask(carga, delta, zero, _CMP_GT_OQ);
+        _mm_mask_storeu_epi8(classe + i, carga,
+                             _mm_add_epi8(_mm_maskz_mov_epi8(ok, um), _mm_maskz_mov_epi8(gt, um)));
+    }
+    if (NT) cerca_nt();
+}
+#endif // BHASKARA_X86
+
+/*---------------------------------------------------
+ Escolha do kernel em tempo de execução
+-----------------------------------------------------
+ __builtin_cpu_supports consulta a instrução CPUID.
+ O mesmo executável roda em máquinas antigas (kernel omp simd) e aproveita
+ AVX-512 nas máquinas que o possuem.
+ A variável de ambiente BHASKARA_KERNEL força um kernel (útil para comparar).
+*/
+enum class Modo { RAPIDO, ESTAVEL };
+
+struct KernelInfo {
+    const char*    nome;
+    KernelBhaskara funcao;
+    KernelBhaskara funcao_nt;   // mesmo kernel, x1/x2 com escrita não temporal (nullptr: não há)
+};
+
+KernelInfo escolher_kernel(Modo modo) {
+    const bool estavel = (modo == Modo::ESTAVEL);
+    const char* forcado = std::getenv("BHASKARA_KERNEL");
+    std::string pedido = forcado ? forcado : "";
+
+#ifdef BHASKARA_X86
+    __builtin_cpu_init();
+    const bool tem_avx512 = __builtin_cpu_supports("avx512f") &&
+                            __builtin_cpu_supports("avx512bw") &&
+                            __builtin_cpu_supports("avx512vl");
+    const bool tem_avx2   = __builtin_cpu_supports("avx2") &&
+                            __builtin_cpu_supports("fma");
+
+    if (pedido == "avx512" && !tem_avx512) std::cerr << "[aviso] CPU sem AVX-512, ignorando BHASKARA_KERNEL.\n";
+    if (pedido == "avx2"   && !tem_avx2)   std::cerr << "[aviso] CPU sem AVX2, ignorando BHASKARA_KERNEL.\n";
+
+    const KernelInfo avx512 = {"avx512", estavel ? kernel_avx512_estavel<false> : kernel_avx512<false>,
+                               estavel ? kernel_avx512_estavel<true>  : kernel_avx512<true>};
+    const KernelInfo avx2   = {"avx2",   estavel ? kernel_avx2_estavel<false>   : kernel_avx2<false>,
+                               estavel ? kernel_avx2_estavel<true>    : kernel_avx2<true>};
+
+    if (pedido != "simd") {
+        if (pedido == "avx2" && tem_avx2)   return avx2;
+        if (tem_avx512 && pedido != "avx2") return avx512;
+        if (tem_avx2)                       return avx2;
+    }
+#endif
+    // omp simd: o GCC ignora "nontemporal" (ver escrita_nt.hpp), então não há versão NT
+    return {"omp simd", estavel ? kernel_simd_estavel : kernel_simd, nullptr};
+}
+
+/*---------------------------------------------------
+ Motor de lote
+-----------------------------------------------------
+ Divide o lote em blocos de BLOCO equações. Cada thread recebe blocos
+ inteiros (schedule(static)) e chama o kernel SIMD sobre eles.
+ Blocos múltiplos de 8 mantêm os acessos alinhados às pistas do AVX-512.
+*/
+void resolver_lote(const double* a, const double* b, const double* c,
+                   double* x1, double* x2, std::uint8_t* classe,
+                   std::size_t n, KernelBhaskara kernel) {
+    const std::size_t  BLOCO   = 4096;
+    const std::int64_t nblocos = static_cast<std::int64_t>((n + BLOCO - 1) / BLOCO);
+
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t bl = 0; bl < nblocos; ++bl) {
+        const std::size_t i0  = static_cast<std::size_t>(bl) * BLOCO;
+        const std::size_t len = std::min(BLOCO, n - i0);
+        kernel(a + i0, b + i0, c + i0, x1 + i0, x2 + i0, classe + i0, len);
+    }
+}
+
+// Mesmo motor, lendo e escrevendo direto nas colunas do EquationBatch.
+void resolver_lote(EquationBatch& lote, KernelBhaskara kernel) {
+    resolver_lote(lote.a, lote.b, lote.c, lote.x1, lote.x2, lote.classe, lote.size(), kernel);
+}
+
+// a, b, c lidos + x1, x2, classe escritos
+constexpr std::size_t BYTES_POR_EQUACAO = 3 * sizeof(double) + 2 * sizeof(double) + 1;
+
+// Com política de escrita: devolve true se usou escrita não temporal
+bool resolver_lote(EquationBatch& lote, const KernelInfo& kernel, Escrita escrita) {
+    const bool nt = kernel.funcao_nt && usar_streaming(escrita, lote.size() * BYTES_POR_EQUACAO);
+    resolver_lote(lote, nt ? kernel.funcao_nt : kernel.funcao);
+    return nt;
+}
+
+/*---------------------------------------------------
+ Redução e auditoria sobre o lote
+-----------------------------------------------------
+ Ambas percorrem as colunas em sequência (parallel for simd), lendo só
+ o que precisam: a redução lê x1, x2 e classe; a auditoria lê tudo.
+*/
+struct ResumoLote {
+    double    soma_raizes = 0.0;
+    long long sem_raizes  = 0;
+    long long raiz_dupla  = 0;
+    long long duas_raizes = 0;
+};
+
+ResumoLote reduzir_lote(const EquationBatch& lote) {
+    const std::int64_t n = static_cast<std::int64_t>(lote.size());
+    const double* x1 = lote.x1;
+    const double* x2 = lote.x2;
+    const std::uint8_t* classe = lote.classe;
+
+    double soma = 0.0;
+    long long c0 = 0, c1 = 0, c2 = 0;
+    #pragma omp parallel for simd schedule(static) reduction(+:soma, c0, c1, c2)
+    for (std::int64_t i = 0; i < n; ++i) {
+        soma += x1[i] + x2[i];   // zero quando não há raízes reais
+        c0 += (classe[i] == 0);
+        c1 += (classe[i] == 1);
+        c2 += (classe[i] == 2);
+    }
+    return {soma, c0, c1, c2};
+}
+
+// Conta equações cujas raízes não satisfazem a·x² + b·x + c ≈ 0
+// (erro relativo ao maior termo da soma) ou cuja classe é inconsistente.
+long long auditar_lote(const EquationBatch& lote, double tolerancia) {
+    const std::int64_t n = static_cast<std::int64_t>(lote.size());
+    const double *a = lote.a, *b = lote.b, *c = lote.c, *x1 = lote.x1, *x2 = lote.x2;
+    const std::uint8_t* classe = lote.classe;
+
+    long long falhas = 0;
+    #pragma omp parallel for simd schedule(static) reduction(+:falhas)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const double r1 = (a[i] * x1[i] + b[i]) * x1[i] + c[i];
+        const double r2 = (a[i] * x2[i] + b[i]) * x2[i] + c[i];
+        const double escala1 = std::fabs(a[i] * x1[i] * x1[i]) + std::fabs(b[i] * x1[i]) + std::fabs(c[i]);
+        const double escala2 = std::fabs(a[i] * x2[i] * x2[i]) + std::fabs(b[i] * x2[i]) + std::fabs(c[i]);
+        const bool com_raizes = classe[i] != 0;
+        const bool raizes_ok  = !(std::fabs(r1) > tolerancia * escala1) && !(std::fabs(r2) > tolerancia * escala2);
+        const bool zeros_ok   = (x1[i] == 0.0) && (x2[i] == 0.0);
+        falhas += com_raizes ? !raizes_ok : !zeros_ok;
+    }
+    return falhas;
+}
+
+// Referência em long double (o que se fazia antes para fugir do cancelamento).
+// Usa a forma estável para que a própria referência não sofra cancelamento.
+std::pair<long double, long double> referencia_long_double(double a, double b, double c) {
+    const long double la = a, lb = b, lc = c;
+    const long double delta = lb * lb - 4 * la * lc;
+    if (delta < 0) return {0.0L, 0.0L};
+    const long double q = -0.5L * (lb + std::copysign(std::sqrt(delta), lb));
+    const long double grande = q / la, pequena = (q != 0) ? lc / q : 0.0L;
+    return (lb < 0) ? std::make_pair(grande, pequena) : std::make_pair(pequena, grande);
+}
+
+double erro_relativo(double x, long double ref) {
+    if (ref == 0) return std::fabs(x);
+    return static_cast<double>(std::fabs((x - ref) / ref));
+}
+
+int main(int argc, char* argv[]) {
+    // Número de equações (pode ser passado na linha de comando)
+    // Argumentos: [N] [rapido|estavel] [thp] [normal|nt], em qualquer ordem
+    std::size_t N = 10'000'000;
+    Modo modo = Modo::RAPIDO;
+    bool paginas_grandes = false;
+    Escrita escrita = Escrita::AUTOMATICA;
+    for (int k = 1; k < argc; ++k) {
+        const std::string arg = argv[k];
+        if (arg == "estavel")     modo = Modo::ESTAVEL;
+        else if (arg == "rapido") modo = Modo::RAPIDO;
+        else if (arg == "thp")    paginas_grandes = true;
+        else if (arg == "normal") escrita = Escrita::NORMAL;
+        else if (arg == "nt")     escrita = Escrita::STREAMING;
+        else {
+            // N: só dígitos e maior que zero; qualquer outra palavra é erro de digitação
+            char* fim = nullptr;
+            const unsigned long long v = std::strtoull(argv[k], &fim, 10);
+            if (arg.empty() || arg[0] < '0' || arg[0] > '9' || *fim != '\0' || v == 0) {
+                std::cerr << "Argumento invalido: " << arg << "\n"
+                          << "Uso: " << argv[0] << " [N > 0] [rapido|estavel] [thp] [normal|nt]\n";
+                return 1;
+            }
+            N = static_cast<std::size_t>(v);
+        }
+    }
+
+    EquationBatch lote(N, paginas_grandes);
+    double* a = lote.a;
+    double* b = lote.b;
+    double* c = lote.c;
+
+    // Mesmo conjunto do 006_sincronizacao_0.6: metade com raízes reais, metade sem.
+    // Inicialização paralela com o mesmo schedule(static) dos kernels:
+    // cada thread toca primeiro as páginas que ela mesma vai processar.
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(N); ++i) {
+        a[i] = 1.0;
+        if (i % 2 == 0) {
+            b[i] = -7.0;  // x^2 - 7x + 10 = 0 (raízes 5 e 2)
+            c[i] = 10.0;
+        } else {
+            b[i] = 2.0;   // x^2 + 2x + 5 = 0 (delta < 0)
+            c[i] = 5.0;
+        }
+        lote.x1[i] = lote.x2[i] = 0.0;
+        lote.classe[i] = 0;
+    }
+
+    // ---------------------------
+    // 1) Versão original: uma chamada por equação
+    // ---------------------------
+    std::vector<double> ref_x1(N), ref_x2(N);
+    long long com_raizes_ref = 0;
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel for schedule(static) reduction(+:com_raizes_ref)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(N); ++i) {
+        const double delta = (b[i] * b[i]) - (4 * a[i] * c[i]);
+        const auto raizes = resolver_bhaskara(a[i], b[i], c[i]);
+        ref_x1[i] = raizes.first;
+        ref_x2[i] = raizes.second;
+        if (!(delta < 0)) com_raizes_ref++;
+    }
+    double t_escalar = omp_get_wtime() - t0;
+
+    // ---------------------------
+    // 2) Motor de lote SIMD
+    // ---------------------------
+    const KernelInfo kernel = escolher_kernel(modo);
+
+    t0 = omp_get_wtime();
+    const bool usou_nt = resolver_lote(lote, kernel, escrita);
+    double t_lote = omp_get_wtime() - t0;
+
+    t0 = omp_get_wtime();
+    const ResumoLote resumo = reduzir_lote(lote);
+    const long long falhas_auditoria = auditar_lote(lote, 1e-12);
+    double t_pos = omp_get_wtime() - t0;
+
+    const double* x1 = lote.x1;
+    const double* x2 = lote.x2;
+    const std::uint8_t* classe = lote.classe;
+
+    // Conferência: no modo RAPIDO o lote reproduz exatamente a versão original.
+    // No modo ESTAVEL as raízes podem diferir no último bit (são MAIS precisas),
+    // então a comparação usa uma tolerância relativa.
+    long long com_raizes = 0, divergencias = 0;
+    const double tolerancia = (modo == Modo::RAPIDO) ? 0.0 : 1e-14;
+    #pragma omp parallel for schedule(static) reduction(+:com_raizes, divergencias)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(N); ++i) {
+        com_raizes += (classe[i] != 0);
+        if (std::fabs(x1[i] - ref_x1[i]) > tolerancia * std::fabs(ref_x1[i]) ||
+            std::fabs(x2[i] - ref_x2[i]) > tolerancia * std::fabs(ref_x2[i])) divergencias++;
+    }
+
+    std::cout << "Bhaskara em lote\n";
+    std::cout << "Equacoes           : " << N << "\n";
+    std::cout << "Threads            : " << omp_get_max_threads() << "\n";
+    std::cout << "Modo               : " << (modo == Modo::RAPIDO ? "rapido" : "estavel") << "\n";
+    std::cout << "Kernel escolhido   : " << kernel.nome << "\n";
+    std::cout << "Escrita de x1/x2   : " << (usou_nt ? "streaming" : "normal")
+              << " (" << nome_escrita(escrita) << ")\n";
+    std::cout << "Memoria do lote    : " << lote.bytes() / (1u << 20) << " MB"
+              << (lote.usa_paginas_grandes() ? " (paginas grandes)" : "") << "\n";
+    std::cout << "Com raizes reais   : " << com_raizes << " (referencia: " << com_raizes_ref << ")\n";
+    std::cout << "Sem raizes reais   : " << static_cast<long long>(N) - com_raizes << "\n";
+    std::cout << "Divergencias       : " << divergencias << "\n";
+    std::cout << "Classes (0/1/2)    : " << resumo.sem_raizes << " / " << resumo.raiz_dupla
+              << " / " << resumo.duas_raizes << "\n";
+    std::cout << "Soma das raizes    : " << resumo.soma_raizes << "\n";
+    std::cout << "Falhas na auditoria: " << falhas_auditoria << "\n";
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Tempo por equacao (s): " << t_escalar << "\n";
+    std::cout << "Tempo em lote     (s): " << t_lote << "\n";
+    if (t_lote > 0) std::cout << "Ganho              : " << t_escalar / t_lote << "x\n";
+    std::cout << "Reducao+auditoria (s): " << t_pos << "\n";
+
+    // ---------------------------
+    // 3) Precisão: equações com b² >> 4ac
+    //    x² - 10^k x + 1 = 0  -> raízes ~10^k e ~10^-k
+    // ---------------------------
+    const int K = 9;
+    std::vector<double> pa(K, 1.0), pb(K), pc(K, 1.0);
+    for (int k = 0; k < K; ++k) pb[k] = -std::pow(10.0, k);
+    pb[0] = -3.0;   // k = 0 seria delta < 0; usa x² - 3x + 1 = 0
+
+    std::vector<double> r_x1(K), r_x2(K), e_x1(K), e_x2(K);
+    std::vector<std::uint8_t> r_ok(K), e_ok(K);
+    resolver_lote(pa.data(), pb.data(), pc.data(), r_x1.data(), r_x2.data(), r_ok.data(), K,
+                  escolher_kernel(Modo::RAPIDO).funcao);
+    resolver_lote(pa.data(), pb.data(), pc.data(), e_x1.data(), e_x2.data(), e_ok.data(), K,
+                  escolher_kernel(Modo::ESTAVEL).funcao);
+
+    std::cout << "\nPrecisao da raiz pequena (x2) em x^2 + b x + 1 = 0\n";
+    std::cout << "----------------------------------------------------------\n";
+    std::cout << "           b |  erro rel. RAPIDO |  erro rel. ESTAVEL\n";
+    std::cout << "----------------------------------------------------------\n";
+    std::cout << std::scientific << std::setprecision(2);
+    double pior_estavel = 0.0;
+    for (int k = 0; k < K; ++k) {
+        const auto ref = referencia_long_double(pa[k], pb[k], pc[k]);
+        const double er = erro_relativo(r_x2[k], ref.second);
+        const double ee = erro_relativo(e_x2[k], ref.second);
+        pior_estavel = std::max({pior_estavel, ee, erro_relativo(e_x1[k], ref.first)});
+        std::cout << std::setw(12) << pb[k] << " | " << std::setw(17) << er << " | " << std::setw(18) << ee << "\n";
+    }
+    std::cout << "----------------------------------------------------------\n";
+
+    // ---------------------------
+    // 4) Escrita normal x streaming de x1/x2 (mesmo kernel, mesmo lote)
+    //    Banda na contagem STREAM: 41 bytes por equação
+    // ---------------------------
+    double melhor[2] = {1e30, 1e30};
+    bool mesmo_resultado = true;
+    for (int r = 0; r < 3; ++r) {
+        for (int nt = 0; nt < 2; ++nt) {
+            t0 = omp_get_wtime();
+            resolver_lote(lote, kernel, nt ? Escrita::STREAMING : Escrita::NORMAL);
+            melhor[nt] = std::min(melhor[nt], omp_get_wtime() - t0);
+            const ResumoLote outro = reduzir_lote(lote);
+            mesmo_resultado = mesmo_resultado && outro.soma_raizes == resumo.soma_raizes &&
+                              outro.duas_raizes == resumo.duas_raizes && outro.sem_raizes == resumo.sem_raizes;
+        }
+    }
+    const double gb = static_cast<double>(N) * BYTES_POR_EQUACAO * 1e-9;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nEscrita de x1/x2 (" << lote.bytes() / (1u << 20) << " MB de lote, ultima cache "
+              << tamanho_ultima_cache() / (1u << 20) << " MB)\n";
+    std::cout << "  normal   : " << std::setprecision(4) << melhor[0] << " s  " << std::setprecision(2)
+              << gb / melhor[0] << " GB/s\n";
+    if (kernel.funcao_nt) {
+        std::cout << "  streaming: " << std::setprecision(4) << melhor[1] << " s  " << std::setprecision(2)
+                  << gb / melhor[1] << " GB/s  (" << melhor[0] / melhor[1] << "x)"
+                  << (mesmo_resultado ? "" : "  [FALHA: resultado diferente]") << "\n";
+    } else {
+        std::cout << "  streaming: indisponivel no kernel " << kernel.nome << " (usa escrita normal)\n";
+    }
+
+    const bool precisao_ok = pior_estavel < 1e-15;
+    return (divergencias == 0 && com_raizes == com_raizes_ref && falhas_auditoria == 0 && precisao_ok &&
+            mesmo_resultado) ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. O kernel escolhido aparece na saída. Em CPUs com AVX-512 será "avx512";
+   use BHASKARA_KERNEL para comparar os três kernels na mesma máquina.
+
+2. Divergencias deve ser 0: no modo rapido o lote faz exatamente as mesmas
+   operações de ponto flutuante que resolver_bhaskara, só que várias pistas
+   por vez; no modo estavel a diferença fica abaixo de 1e-14 (relativo).
+
+3. Na tabela de precisão, o erro do modo RAPIDO cresce com |b| até perder
+   todos os dígitos (b = -1e8 já erra ~25%), enquanto o modo ESTAVEL fica no
+   nível do arredondamento do double (~1e-16) — sem precisar de long double.
+   O tempo em lote dos dois modos é praticamente o mesmo: a forma estável
+   troca uma divisão por outra e acrescenta duas FMAs, e o laço continua
+   limitado pela memória.
+
+4. Para N grande o tempo passa a ser limitado pela MEMÓRIA (cada equação lê
+   24 bytes e escreve 17), não pelo cálculo. O EquationBatch ataca esse
+   limite com colunas alinhadas e, com "thp", páginas de 2 MB; para conferir
+   se o Linux realmente usou páginas grandes:
+     grep AnonHugePages /proc/meminfo   (durante a execução)
+
+5. A seção "Escrita de x1/x2" compara as duas escritas no mesmo lote. Na
+   memória, cada equação move 58 bytes com escrita normal (41 + 16 lidos
+   pelo write-allocate de x1/x2 + 1 da classe) e 42 com streaming: quando
+   as threads saturam a memória o ganho esperado fica perto de 58/42 ≈ 1.35x.
+   Com poucos núcleos o kernel AVX-512 fica mais perto do limite da CONTA
+   que do da memória, e o ganho é menor. Os kernels AVX2/AVX-512 gravam o
+   registrador do resultado direto com _mm256_stream_pd/_mm512_stream_pd,
+   sem cópia intermediária; o kernel omp simd não tem versão streaming.
+   Para lotes pequenos (que cabem na cache) o streaming PERDE: a escrita
+   normal deixa x1/x2 na cache para reduzir_lote. Por isso a política
+   automática só liga o streaming acima do tamanho da última cache.
+*/
@@ -0,0 +1,588 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 009_bhaskara_lote_0.1.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Columnar binary coefficient file read through mmap, solved in place with madvise prefetch per chunk
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Coeficientes em ARQUIVO, lidos com mmap
+-----------------------------------------------------
+ O exercício 2 do 006_sincronizacao_0.6 pede que o usuário escolha quantas
+ equações resolver, mas os dados sempre são GERADOS dentro do programa.
+ Na prática, bilhões de coeficientes vêm do disco.
+
+ Ler um arquivo texto ("1.0 -7.0 10.0\n" por linha) custa caro:
+   - converter texto em double (parse) é mais lento que o próprio Bhaskara;
+   - os valores são copiados do arquivo para um buffer e depois para std::vector.
+
+ Este script define um formato BINÁRIO em COLUNAS:
+
+   +-------------------------------+  deslocamento 0
+   | Cabeçalho (CabecalhoArquivo)  |  mágica, versão, N, e para cada coluna:
+   |                               |  nome, deslocamento, tamanho, checksum
+   +-------------------------------+  múltiplo de 4096 (uma página)
+   | coluna a : N doubles          |
+   +-------------------------------+  múltiplo de 4096
+   | coluna b : N doubles          |
+   +-------------------------------+  múltiplo de 4096
+   | coluna c : N doubles          |
+   +-------------------------------+
+
+ e o lê com mmap: o arquivo é "mapeado" no espaço de endereços do processo.
+ Um ponteiro double* aponta DIRETO para as páginas do cache de arquivos
+ do sistema operacional (page cache): não há parse e não há cópia.
+ O #pragma omp parallel for lê a[i], b[i], c[i] como se fossem vetores comuns.
+
+ Leitura em BLOCOS (chunks) com política de pré-busca (madvise):
+   - nenhuma   : o SO decide sozinho;
+   - sequencial: MADV_SEQUENTIAL no arquivo todo (leitura antecipada agressiva,
+                 páginas já lidas podem ser descartadas cedo);
+   - willneed  : sequencial + MADV_WILLNEED no PRÓXIMO bloco antes de
+                 processar o atual: o disco trabalha enquanto as threads calculam.
+
+ Integridade: cada coluna tem um checksum calculado em blocos de 1 MB.
+ O hash de cada bloco é calculado na mesma passada que resolve as
+ equações (pedaço a pedaço, com os dados ainda no cache), então o arquivo
+ é lido uma única vez. O checksum da coluna é a soma dos hashes de todos
+ os blocos: a comparação com o cabeçalho só pode ser feita no FIM, depois
+ que todos os resultados foram calculados.
+
+ Somente Linux/WSL/macOS (mmap e madvise são POSIX).
+
+ Compilar:
+   g++ -O3 -fopenmp -fno-math-errno 009_bhaskara_lote_0.1.cpp -o 009_bhaskara_lote_0.1
+
+ Executar:
+   ./009_bhaskara_lote_0.1 gerar    dados.bin 100000000         (gera 100 milhões de equações, ~2.4 GB)
+   ./009_bhaskara_lote_0.1 resolver dados.bin willneed estavel
+*/
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <omp.h>
+
+#include <fcntl.h>      // open
+#include <unistd.h>     // pwrite, close
+#include <sys/mman.h>   // mmap, madvise
+#include <sys/stat.h>   // fstat
+
+/*---------------------------------------------------
+ Formato do arquivo
+-----------------------------------------------------
+ Todos os campos são little-endian (x86/ARM). O cabeçalho ocupa a primeira
+ página; cada coluna começa em um deslocamento múltiplo de 4096, para que o
+ ponteiro mapeado fique alinhado e o madvise possa agir coluna a coluna.
+*/
+constexpr char          MAGICA[8]       = {'B', 'H', 'A', 'S', 'K', 'A', 'R', 'A'};
+constexpr std::uint32_t VERSAO          = 1;
+constexpr std::uint32_t NUM_COLUNAS     = 3;
+constexpr std::size_t   PAGINA          = 4096;
+constexpr std::size_t   BLOCO_CHECKSUM  = 1u << 20;                           // 1 MB
+constexpr std::size_t   DOUBLES_POR_BLOCO = BLOCO_CHECKSUM / sizeof(double);
+
+struct DescritorColuna {
+    char          nome[8];
+    std::uint64_t deslocamento;   // em bytes, desde o início do arquivo
+    std::uint64_t bytes;          // n * sizeof(double)
+    std::uint64_t checksum;
+};
+
+struct CabecalhoArquivo {
+    char            magica[8];
+    std::uint32_t   versao;
+    std::uint32_t   num_colunas;
+    std::uint64_t   n;            // número de equações
+    DescritorColuna colunas[NUM_COLUNAS];
+};
+
+static_assert(sizeof(CabecalhoArquivo) <= PAGINA, "cabecalho deve caber em uma pagina");
+
+std::uint64_t arredondar_pagina(std::uint64_t x) { return (x + PAGINA - 1) / PAGINA * PAGINA; }
+
+/*---------------------------------------------------
+ Checksum por blocos
+-----------------------------------------------------
+ Cada bloco de 1 MB recebe um hash (FNV-1a sobre palavras de 64 bits,
+ misturado com o índice do bloco). O checksum da coluna é a SOMA dos hashes
+ dos blocos: a soma não depende da ordem, então os blocos podem ser
+ processados por threads diferentes com reduction(+:...), e o índice no hash
+ ainda detecta blocos trocados de lugar.
+*/
+std::uint64_t misturar(std::uint64_t x) {            // finalizador do splitmix64
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// O hash de um bloco pode ser calculado em pedaços: inicio, atualizar..., fim
+std::uint64_t hash_inicio(std::uint64_t indice_bloco) { return 0xcbf29ce484222325ULL ^ misturar(indice_bloco + 1); }
+
+std::uint64_t hash_atualizar(std::uint64_t h, const double* dados, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, dados + i, sizeof(w));
+        h = (h ^ w) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::uint64_t hash_fim(std::uint64_t h) { return misturar(h); }
+
+std::uint64_t hash_bloco(const double* dados, std::size_t n, std::uint64_t indice_bloco) {
+    return hash_fim(hash_atualizar(hash_inicio(indice_bloco), dados, n));
+}
+
+// Soma dos hashes de um trecho de coluna com len valores que começa no bloco bloco0.
+std::uint64_t checksum_trecho(const double* trecho, std::size_t len, std::size_t bloco0) {
+    const std::int64_t nblocos = static_cast<std::int64_t>((len + DOUBLES_POR_BLOCO - 1) / DOUBLES_POR_BLOCO);
+    std::uint64_t soma = 0;
+    #pragma omp parallel for schedule(static) reduction(+:soma)
+    for (std::int64_t k = 0; k < nblocos; ++k) {
+        const std::size_t j0  = static_cast<std::size_t>(k) * DOUBLES_POR_BLOCO;
+        const std::size_t tam = std::min(DOUBLES_POR_BLOCO, len - j0);
+        soma += hash_bloco(trecho + j0, tam, bloco0 + static_cast<std::size_t>(k));
+    }
+    return soma;
+}
+
+/*---------------------------------------------------
+ Kernels (os mesmos do 009_bhaskara_lote_0.0, versão omp simd)
+-----------------------------------------------------
+ Para os kernels AVX2/AVX-512 e a escolha em tempo de execução,
+ ver 009_bhaskara_lote_0.0.cpp.
+*/
+void kernel_simd(const double* a, const double* b, const double* c,
+                 double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        const double delta = (b[i] * b[i]) - (4 * a[i] * c[i]);
+        const bool   ok    = !(delta < 0);
+        const double raiz  = std::sqrt(ok ? delta : 0.0);
+        const double dois_a = 2 * a[i];
+
+        x1[i] = ok ? (-b[i] + raiz) / dois_a : 0.0;
+        x2[i] = ok ? (-b[i] - raiz) / dois_a : 0.0;
+        classe[i] = ok + (delta > 0);
+    }
+}
+
+void kernel_simd_estavel(const double* a, const double* b, const double* c,
+                         double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        const double quatro_a = 4 * a[i];
+        const double w     = quatro_a * c[i];
+        const double e     = std::fma(-quatro_a, c[i], w);
+        const double delta = std::fma(b[i], b[i], -w) + e;
+
+        const bool   ok   = !(delta < 0);
+        const double raiz = std::sqrt(ok ? delta : 0.0);
+
+        const double q         = -0.5 * (b[i] + std::copysign(raiz, b[i]));
+        const double x_grande  = q / a[i];
+        const double x_pequena = (q != 0) ? c[i] / q : 0.0;
+
+        const bool b_negativo = std::signbit(b[i]);
+        x1[i] = ok ? (b_negativo ? x_grande : x_pequena) : 0.0;
+        x2[i] = ok ? (b_negativo ? x_pequena : x_grande) : 0.0;
+        classe[i] = ok + (delta > 0);
+    }
+}
+
+using KernelBhaskara = void (*)(const double*, const double*, const double*,
+                                double*, double*, std::uint8_t*, std::size_t);
+
+/*---------------------------------------------------
+ Gravação do arquivo
+-----------------------------------------------------
+ Gera os coeficientes em blocos (mesmo padrão do 006_sincronizacao_0.6:
+ metade das equações com raízes reais) e grava cada bloco direto no
+ deslocamento da sua coluna com pwrite. O cabeçalho é gravado por último,
+ quando os checksums já são conhecidos.
+*/
+bool gravar_arquivo(const std::string& caminho, std::uint64_t n) {
+    const int fd = open(caminho.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0) { std::perror("open"); return false; }
+
+    CabecalhoArquivo cab{};
+    std::memcpy(cab.magica, MAGICA, sizeof(MAGICA));
+    cab.versao      = VERSAO;
+    cab.num_colunas = NUM_COLUNAS;
+    cab.n           = n;
+
+    const char* nomes[NUM_COLUNAS] = {"a", "b", "c"};
+    std::uint64_t deslocamento = PAGINA;
+    for (std::uint32_t k = 0; k < NUM_COLUNAS; ++k) {
+        std::strncpy(cab.colunas[k].nome, nomes[k], sizeof(cab.colunas[k].nome));
+        cab.colunas[k].deslocamento = deslocamento;
+        cab.colunas[k].bytes        = n * sizeof(double);
+        deslocamento = arredondar_pagina(deslocamento + cab.colunas[k].bytes);
+    }
+
+    // Blocos de gravação múltiplos do bloco de checksum
+    const std::size_t CHUNK = 16 * DOUBLES_POR_BLOCO;
+    std::vector<double> col[NUM_COLUNAS] = {std::vector<double>(CHUNK), std::vector<double>(CHUNK),
+                                            std::vector<double>(CHUNK)};
+
+    for (std::uint64_t i0 = 0; i0 < n; i0 += CHUNK) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(CHUNK, n - i0));
+
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t j = 0; j < static_cast<std::int64_t>(len); ++j) {
+            const std::uint64_t i = i0 + static_cast<std::uint64_t>(j);
+            col[0][j] = 1.0;
+            col[1][j] = (i % 2 == 0) ? -7.0 : 2.0;   // x² - 7x + 10 (raízes 5 e 2) / x² + 2x + 5 (delta < 0)
+            col[2][j] = (i % 2 == 0) ? 10.0 : 5.0;
+        }
+
+        for (std::uint32_t k = 0; k < NUM_COLUNAS; ++k) {
+            cab.colunas[k].checksum += checksum_trecho(col[k].data(), len,
+                                                       static_cast<std::size_t>(i0 / DOUBLES_POR_BLOCO));
+
+            const char* p = reinterpret_cast<const char*>(col[k].data());
+            std::size_t restante = len * sizeof(double);
+            off_t pos = static_cast<off_t>(cab.colunas[k].deslocamento + i0 * sizeof(double));
+            while (restante > 0) {
+                const ssize_t w = pwrite(fd, p, restante, pos);
+                if (w <= 0) { std::perror("pwrite"); close(fd); return false; }
+                p += w; pos += w; restante -= static_cast<std::size_t>(w);
+            }
+        }
+    }
+
+    // Garante o tamanho final (última coluna arredondada para a página)
+    if (ftruncate(fd, static_cast<off_t>(deslocamento)) != 0 ||
+        pwrite(fd, &cab, sizeof(cab), 0) != static_cast<ssize_t>(sizeof(cab))) {
+        std::perror("cabecalho");
+        close(fd);
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+/*---------------------------------------------------
+ Arquivo mapeado
+-----------------------------------------------------
+ Abre, mapeia e valida o cabeçalho. Os ponteiros coluna(k) apontam para
+ dentro do mapeamento: nada é copiado. O destrutor desfaz o mapeamento.
+*/
+class ArquivoMapeado {
+public:
+    explicit ArquivoMapeado(const std::string& caminho) {
+        fd_ = open(caminho.c_str(), O_RDONLY);
+        if (fd_ < 0) { erro_ = "nao foi possivel abrir o arquivo"; return; }
+
+        struct stat st{};
+        if (fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < PAGINA) {
+            erro_ = "arquivo menor que o cabecalho";
+            return;
+        }
+        tamanho_ = static_cast<std::size_t>(st.st_size);
+
+        void* p = mmap(nullptr, tamanho_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) { erro_ = "mmap falhou"; return; }
+        base_ = static_cast<const char*>(p);
+
+        std::memcpy(&cab_, base_, sizeof(cab_));
+        if (std::memcmp(cab_.magica, MAGICA, sizeof(MAGICA)) != 0) { erro_ = "magica invalida"; return; }
+        if (cab_.versao != VERSAO)                                  { erro_ = "versao nao suportada"; return; }
+        if (cab_.num_colunas != NUM_COLUNAS)                        { erro_ = "numero de colunas invalido"; return; }
+        // Um cabeçalho adulterado não pode estourar as contas abaixo: n é limitado
+        // antes de multiplicar e o intervalo é testado sem somar
+        if (cab_.n > (tamanho_ - PAGINA) / sizeof(double))          { erro_ = "n maior que o arquivo"; return; }
+        for (const auto& col : cab_.colunas) {
+            if (col.deslocamento % PAGINA != 0 ||
+                col.bytes != cab_.n * sizeof(double) ||
+                col.deslocamento > tamanho_ ||
+                col.bytes > tamanho_ - col.deslocamento) {
+                erro_ = "descritor de coluna invalido";
+                return;
+            }
+        }
+    }
+
+    ~ArquivoMapeado() {
+        if (base_) munmap(const_cast<char*>(base_), tamanho_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+    bool ok() const { return erro_.empty(); }
+    const std::string& erro() const { return erro_; }
+    std::uint64_t n() const { return cab_.n; }
+    const DescritorColuna& descritor(int k) const { return cab_.colunas[k]; }
+
+    const double* coluna(int k) const {
+        return reinterpret_cast<const double*>(base_ + cab_.colunas[k].deslocamento);
+    }
+
+    // Aplica um conselho do madvise ao trecho [i0, i0 + len) de todas as colunas.
+    // madvise exige endereço alinhado à página: o início é arredondado para baixo.
+    void aconselhar(std::uint64_t i0, std::uint64_t len, int conselho) const {
+        for (std::uint32_t k = 0; k < NUM_COLUNAS; ++k) {
+            const std::uint64_t ini = cab_.colunas[k].deslocamento + i0 * sizeof(double);
+            const std::uint64_t fim = ini + len * sizeof(double);
+            const std::uint64_t ini_pag = ini / PAGINA * PAGINA;
+            madvise(const_cast<char*>(base_) + ini_pag, fim - ini_pag, conselho);
+        }
+    }
+
+    void aconselhar_tudo(int conselho) const {
+        madvise(const_cast<char*>(base_), tamanho_, conselho);
+    }
+
+private:
+    int fd_ = -1;
+    const char* base_ = nullptr;
+    std::size_t tamanho_ = 0;
+    CabecalhoArquivo cab_{};
+    std::string erro_;
+};
+
+enum class Politica { NENHUMA, SEQUENCIAL, WILLNEED };
+
+/*---------------------------------------------------
+ Resolução direto do mapeamento
+-----------------------------------------------------
+ Percorre o arquivo em blocos de CHUNK equações. Para cada bloco:
+   1. (willneed) pede ao SO que já comece a ler o PRÓXIMO bloco;
+   2. confere o checksum dos blocos de 1 MB deste trecho;
+   3. resolve as equações lendo a, b, c direto das páginas mapeadas;
+   4. reduz os resultados (soma das raízes e contagem por classe).
+ Só os resultados de UM bloco ficam em memória (buffers reutilizados).
+*/
+struct ResultadoArquivo {
+    double    soma_raizes = 0.0;
+    long long classes[3]  = {0, 0, 0};
+    bool      checksum_ok = true;
+};
+
+ResultadoArquivo resolver_arquivo(const ArquivoMapeado& arq, KernelBhaskara kernel, Politica politica) {
+    const std::uint64_t n     = arq.n();
+    const std::size_t   CHUNK = 32 * DOUBLES_POR_BLOCO;   // 4 M equações (32 MB por coluna)
+    const std::size_t   BLOCO = 4096;                      // divisão entre threads
+
+    const double* a = arq.coluna(0);
+    const double* b = arq.coluna(1);
+    const double* c = arq.coluna(2);
+
+    std::vector<double> x1(CHUNK), x2(CHUNK);
+    std::vector<std::uint8_t> classe(CHUNK);
+
+    if (politica != Politica::NENHUMA) arq.aconselhar_tudo(MADV_SEQUENTIAL);
+    if (politica == Politica::WILLNEED) arq.aconselhar(0, std::min<std::uint64_t>(CHUNK, n), MADV_WILLNEED);
+
+    ResultadoArquivo r;
+    std::uint64_t checksum[NUM_COLUNAS] = {0, 0, 0};
+
+    for (std::uint64_t i0 = 0; i0 < n; i0 += CHUNK) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(CHUNK, n - i0));
+
+        // 1) pré-busca do próximo bloco
+        if (politica == Politica::WILLNEED && i0 + len < n) {
+            arq.aconselhar(i0 + len, std::min<std::uint64_t>(CHUNK, n - i0 - len), MADV_WILLNEED);
+        }
+
+        // 2) integridade + resolução na MESMA passada: cada thread recebe blocos
+        //    de checksum (1 MB) inteiros e, a cada pedaço de BLOCO equações,
+        //    atualiza o hash das três colunas e chama o kernel enquanto o pedaço
+        //    ainda está no cache L1. a + i0, b + i0, c + i0 apontam para o page cache.
+        const std::int64_t nblocos = static_cast<std::int64_t>((len + DOUBLES_POR_BLOCO - 1) / DOUBLES_POR_BLOCO);
+        std::uint64_t ca = 0, cb = 0, cc = 0;
+        #pragma omp parallel for schedule(static) reduction(+:ca, cb, cc)
+        for (std::int64_t k = 0; k < nblocos; ++k) {
+            const std::size_t   inicio = static_cast<std::size_t>(k) * DOUBLES_POR_BLOCO;
+            const std::size_t   fim    = std::min(len, inicio + DOUBLES_POR_BLOCO);
+            const std::uint64_t indice = i0 / DOUBLES_POR_BLOCO + static_cast<std::uint64_t>(k);
+            std::uint64_t ha = hash_inicio(indice), hb = ha, hc = ha;
+            for (std::size_t j0 = inicio; j0 < fim; j0 += BLOCO) {
+                const std::size_t m = std::min(BLOCO, fim - j0);
+                ha = hash_atualizar(ha, a + i0 + j0, m);
+                hb = hash_atualizar(hb, b + i0 + j0, m);
+                hc = hash_atualizar(hc, c + i0 + j0, m);
+                kernel(a + i0 + j0, b + i0 + j0, c + i0 + j0, x1.data() + j0, x2.data() + j0, classe.data() + j0, m);
+            }
+            ca += hash_fim(ha);
+            cb += hash_fim(hb);
+            cc += hash_fim(hc);
+        }
+        checksum[0] += ca;
+        checksum[1] += cb;
+        checksum[2] += cc;
+
+        // 3) redução do bloco
+        double soma = 0.0;
+        long long c0 = 0, c1 = 0, c2 = 0;
+        #pragma omp parallel for simd schedule(static) reduction(+:soma, c0, c1, c2)
+        for (std::int64_t j = 0; j < static_cast<std::int64_t>(len); ++j) {
+            soma += x1[j] + x2[j];
+            c0 += (classe[j] == 0);
+            c1 += (classe[j] == 1);
+            c2 += (classe[j] == 2);
+        }
+        r.soma_raizes += soma;
+        r.classes[0] += c0;
+        r.classes[1] += c1;
+        r.classes[2] += c2;
+    }
+
+    for (int k = 0; k < static_cast<int>(NUM_COLUNAS); ++k) {
+        if (checksum[k] != arq.descritor(k).checksum) r.checksum_ok = false;
+    }
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Uso:\n"
+                  << "  " << argv[0] << " gerar    <arquivo> [N]\n"
+                  << "  " << argv[0] << " resolver <arquivo> [nenhuma|sequencial|willneed] [rapido|estavel]\n";
+        return 1;
+    }
+
+    const std::string comando = argv[1];
+    const std::string caminho = argv[2];
+
+    if (comando == "gerar") {
+        // Exercício 2: a quantidade de equações vem do usuário
+        std::uint64_t n = 0;
+        if (argc > 3) {
+            n = std::strtoull(argv[3], nullptr, 10);
+        } else {
+            std::cout << "Quantas equacoes deseja gerar? ";
+            std::cin >> n;
+        }
+
+        double t0 = omp_get_wtime();
+        if (!gravar_arquivo(caminho, n)) return 1;
+        std::cout << "Arquivo " << caminho << " gravado com " << n << " equacoes em "
+                  << omp_get_wtime() - t0 << " s\n";
+        return 0;
+    }
+
+    if (comando != "resolver") {
+        std::cerr << "Comando desconhecido: " << comando << "\n";
+        return 1;
+    }
+
+    Politica politica = Politica::WILLNEED;
+    KernelBhaskara kernel = kernel_simd;
+    for (int k = 3; k < argc; ++k) {
+        const std::string arg = argv[k];
+        if (arg == "nenhuma")         politica = Politica::NENHUMA;
+        else if (arg == "sequencial") politica = Politica::SEQUENCIAL;
+        else if (arg == "willneed")   politica = Politica::WILLNEED;
+        else if (arg == "estavel")    kernel = kernel_simd_estavel;
+        else if (arg == "rapido")     kernel = kernel_simd;
+        else {
+            std::cerr << "Argumento invalido: " << arg << "\n"
+                      << "Uso: " << argv[0] << " resolver <arquivo> [nenhuma|sequencial|willneed] [rapido|estavel]\n";
+            return 1;
+        }
+    }
+
+    ArquivoMapeado arq(caminho);
+    if (!arq.ok()) {
+        std::cerr << "Erro ao abrir " << caminho << ": " << arq.erro() << "\n";
+        return 1;
+    }
+
+    double t0 = omp_get_wtime();
+    const ResultadoArquivo r = resolver_arquivo(arq, kernel, politica);
+    double t = omp_get_wtime() - t0;
+
+    const double gb = 3.0 * static_cast<double>(arq.n()) * sizeof(double) / 1e9;
+    std::cout << "Equacoes           : " << arq.n() << "\n";
+    std::cout << "Threads            : " << omp_get_max_threads() << "\n";
+    std::cout << "Com raizes reais   : " << r.classes[1] + r.classes[2] << "\n";
+    std::cout << "Sem raizes reais   : " << r.classes[0] << "\n";
+    std::cout << "Soma das raizes    : " << r.soma_raizes << "\n";
+    std::cout << "Checksums          : " << (r.checksum_ok ? "OK" : "INVALIDOS") << "\n";
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Tempo (s)          : " << t << "\n";
+    if (t > 0) std::cout << "Leitura (GB/s)     : " << gb / t << "\n";
+
+    return r.checksum_ok ? 0 : 2;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Na primeira execução após gerar o arquivo, os dados provavelmente ainda
+   estão no page cache (foram acabados de gravar). Para medir a leitura do
+   DISCO, limpe o cache antes (Linux, como root):
+       sync; echo 3 > /proc/sys/vm/drop_caches
+   e compare as políticas nenhuma / sequencial / willneed.
+
+2. Com willneed, o SO lê o próximo bloco enquanto as threads resolvem o atual.
+   O tempo total tende ao MAIOR entre "tempo de disco" e "tempo de cálculo",
+   e não à soma dos dois.
+
+3. Se um único byte do arquivo for alterado, a linha Checksums mostra
+   INVALIDOS e o programa retorna 2.
+
+4. A memória usada pelo programa é só a dos buffers de resultado de um bloco
+   (~68 MB); as páginas do arquivo pertencem ao page cache e o SO pode
+   descartá-las quando precisar.
+*/
@@ -0,0 +1,562 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 010_pipeline_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Streaming read -> compute -> write pipeline with multiple buffering for datasets larger than RAM
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Pipeline em fluxo (streaming) para dados maiores que a RAM
+-----------------------------------------------------
+ Os programas de Bhaskara (006/009) e a estatística de salários
+ (007_reduction_0.1) supõem que TODOS os dados cabem em um std::vector.
+ Um arquivo de salários de 100 GB não cabe em uma máquina de 16 GB.
+
+ A solução é processar o arquivo em BLOCOS (chunks) de tamanho fixo,
+ passando cada bloco por três ESTÁGIOS:
+
+        [ leitura ]  --->  [ cálculo ]  --->  [ escrita ]
+        std::thread        thread principal    std::thread
+        (pread)            #pragma omp         (pwrite)
+                           parallel for
+
+ Cada estágio trabalha em um bloco DIFERENTE ao mesmo tempo:
+
+   tempo -->   |  t0   |  t1   |  t2   |  t3   |
+   leitura     |  B0   |  B1   |  B2   |  B3   |
+   cálculo     |       |  B0   |  B1   |  B2   |
+   escrita     |       |       |  B0   |  B1   |
+
+ Para isso existem K buffers (K = 2: buffer duplo, K = 3: buffer triplo)
+ circulando entre três filas:
+
+   livres --(leitura)--> lidos --(cálculo)--> calculados --(escrita)--> livres
+
+ Como só existem K buffers, a memória usada é K × (tamanho do bloco),
+ não importa o tamanho do arquivo. Se o disco for mais lento que o cálculo,
+ as threads de cálculo esperam na fila "lidos"; se for mais rápido, a
+ leitura espera na fila "livres" — a fila limitada regula o ritmo sozinha.
+
+ As páginas já lidas/escritas são liberadas do cache de arquivos com
+ posix_fadvise(POSIX_FADV_DONTNEED), para que o processo não empurre
+ o resto do sistema para fora da memória.
+
+ Dois modos:
+   salarios : arquivo binário de doubles (sem cabeçalho). Calcula N, média,
+              variância e desvio-padrão populacional; o estágio de escrita
+              só devolve o buffer.
+              Cada bloco é reduzido para (n, média, M2) e os blocos são
+              combinados com a fórmula de Chan — assim o arquivo é lido uma
+              única vez (a versão do 007_reduction_0.1 faz duas passadas).
+   bhaskara : arquivo no formato do 009_bhaskara_lote_0.1 (gere com
+              "./009_bhaskara_lote_0.1 gerar dados.bin N"). Grava x1, x2 e classe
+              em um arquivo de saída: [x1: N doubles][x2: N doubles][classe: N bytes].
+
+ Somente Linux/WSL (pread/pwrite/posix_fadvise).
+
+ Compilar:
+   g++ -O3 -fopenmp -fno-math-errno 010_pipeline_0.0.cpp -o 010_pipeline_0.0
+
+ Executar:
+   ./010_pipeline_0.0 gerar-salarios salarios.bin 2000000000      (16 GB)
+   ./010_pipeline_0.0 salarios salarios.bin 3                      (buffer triplo)
+   ./010_pipeline_0.0 bhaskara dados.bin saida.bin 3
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <iomanip>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <omp.h>
+
+#include <fcntl.h>          // open, posix_fadvise
+#include <unistd.h>         // pread, pwrite, close
+#include <sys/resource.h>   // getrusage (pico de memória)
+
+/*---------------------------------------------------
+ Fila limitada (bloqueante)
+-----------------------------------------------------
+ Guarda ÍNDICES de buffers. pop() espera até haver um item.
+ O valor FIM (-1) avisa o estágio seguinte que os dados acabaram.
+*/
+class FilaLimitada {
+public:
+    static constexpr int FIM = -1;
+
+    void push(int idx) {
+        {
+            std::lock_guard<std::mutex> trava(m_);
+            q_.push_back(idx);
+        }
+        cv_.notify_one();
+    }
+
+    int pop() {
+        std::unique_lock<std::mutex> trava(m_);
+        cv_.wait(trava, [this] { return !q_.empty(); });
+        const int idx = q_.front();
+        q_.pop_front();
+        return idx;
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<int> q_;
+};
+
+/*---------------------------------------------------
+ Pipeline genérico de três estágios
+-----------------------------------------------------
+ ler(buf)      -> preenche o buffer; retorna false quando o arquivo acabou.
+ calcular(buf) -> roda na thread principal (usa #pragma omp parallel for).
+ escrever(buf) -> grava/descarta o resultado.
+ Cada estágio mede o tempo que passou TRABALHANDO (sem contar esperas).
+*/
+struct TemposPipeline {
+    double leitura = 0.0, calculo = 0.0, escrita = 0.0, total = 0.0;
+    long long blocos = 0;
+};
+
+template <typename Buffer>
+TemposPipeline executar_pipeline(std::vector<Buffer>& buffers,
+                                 const std::function<bool(Buffer&)>& ler,
+                                 const std::function<void(Buffer&)>& calcular,
+                                 const std::function<void(Buffer&)>& escrever) {
+    FilaLimitada livres, lidos, calculados;
+    for (int k = 0; k < static_cast<int>(buffers.size()); ++k) livres.push(k);
+
+    TemposPipeline t;
+    const double inicio = omp_get_wtime();
+
+    std::thread leitor([&] {
+        for (;;) {
+            const int idx = livres.pop();
+            const double t0 = omp_get_wtime();
+            const bool tem_dados = ler(buffers[idx]);
+            t.leitura += omp_get_wtime() - t0;
+            if (!tem_dados) { lidos.push(FilaLimitada::FIM); return; }
+            lidos.push(idx);
+        }
+    });
+
+    std::thread escritor([&] {
+        for (;;) {
+            const int idx = calculados.pop();
+            if (idx == FilaLimitada::FIM) return;
+            const double t0 = omp_get_wtime();
+            escrever(buffers[idx]);
+            t.escrita += omp_get_wtime() - t0;
+            livres.push(idx);
+        }
+    });
+
+    // Estágio de cálculo na thread principal: é ela quem abre as regiões paralelas.
+    for (;;) {
+        const int idx = lidos.pop();
+        if (idx == FilaLimitada::FIM) { calculados.push(FilaLimitada::FIM); break; }
+        const double t0 = omp_get_wtime();
+        calcular(buffers[idx]);
+        t.calculo += omp_get_wtime() - t0;
+        t.blocos++;
+        calculados.push(idx);
+    }
+
+    leitor.join();
+    escritor.join();
+    t.total = omp_get_wtime() - inicio;
+    return t;
+}
+
+// Lê exatamente 'bytes' (pread pode devolver menos que o pedido).
+bool ler_tudo(int fd, void* destino, std::size_t bytes, std::uint64_t pos) {
+    char* p = static_cast<char*>(destino);
+    while (bytes > 0) {
+        const ssize_t r = pread(fd, p, bytes, static_cast<off_t>(pos));
+        if (r <= 0) return false;
+        p += r; pos += static_cast<std::uint64_t>(r); bytes -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+bool escrever_tudo(int fd, const void* origem, std::size_t bytes, std::uint64_t pos) {
+    const char* p = static_cast<const char*>(origem);
+    while (bytes > 0) {
+        const ssize_t w = pwrite(fd, p, bytes, static_cast<off_t>(pos));
+        if (w <= 0) return false;
+        p += w; pos += static_cast<std::uint64_t>(w); bytes -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+long pico_memoria_mb() {
+    struct rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss / 1024;   // ru_maxrss vem em KB no Linux
+}
+
+void relatorio(const TemposPipeline& t, std::size_t nbuffers, double bytes_lidos) {
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Buffers            : " << nbuffers << "\n";
+    std::cout << "Blocos             : " << t.blocos << "\n";
+    std::cout << "Tempo leitura (s)  : " << t.leitura << "\n";
+    std::cout << "Tempo calculo (s)  : " << t.calculo << "\n";
+    std::cout << "Tempo escrita (s)  : " << t.escrita << "\n";
+    std::cout << "Tempo total   (s)  : " << t.total << "\n";
+    if (t.total > 0) {
+        // 1.0 = estágios em série; perto de 3.0 = os três estágios 100% sobrepostos
+        std::cout << "Sobreposicao       : " << (t.leitura + t.calculo + t.escrita) / t.total << "x\n";
+        std::cout << "Vazao (GB/s)       : " << bytes_lidos / 1e9 / t.total << "\n";
+    }
+    std::cout << "Pico de memoria    : " << pico_memoria_mb() << " MB\n";
+}
+
+/*===================================================
+ Modo SALÁRIOS
+=====================================================*/
+struct BufferSalarios {
+    std::vector<double> dados;
+    std::size_t len = 0;
+};
+
+// Estatística parcial de um conjunto: quantidade, média e soma dos quadrados dos desvios.
+struct Parcial {
+    double n = 0.0, media = 0.0, m2 = 0.0;
+};
+
+// Fórmula de Chan: junta duas parciais sem voltar aos dados.
+Parcial combinar(const Parcial& x, const Parcial& y) {
+    if (x.n == 0) return y;
+    if (y.n == 0) return x;
+    Parcial r;
+    r.n = x.n + y.n;
+    const double delta = y.media - x.media;
+    r.media = x.media + delta * (y.n / r.n);
+    r.m2 = x.m2 + y.m2 + delta * delta * (x.n * y.n / r.n);
+    return r;
+}
+
+int modo_salarios(const std::string& caminho, std::size_t nbuffers, std::size_t chunk) {
+    const int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) { std::perror("open"); return 1; }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::vector<BufferSalarios> buffers(nbuffers);
+    for (auto& b : buffers) b.dados.resize(chunk);
+
+    std::uint64_t pos = 0;
+    bool erro = false;
+    Parcial total;
+
+    auto ler = [&](BufferSalarios& buf) {
+        const ssize_t r = pread(fd, buf.dados.data(), chunk * sizeof(double), static_cast<off_t>(pos));
+        if (r < 0) { erro = true; return false; }
+        if (r == 0) return false;
+        // pread pode devolver menos que o pedido: o restante vem no próximo bloco
+        const std::size_t bytes = static_cast<std::size_t>(r) / sizeof(double) * sizeof(double);
+        buf.len = bytes / sizeof(double);
+        posix_fadvise(fd, static_cast<off_t>(pos), static_cast<off_t>(bytes), POSIX_FADV_DONTNEED);
+        pos += bytes;
+        return buf.len > 0;
+    };
+
+    auto calcular = [&](BufferSalarios& buf) {
+        const double* x = buf.dados.data();
+        const std::int64_t n = static_cast<std::int64_t>(buf.len);
+
+        // Duas passadas sobre o BLOCO (que está na memória), uma sobre o arquivo.
+        double soma = 0.0;
+        #pragma omp parallel for simd schedule(static) reduction(+:soma)
+        for (std::int64_t i = 0; i < n; ++i) soma += x[i];
+        const double media = soma / static_cast<double>(n);
+
+        double m2 = 0.0;
+        #pragma omp parallel for simd schedule(static) reduction(+:m2)
+        for (std::int64_t i = 0; i < n; ++i) {
+            const double d = x[i] - media;
+            m2 += d * d;
+        }
+
+        total = combinar(total, Parcial{static_cast<double>(n), media, m2});
+    };
+
+    auto escrever = [](BufferSalarios&) {};   // nada a gravar: só devolve o buffer
+
+    const TemposPipeline t = executar_pipeline<BufferSalarios>(buffers, ler, calcular, escrever);
+    close(fd);
+    if (erro) { std::cerr << "Erro de leitura\n"; return 1; }
+
+    const double variancia = total.n > 0 ? total.m2 / total.n : 0.0;
+    std::cout << "Analise Salarial (Populacional, em fluxo)\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "N = " << static_cast<long long>(total.n) << "\n";
+    std::cout << "Media (μ)                  : R$ " << total.media << "\n";
+    std::cout << "Variancia populacional (σ²): R$ " << variancia << "\n";
+    std::cout << "Desvio-padrao populacional : R$ " << std::sqrt(variancia) << "\n\n";
+    relatorio(t, nbuffers, total.n * sizeof(double));
+    return 0;
+}
+
+// Gera salários no padrão do 007_reduction_0.1 (média 4990, desvio ≈ 577.32).
+int gerar_salarios(const std::string& caminho, std::uint64_t n, std::size_t chunk) {
+    const int fd = open(caminho.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0) { std::perror("open"); return 1; }
+
+    std::vector<double> buf(chunk);
+    for (std::uint64_t i0 = 0; i0 < n; i0 += chunk) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(chunk, n - i0));
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t j = 0; j < static_cast<std::int64_t>(len); ++j) {
+            buf[j] = 4000.0 + static_cast<double>((i0 + static_cast<std::uint64_t>(j)) % 100) * 20.0;
+        }
+        if (!escrever_tudo(fd, buf.data(), len * sizeof(double), i0 * sizeof(double))) {
+            std::perror("pwrite");
+            close(fd);
+            return 1;
+        }
+        posix_fadvise(fd, static_cast<off_t>(i0 * sizeof(double)), static_cast<off_t>(len * sizeof(double)),
+                      POSIX_FADV_DONTNEED);
+    }
+    close(fd);
+    std::cout << "Arquivo " << caminho << " gravado com " << n << " salarios.\n";
+    return 0;
+}
+
+/*===================================================
+ Modo BHASKARA
+=====================================================*/
+// Cabeçalho do formato do 009_bhaskara_lote_0.1 (somente o que é lido aqui).
+struct DescritorColuna {
+    char          nome[8];
+    std::uint64_t deslocamento;
+    std::uint64_t bytes;
+    std::uint64_t checksum;
+};
+
+struct CabecalhoArquivo {
+    char            magica[8];
+    std::uint32_t   versao;
+    std::uint32_t   num_colunas;
+    std::uint64_t   n;
+    DescritorColuna colunas[3];
+};
+
+// Kernel omp simd do 009_bhaskara_lote_0.0 (modo rápido).
+void kernel_simd(const double* a, const double* b, const double* c,
+                 double* x1, double* x2, std::uint8_t* classe, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        const double delta = (b[i] * b[i]) - (4 * a[i] * c[i]);
+        const bool   ok    = !(delta < 0);
+        const double raiz  = std::sqrt(ok ? delta : 0.0);
+        const double dois_a = 2 * a[i];
+
+        x1[i] = ok ? (-b[i] + raiz) / dois_a : 0.0;
+        x2[i] = ok ? (-b[i] - raiz) / dois_a : 0.0;
+        classe[i] = ok + (delta > 0);
+    }
+}
+
+struct BufferBhaskara {
+    std::vector<double> a, b, c, x1, x2;
+    std::vector<std::uint8_t> classe;
+    std::uint64_t i0 = 0;
+    std::size_t len = 0;
+};
+
+int modo_bhaskara(const std::string& entrada, const std::string& saida, std::size_t nbuffers, std::size_t chunk) {
+    const int fd_in = open(entrada.c_str(), O_RDONLY);
+    if (fd_in < 0) { std::perror("open entrada"); return 1; }
+
+    CabecalhoArquivo cab{};
+    if (!ler_tudo(fd_in, &cab, sizeof(cab), 0) || std::memcmp(cab.magica, "BHASKARA", 8) != 0 ||
+        cab.versao != 1 || cab.num_colunas != 3) {
+        std::cerr << "Arquivo de entrada invalido (use 009_bhaskara_lote_0.1 gerar)\n";
+        close(fd_in);
+        return 1;
+    }
+    posix_fadvise(fd_in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    const int fd_out = open(saida.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd_out < 0) { std::perror("open saida"); close(fd_in); return 1; }
+
+    const std::uint64_t n = cab.n;
+    std::vector<BufferBhaskara> buffers(nbuffers);
+    for (auto& b : buffers) {
+        b.a.resize(chunk); b.b.resize(chunk); b.c.resize(chunk);
+        b.x1.resize(chunk); b.x2.resize(chunk); b.classe.resize(chunk);
+    }
+
+    std::uint64_t proximo = 0;
+    std::atomic<bool> erro{false};   // escrito pelas threads de leitura e de escrita
+    long long classes[3] = {0, 0, 0};
+
+    auto ler = [&](BufferBhaskara& buf) {
+        if (proximo >= n) return false;
+        buf.i0  = proximo;
+        buf.len = static_cast<std::size_t>(std::min<std::uint64_t>(chunk, n - proximo));
+        std::vector<double>* destinos[3] = {&buf.a, &buf.b, &buf.c};
+        for (int k = 0; k < 3; ++k) {
+            const std::uint64_t pos = cab.colunas[k].deslocamento + buf.i0 * sizeof(double);
+            if (!ler_tudo(fd_in, destinos[k]->data(), buf.len * sizeof(double), pos)) { erro = true; return false; }
+            posix_fadvise(fd_in, static_cast<off_t>(pos), static_cast<off_t>(buf.len * sizeof(double)),
+                          POSIX_FADV_DONTNEED);
+        }
+        proximo += buf.len;
+        return true;
+    };
+
+    auto calcular = [&](BufferBhaskara& buf) {
+        const std::size_t  BLOCO = 4096;
+        const std::int64_t nb    = static_cast<std::int64_t>((buf.len + BLOCO - 1) / BLOCO);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t bl = 0; bl < nb; ++bl) {
+            const std::size_t j0 = static_cast<std::size_t>(bl) * BLOCO;
+            const std::size_t m  = std::min(BLOCO, buf.len - j0);
+            kernel_simd(buf.a.data() + j0, buf.b.data() + j0, buf.c.data() + j0,
+                        buf.x1.data() + j0, buf.x2.data() + j0, buf.classe.data() + j0, m);
+        }
+
+        long long c0 = 0, c1 = 0, c2 = 0;
+        const std::uint8_t* cl = buf.classe.data();
+        #pragma omp parallel for simd schedule(static) reduction(+:c0, c1, c2)
+        for (std::int64_t j = 0; j < static_cast<std::int64_t>(buf.len); ++j) {
+            c0 += (cl[j] == 0);
+            c1 += (cl[j] == 1);
+            c2 += (cl[j] == 2);
+        }
+        classes[0] += c0; classes[1] += c1; classes[2] += c2;
+    };
+
+    auto escrever = [&](BufferBhaskara& buf) {
+        const std::uint64_t pos_x1 = buf.i0 * sizeof(double);
+        const std::uint64_t pos_x2 = n * sizeof(double) + buf.i0 * sizeof(double);
+        const std::uint64_t pos_cl = 2 * n * sizeof(double) + buf.i0;
+        if (!escrever_tudo(fd_out, buf.x1.data(), buf.len * sizeof(double), pos_x1) ||
+            !escrever_tudo(fd_out, buf.x2.data(), buf.len * sizeof(double), pos_x2) ||
+            !escrever_tudo(fd_out, buf.classe.data(), buf.len, pos_cl)) {
+            erro = true;
+        }
+    };
+
+    const TemposPipeline t = executar_pipeline<BufferBhaskara>(buffers, ler, calcular, escrever);
+    close(fd_in);
+    close(fd_out);
+    if (erro) { std::cerr << "Erro de leitura/escrita\n"; return 1; }
+
+    std::cout << "Bhaskara em fluxo\n";
+    std::cout << "Equacoes           : " << n << "\n";
+    std::cout << "Com raizes reais   : " << classes[1] + classes[2] << "\n";
+    std::cout << "Sem raizes reais   : " << classes[0] << "\n\n";
+    relatorio(t, nbuffers, 3.0 * static_cast<double>(n) * sizeof(double));
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Uso:\n"
+                  << "  " << argv[0] << " gerar-salarios <arquivo> <N>\n"
+                  << "  " << argv[0] << " salarios <arquivo> [buffers=3] [bloco=4194304]\n"
+                  << "  " << argv[0] << " bhaskara <entrada> <saida> [buffers=3] [bloco=1048576]\n";
+        return 1;
+    }
+
+    const std::string modo = argv[1];
+
+    if (modo == "gerar-salarios" && argc > 3) {
+        return gerar_salarios(argv[2], std::strtoull(argv[3], nullptr, 10), 1u << 22);
+    }
+    if (modo == "salarios") {
+        const std::size_t nbuffers = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 3;
+        const std::size_t chunk    = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : (1u << 22);  // 32 MB
+        return modo_salarios(argv[2], std::max<std::size_t>(1, nbuffers), std::max<std::size_t>(1, chunk));
+    }
+    if (modo == "bhaskara" && argc > 3) {
+        const std::size_t nbuffers = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 3;
+        const std::size_t chunk    = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : (1u << 20);  // ~41 MB por buffer
+        return modo_bhaskara(argv[2], argv[3], std::max<std::size_t>(1, nbuffers), std::max<std::size_t>(1, chunk));
+    }
+
+    std::cerr << "Argumentos invalidos.\n";
+    return 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Pico de memoria fica praticamente constante quando o arquivo cresce:
+   ele depende de buffers × bloco (3 × 32 MB no modo salarios), não do N.
+   Um arquivo de 100 GB roda em uma máquina de 16 GB.
+
+2. Com 1 buffer não há sobreposição (Sobreposicao ≈ 1.0x): lê, calcula,
+   escreve, um de cada vez. Com 2 ou 3 buffers a leitura do próximo bloco
+   acontece enquanto o atual é calculado.
+
+3. As threads de leitura e escrita passam a maior parte do tempo esperando o
+   disco; se a máquina tiver poucos núcleos, OMP_NUM_THREADS = núcleos - 1
+   evita que elas disputem CPU com o estágio de cálculo.
+
+4. Média e variância batem com o 007_reduction_0.1 (μ = 4990,00,
+   σ ≈ 577,32 para o arquivo gerado por gerar-salarios).
+*/
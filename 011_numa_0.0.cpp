@@ -0,0 +1,345 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 011_numa_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  NUMA-aware first-touch initialization, programmatic thread pinning and placement report
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ NUMA: "primeiro toque" (first touch) e fixação de threads
+-----------------------------------------------------
+ Em servidores com dois (ou mais) soquetes, cada soquete tem a SUA memória.
+ Ler a memória do outro soquete (memória "remota") é mais lento e disputa
+ o barramento entre os soquetes. Isso é NUMA (Non-Uniform Memory Access).
+
+ Onde uma página de memória fica? O Linux usa a regra do PRIMEIRO TOQUE:
+ a página é colocada no nó NUMA da thread que escreve nela pela primeira vez.
+
+ Era assim no 005 e no 007_reduction_0.1 (e ainda é no 004):
+
+     std::vector<double> x(N);          // <- o CONSTRUTOR zera o vetor
+                                        //    em UMA thread: todas as páginas
+                                        //    vão para o nó dessa thread!
+     #pragma omp parallel for schedule(static)
+     for (...) x[i] = ...;              // metade das threads escreve em
+                                        // memória remota
+
+ A correção tem três partes:
+
+ 1. Alocar SEM inicializar: VetorNuma (vetor_numa.hpp) é um std::vector com
+    um alocador que não toca na memória (construção "default", sem zerar).
+
+ 2. Inicializar em paralelo com o MESMO schedule(static) do cálculo:
+    a thread t escreve primeiro exatamente o pedaço [início_t, fim_t) que
+    ela mesma vai processar depois -> as páginas ficam no nó dela.
+
+ 3. FIXAR as threads nos núcleos (OMP_PROC_BIND / OMP_PLACES): sem isso o
+    SO pode migrar a thread para o outro soquete e a memória "local" vira remota.
+    O runtime do OpenMP lê essas variáveis quando o programa CARREGA, antes
+    do main. Por isso, se o usuário não as definiu, o programa define os
+    padrões (OMP_PROC_BIND=close, OMP_PLACES=cores) e se reexecuta uma vez.
+
+ O 005 e o 007_reduction_0.1 agora seguem os três passos (VetorNuma,
+ inicialização com schedule(static) e garantir_ambiente_omp). O 004 ficou
+ como está: são 10 inteiros, a primeira aula de parallel for, e os vetores
+ cabem numa única página. Este programa compara as duas versões lado a lado.
+
+ Ao final, um relatório mostra onde cada thread rodou (place, CPU, nó) e
+ em qual nó ficaram as páginas que ela processa (syscall move_pages).
+
+ Somente Linux (move_pages, sched_getcpu, /sys/devices/system/node).
+
+ Compilar:
+   g++ -O3 -fopenmp 011_numa_0.0.cpp -o 011_numa_0.0
+
+ Executar:
+   ./011_numa_0.0 100000000
+   OMP_PROC_BIND=spread OMP_PLACES=cores ./011_numa_0.0       (padrões do usuário são respeitados)
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <omp.h>
+
+#include <sched.h>          // sched_getcpu
+#include <unistd.h>         // sysconf
+#include <dirent.h>         // leitura de /sys
+#include <sys/syscall.h>    // SYS_move_pages
+#include "ambiente_omp.hpp"
+#include "vetor_numa.hpp"
+
+const char* nome_proc_bind(omp_proc_bind_t b) {
+    switch (b) {
+        case omp_proc_bind_false:  return "false";
+        case omp_proc_bind_true:   return "true";
+        case omp_proc_bind_master: return "master/primary";
+        case omp_proc_bind_close:  return "close";
+        case omp_proc_bind_spread: return "spread";
+    }
+    return "?";
+}
+
+// Nó NUMA de uma CPU: /sys/devices/system/cpu/cpuN/ contém um link "nodeX".
+int no_da_cpu(int cpu) {
+    const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* d = opendir(dir.c_str());
+    if (!d) return -1;
+    int no = -1;
+    while (dirent* e = readdir(d)) {
+        if (std::strncmp(e->d_name, "node", 4) == 0) { no = std::atoi(e->d_name + 4); break; }
+    }
+    closedir(d);
+    return no < 0 ? 0 : no;   // máquinas sem NUMA não expõem o link: tudo é nó 0
+}
+
+// Nó NUMA onde está cada página (move_pages com nodes = NULL só CONSULTA).
+std::vector<int> nos_das_paginas(const std::vector<void*>& paginas) {
+    std::vector<int> status(paginas.size(), -1);
+    if (paginas.empty()) return status;
+    std::vector<void*> p = paginas;
+    const long r = syscall(SYS_move_pages, 0, static_cast<unsigned long>(p.size()), p.data(),
+                           nullptr, status.data(), 0);
+    if (r != 0) std::fill(status.begin(), status.end(), -1);
+    return status;
+}
+
+/*---------------------------------------------------
+ Relatório de posicionamento
+-----------------------------------------------------
+ Para cada thread: place, CPU e nó onde rodou, e a fração das páginas do seu
+ pedaço (schedule(static)) que está no MESMO nó (amostra de até 64 páginas).
+*/
+void relatorio_posicionamento(const double* dados, std::int64_t n) {
+    const int T = omp_get_max_threads();
+    std::vector<int> place(T), cpu(T), no(T);
+    std::vector<std::int64_t> inicio(T, 0), fim(T, 0);
+
+    #pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        place[t] = omp_get_place_num();
+        cpu[t]   = sched_getcpu();
+        no[t]    = no_da_cpu(cpu[t]);
+
+        // Descobre o pedaço que o schedule(static) dá a esta thread
+        std::int64_t lo = n, hi = -1;
+        #pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < n; ++i) {
+            if (i < lo) lo = i;
+            hi = i;
+        }
+        inicio[t] = lo;
+        fim[t]    = hi + 1;
+    }
+
+    const long pagina = sysconf(_SC_PAGESIZE);
+    const std::int64_t por_pagina = pagina / static_cast<long>(sizeof(double));
+
+    std::cout << "\nPosicionamento (OMP_PROC_BIND=" << nome_proc_bind(omp_get_proc_bind())
+              << ", places = " << omp_get_num_places() << ")\n";
+    std::cout << "-------------------------------------------------------------\n";
+    std::cout << " thread | place |  cpu | no | paginas locais (amostra)\n";
+    std::cout << "-------------------------------------------------------------\n";
+
+    long long locais_total = 0, amostras_total = 0;
+    for (int t = 0; t < T; ++t) {
+        std::vector<void*> amostra;
+        const std::int64_t len = fim[t] - inicio[t];
+        const std::int64_t passo = std::max<std::int64_t>(por_pagina, len / 64);
+        for (std::int64_t i = inicio[t]; i < fim[t]; i += passo) {
+            const auto endereco = reinterpret_cast<std::uintptr_t>(dados + i);
+            amostra.push_back(reinterpret_cast<void*>(endereco / static_cast<std::uintptr_t>(pagina) * pagina));
+        }
+        const std::vector<int> nos = nos_das_paginas(amostra);
+        int locais = 0;
+        for (int x : nos) locais += (x == no[t]);
+        locais_total   += locais;
+        amostras_total += static_cast<long long>(nos.size());
+
+        std::cout << std::setw(7) << t << " | " << std::setw(5) << place[t] << " | " << std::setw(4) << cpu[t]
+                  << " | " << std::setw(2) << no[t] << " | " << locais << "/" << nos.size() << "\n";
+    }
+    std::cout << "-------------------------------------------------------------\n";
+    if (amostras_total > 0) {
+        std::cout << "Paginas no no da thread que as processa: "
+                  << std::fixed << std::setprecision(1) << 100.0 * locais_total / amostras_total << "%\n";
+    }
+}
+
+/*---------------------------------------------------
+ Kernels (mesmo schedule(static) na inicialização e no cálculo)
+-----------------------------------------------------*/
+template <typename Vetor>
+void inicializar_paralelo(Vetor& x, Vetor& y, Vetor& z, Vetor& a, Vetor& salarios) {
+    const std::int64_t n = static_cast<std::int64_t>(x.size());
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        x[i] = i * 0.5;
+        y[i] = i * 0.5 + 1.0;
+        z[i] = i * 0.5 + 2.0;
+        a[i] = 0.0;
+        salarios[i] = 4000.0 + static_cast<double>(i % 100) * 20.0;
+    }
+}
+
+struct Tempos {
+    double expressao = 0.0, estatistica = 0.0;
+    double media = 0.0, desvio = 0.0;
+};
+
+template <typename Vetor>
+Tempos executar_kernels(Vetor& x, Vetor& y, Vetor& z, Vetor& a, const Vetor& salarios, int repeticoes) {
+    const std::int64_t n = static_cast<std::int64_t>(x.size());
+    Tempos t;
+
+    // 004/005: a = x*x + y*y + z*z
+    double t0 = omp_get_wtime();
+    for (int r = 0; r < repeticoes; ++r) {
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < n; ++i) {
+            a[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        }
+    }
+    t.expressao = (omp_get_wtime() - t0) / repeticoes;
+
+    // 007_reduction_0.1: média e desvio-padrão populacional
+    t0 = omp_get_wtime();
+    for (int r = 0; r < repeticoes; ++r) {
+        double soma = 0.0;
+        #pragma omp parallel for schedule(static) reduction(+:soma)
+        for (std::int64_t i = 0; i < n; ++i) soma += salarios[i];
+        const double mu = soma / static_cast<double>(n);
+
+        double soma_desvios2 = 0.0;
+        #pragma omp parallel for schedule(static) reduction(+:soma_desvios2)
+        for (std::int64_t i = 0; i < n; ++i) {
+            const double d = salarios[i] - mu;
+            soma_desvios2 += d * d;
+        }
+        t.media  = mu;
+        t.desvio = std::sqrt(soma_desvios2 / static_cast<double>(n));
+    }
+    t.estatistica = (omp_get_wtime() - t0) / repeticoes;
+    return t;
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 50'000'000;
+    if (N < 1) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 1]\n";
+        return 1;
+    }
+
+    // Padrões de afinidade: só para as variáveis que o usuário não definiu
+    // (ambiente_omp.hpp reexecuta o programa uma vez, avisando no stderr)
+    garantir_ambiente_omp(argv, {{"OMP_PROC_BIND", "close"}, {"OMP_PLACES", "cores"}});
+    const int REPETICOES = 5;
+
+    std::cout << "NUMA first-touch\n";
+    std::cout << "N = " << N << ", threads = " << omp_get_max_threads() << "\n";
+
+    // ---------------------------
+    // 1) Como era no 005/007_reduction_0.1: o construtor zera tudo em UMA thread
+    // ---------------------------
+    Tempos ingenuo;
+    {
+        std::vector<double> x(N), y(N), z(N), a(N), salarios(N);
+        inicializar_paralelo(x, y, z, a, salarios);   // tarde demais: as páginas já têm dono
+        ingenuo = executar_kernels(x, y, z, a, salarios, REPETICOES);
+    }
+
+    // ---------------------------
+    // 2) NUMA: aloca sem tocar e inicializa com o schedule do cálculo
+    // ---------------------------
+    Tempos numa;
+    {
+        VetorNuma<double> x(N), y(N), z(N), a(N), salarios(N);
+        inicializar_paralelo(x, y, z, a, salarios);   // primeiro toque = dono certo
+        numa = executar_kernels(x, y, z, a, salarios, REPETICOES);
+        relatorio_posicionamento(x.data(), N);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nMedia / desvio (conferencia): R$ " << numa.media << " / R$ " << numa.desvio << "\n";
+    std::cout << std::setprecision(4);
+    std::cout << "\n                      | ingenuo (s) | first-touch (s) | ganho\n";
+    std::cout << "a = x*x + y*y + z*z   | " << std::setw(11) << ingenuo.expressao << " | "
+              << std::setw(15) << numa.expressao << " | " << ingenuo.expressao / numa.expressao << "x\n";
+    std::cout << "media + desvio        | " << std::setw(11) << ingenuo.estatistica << " | "
+              << std::setw(15) << numa.estatistica << " | " << ingenuo.estatistica / numa.estatistica << "x\n";
+
+    return 0;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Em uma máquina com UM soquete (um nó NUMA) os dois tempos são iguais e
+   100% das páginas são locais: não há memória remota.
+
+2. Em dois soquetes, na versão ingênua metade das threads lê memória remota;
+   o ganho da versão first-touch costuma ficar entre 1.3x e 2x nesses laços
+   limitados por memória.
+
+3. Se o relatório mostrar OMP_PROC_BIND=false, as threads não estão fixadas
+   e o SO pode movê-las entre soquetes durante a execução.
+
+4. Os mesmos três passos valem para qualquer laço paralelo: alocar sem
+   inicializar, inicializar em paralelo com o mesmo schedule do cálculo e
+   fixar as threads.
+*/
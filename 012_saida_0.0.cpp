@@ -0,0 +1,318 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 012_saida_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Ordered output without #pragma omp ordered: per-chunk buffers, lock-free sequence ring, single writer
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+/*---------------------------------------------------
+ Saída em ordem sem #pragma omp ordered
+-----------------------------------------------------*/
+
+// O 006_sincronizacao_0.4 imprime o resultado de cada equação em ordem com
+//     #pragma omp parallel for ordered
+//     ...
+//     #pragma omp ordered
+//     { std::cout << ... << std::endl; }
+// Com N = 10 tudo bem. Com milhões de equações, a iteração i+1 não pode
+// imprimir antes da i: as threads passam a maior parte do tempo esperando
+// a vez, e o std::endl ainda força uma escrita no sistema a cada linha.
+
+/*---------------------------------------------------
+ A ideia: separar CALCULAR/FORMATAR de ESCREVER
+-----------------------------------------------------
+ 1) As iterações são agrupadas em BLOCOS (ex.: 4096 equações).
+ 2) Cada thread calcula e FORMATA um bloco inteiro num buffer de texto
+    próprio — em paralelo, sem esperar ninguém.
+ 3) Uma única thread escritora (std::thread) emite os blocos na ordem
+    0, 1, 2, ... assim que cada um fica pronto.
+
+ Como a escritora sabe que o bloco b está pronto, sem lock?
+   Um ANEL de J posições. O bloco b usa a posição b % J, que guarda um
+   número de sequência atômico:
+     - a thread que formatou o bloco b publica:   seq = b + 1  (release)
+     - a escritora espera a posição do próximo bloco ter seq == b + 1 (acquire),
+       escreve o texto, e libera a posição para o bloco b + J.
+   O release/acquire garante que, quando a escritora vê o número, o texto
+   do buffer já está completo.
+
+ Memória limitada: no máximo J blocos formatados esperando a escritora.
+ Se as threads correrem demais, a do bloco b espera até que o bloco b − J
+ tenha sido escrito (contrapressão).
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+
+// Função resolver_bhaskara (a mesma dos exemplos 006)
+double resolver_bhaskara(double a, double b, double c) {
+    double delta = (b * b) - (4 * a * c);
+    if (delta < 0) return 0.0;
+    double x1 = (-b + std::sqrt(delta)) / (2 * a);
+    double x2 = (-b - std::sqrt(delta)) / (2 * a);
+    return x1 + x2;
+}
+
+inline void pausa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Espera ativa curta e depois cede o processador
+template <typename Pronto>
+void esperar(Pronto&& pronto) {
+    for (int voltas = 0; !pronto(); ++voltas) {
+        if (voltas < 256) pausa();
+        else std::this_thread::yield();
+    }
+}
+
+class ColetorOrdenado {
+public:
+    // saida: onde escrever; blocos: quantos blocos no total; janela: J (blocos em memória)
+    ColetorOrdenado(std::FILE* saida, std::int64_t blocos, int janela = 64)
+        : saida_(saida), blocos_(blocos), janela_(janela), posicoes_(janela) {
+        for (int j = 0; j < janela_; ++j) posicoes_[j].valor.seq.store(0, std::memory_order_relaxed);
+        escritora_ = std::thread([this] { escrever(); });
+    }
+
+    ~ColetorOrdenado() { finalizar(); }
+
+    // Buffer do bloco b, vazio. Espera a posição b % J ficar livre (contrapressão).
+    std::string& reservar(std::int64_t b) {
+        esperar([&] { return escritos_.load(std::memory_order_acquire) > b - janela_; });
+        std::string& texto = posicoes_[b % janela_].valor.texto;
+        texto.clear();
+        return texto;
+    }
+
+    // O texto do bloco b está completo.
+    void publicar(std::int64_t b) {
+        posicoes_[b % janela_].valor.seq.store(b + 1, std::memory_order_release);
+    }
+
+    // Espera a escritora terminar (todos os blocos publicados).
+    void finalizar() {
+        if (escritora_.joinable()) escritora_.join();
+    }
+
+    std::int64_t bytes_escritos() const { return bytes_; }
+
+private:
+    struct Posicao {
+        std::atomic<std::int64_t> seq{0};
+        std::string               texto;
+    };
+
+    void escrever() {
+        for (std::int64_t b = 0; b < blocos_; ++b) {
+            Posicao& p = posicoes_[b % janela_].valor;
+            esperar([&] { return p.seq.load(std::memory_order_acquire) == b + 1; });
+            std::fwrite(p.texto.data(), 1, p.texto.size(), saida_);
+            bytes_ += static_cast<std::int64_t>(p.texto.size());
+            escritos_.store(b + 1, std::memory_order_release);   // libera a posição para o bloco b + J
+        }
+        std::fflush(saida_);
+    }
+
+    std::FILE*                         saida_;
+    std::int64_t                       blocos_;
+    int                                janela_;
+    // cada posição na sua linha de cache: seq é escrito por threads diferentes
+    std::vector<LinhaPropria<Posicao>> posicoes_;
+    alignas(TAMANHO_LINHA_CACHE) std::atomic<std::int64_t> escritos_{0};
+    std::int64_t                       bytes_ = 0;
+    std::thread                        escritora_;
+};
+
+// Formata a linha da equação i (mesmo texto do 006_sincronizacao_0.4)
+inline void formatar(std::string& s, std::int64_t i, double soma) {
+    char linha[96];
+    const int n = std::snprintf(linha, sizeof(linha), "Resultado para a equação %lld: Soma das raízes = %g\n",
+                                static_cast<long long>(i), soma);
+    s.append(linha, static_cast<std::size_t>(n));
+}
+
+struct Dados {
+    std::vector<double> a, b, c;
+};
+
+// Referência: o laço do 006_sincronizacao_0.4 (ordered), escrevendo no mesmo formato
+void com_ordered(const Dados& d, std::FILE* saida) {
+    const std::int64_t N = static_cast<std::int64_t>(d.a.size());
+    #pragma omp parallel for ordered schedule(static, 1)
+    for (std::int64_t i = 0; i < N; ++i) {
+        const double soma_local = resolver_bhaskara(d.a[i], d.b[i], d.c[i]);
+        #pragma omp ordered
+        {
+            std::string s;
+            formatar(s, i, soma_local);
+            std::fwrite(s.data(), 1, s.size(), saida);
+        }
+    }
+    std::fflush(saida);
+}
+
+std::int64_t com_coletor(const Dados& d, std::FILE* saida, std::int64_t bloco) {
+    const std::int64_t N = static_cast<std::int64_t>(d.a.size());
+    const std::int64_t nblocos = (N + bloco - 1) / bloco;
+
+    ColetorOrdenado coletor(saida, nblocos, 4 * omp_get_max_threads());
+
+    // dynamic: os blocos são pegos em ordem crescente, a escritora quase nunca espera
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::int64_t b = 0; b < nblocos; ++b) {
+        std::string& texto = coletor.reservar(b);
+        const std::int64_t fim = std::min(N, (b + 1) * bloco);
+        for (std::int64_t i = b * bloco; i < fim; ++i) {
+            formatar(texto, i, resolver_bhaskara(d.a[i], d.b[i], d.c[i]));
+        }
+        coletor.publicar(b);
+    }
+
+    coletor.finalizar();
+    return coletor.bytes_escritos();
+}
+
+bool arquivos_iguais(const char* x, const char* y) {
+    std::FILE* fx = std::fopen(x, "rb");
+    std::FILE* fy = std::fopen(y, "rb");
+    bool iguais = fx && fy;
+    std::vector<char> bx(1 << 16), by(1 << 16);
+    while (iguais) {
+        const std::size_t nx = std::fread(bx.data(), 1, bx.size(), fx);
+        const std::size_t ny = std::fread(by.data(), 1, by.size(), fy);
+        iguais = nx == ny && std::equal(bx.begin(), bx.begin() + nx, by.begin());
+        if (nx == 0) break;
+    }
+    if (fx) std::fclose(fx);
+    if (fy) std::fclose(fy);
+    return iguais;
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 2'000'000;
+    const std::string arquivo = (argc > 2) ? argv[2] : "012_saida_0.0.txt";
+    const std::string referencia = arquivo + ".ordered";
+    const std::int64_t BLOCO = 4096;
+
+    // equações variadas: umas com raízes reais, outras sem
+    Dados d;
+    d.a.resize(N); d.b.resize(N); d.c.resize(N);
+    #pragma omp parallel for
+    for (std::int64_t i = 0; i < N; ++i) {
+        d.a[i] = 1.0;
+        d.b[i] = -static_cast<double>(i % 100 + 3);
+        d.c[i] = static_cast<double>(i % 50);
+    }
+
+    std::cout << "Saida ordenada de " << N << " equacoes, threads = " << omp_get_max_threads() << "\n";
+
+    std::FILE* f = std::fopen(referencia.c_str(), "wb");
+    if (!f) { std::perror(referencia.c_str()); return 1; }
+    double t0 = omp_get_wtime();
+    com_ordered(d, f);
+    const double t_ordered = omp_get_wtime() - t0;
+    std::fclose(f);
+
+    f = std::fopen(arquivo.c_str(), "wb");
+    if (!f) { std::perror(arquivo.c_str()); return 1; }
+    t0 = omp_get_wtime();
+    const std::int64_t bytes = com_coletor(d, f, BLOCO);
+    const double t_coletor = omp_get_wtime() - t0;
+    std::fclose(f);
+
+    const bool iguais = arquivos_iguais(arquivo.c_str(), referencia.c_str());
+    std::remove(referencia.c_str());
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "#pragma omp ordered : " << t_ordered * 1e3 << " ms\n";
+    std::cout << "ColetorOrdenado     : " << t_coletor * 1e3 << " ms  ("
+              << std::setprecision(1) << static_cast<double>(bytes) / t_coletor / 1e6 << " MB/s)\n";
+    std::cout << "Saida em " << arquivo << ": " << (iguais ? "identica" : "DIFERENTE") << " a do ordered\n";
+
+    return iguais ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. As duas versões produzem o MESMO arquivo, byte a byte.
+
+2. Com ordered, o tempo praticamente não cai ao aumentar as threads:
+   formatar e escrever cada linha acontece em fila, uma iteração por vez.
+   Com o coletor, calcular e formatar escalam; só o fwrite é serial, e ele
+   escreve blocos grandes (centenas de KB) de uma vez.
+
+3. A janela J = 4 × threads limita a memória a J buffers de bloco. Se o
+   disco for mais lento que o cálculo, as threads esperam em reservar()
+   em vez de acumular o arquivo inteiro na RAM.
+
+4. O número de sequência (b + 1) na posição b % J dispensa limpar flags:
+   o valor antigo (b + 1 − J) nunca é confundido com o novo.
+
+5. Uso: ./012_saida_0.0 [N] [arquivo]
+*/
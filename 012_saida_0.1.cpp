@@ -0,0 +1,661 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 012_saida_0.1.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Thread-safe logger: per-thread lock-free rings, background flusher, deferred/binary formatting
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+
+/*---------------------------------------------------
+ Log de várias threads sem disputar o std::cout
+-----------------------------------------------------*/
+
+// 002_hello4t monta a linha num ostringstream e escreve dentro de
+// #pragma omp critical; 001_info e as funções de boot do 008_sections_0.1
+// escrevem direto no std::cout, e as linhas se misturam. Para algumas
+// mensagens tanto faz. Num laço quente (progresso por item, por bloco...)
+// o critical vira o gargalo: todas as threads fazem fila para formatar e
+// escrever, e cada escrita pode virar uma chamada ao sistema.
+
+/*---------------------------------------------------
+ Como o Logger funciona
+-----------------------------------------------------
+ 1) Cada thread tem o SEU anel (buffer circular) de registros de 64 bytes.
+    Um só produtor (a thread) e um só consumidor (a escritora): basta um
+    índice atômico de cada lado, sem lock.
+ 2) No laço quente a thread NÃO formata texto: guarda o ponteiro do formato,
+    os argumentos crus (inteiros, doubles, textos estáticos) e o instante.
+    Isso custa algumas dezenas de nanossegundos.
+ 3) Uma thread de fundo (escritora) esvazia os anéis, intercala o lote pelo
+    instante e então formata e escreve em blocos grandes. A ordem é exata
+    dentro de cada lote; uma thread que ficou parada entre a medição do
+    instante e a gravação no anel pode aparecer no lote seguinte.
+ 4) Modo BINARIO: nem a escritora formata. Ela grava os registros crus
+    (e cada formato uma única vez); o texto é gerado depois, fora do
+    programa, com  ./012_saida_0.1 decodificar arquivo.bin
+ 5) Memória limitada: cada anel tem capacidade fixa. Se encher,
+    BLOQUEAR espera a escritora abrir espaço; DESCARTAR conta e segue.
+
+ Formatos usam {} no lugar de cada argumento (até 4):
+     logger.log("bloco {} de {} pronto em {} ms", b, total, ms);
+ Textos passados como argumento devem ser estáticos (literais): o ponteiro
+ é lido depois, pela escritora.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <type_traits>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+
+enum class TipoArg : std::uint8_t { INTEIRO, NATURAL, REAL, TEXTO };
+
+union Valor {
+    std::int64_t  i;
+    std::uint64_t u;
+    double        d;
+    const char*   s;
+};
+
+// Um registro = uma mensagem ainda não formatada (cabe numa linha de cache)
+struct Registro {
+    std::uint64_t ns;          // instante desde a criação do logger
+    const char*   formato;
+    Valor         valores[4];
+    TipoArg       tipos[4];
+    std::uint16_t thread;
+    std::uint8_t  nargs;
+};
+static_assert(sizeof(Registro) <= 64, "Registro deve caber em uma linha de cache");
+
+template <typename T>
+void guardar(Registro& r, T v) {
+    const int k = r.nargs++;
+    if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+        r.tipos[k] = TipoArg::TEXTO;   r.valores[k].s = v;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        r.tipos[k] = TipoArg::REAL;    r.valores[k].d = static_cast<double>(v);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        r.tipos[k] = TipoArg::INTEIRO; r.valores[k].i = static_cast<std::int64_t>(v);
+    } else {
+        static_assert(std::is_integral_v<T>, "argumentos: inteiros, reais ou textos estáticos");
+        r.tipos[k] = TipoArg::NATURAL; r.valores[k].u = static_cast<std::uint64_t>(v);
+    }
+}
+
+/*---------------------------------------------------
+ Anel de um produtor e um consumidor
+-----------------------------------------------------*/
+class Anel {
+public:
+    Anel(std::size_t capacidade, std::uint16_t thread)
+        : registros_(capacidade), mascara_(capacidade - 1), thread_(thread) {}
+
+    std::uint16_t thread() const { return thread_; }
+
+    // Produtor (a própria thread)
+    bool tentar_colocar(const Registro& r) {
+        const std::uint64_t c = cabeca_.valor.load(std::memory_order_relaxed);
+        if (c - cauda_vista_ > mascara_) {
+            // parece cheio: só então lê a cauda de verdade (linha de cache da escritora)
+            cauda_vista_ = cauda_.valor.load(std::memory_order_acquire);
+            if (c - cauda_vista_ > mascara_) return false;
+        }
+        registros_[c & mascara_] = r;
+        cabeca_.valor.store(c + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor (a escritora): copia tudo o que está pronto para o lote
+    std::size_t retirar(std::vector<Registro>& lote) {
+        std::uint64_t t = cauda_.valor.load(std::memory_order_relaxed);
+        const std::uint64_t c = cabeca_.valor.load(std::memory_order_acquire);
+        const std::size_t n = static_cast<std::size_t>(c - t);
+        for (; t != c; ++t) lote.push_back(registros_[t & mascara_]);
+        cauda_.valor.store(c, std::memory_order_release);
+        return n;
+    }
+
+private:
+    std::vector<Registro>                     registros_;
+    std::uint64_t                             mascara_;
+    std::uint16_t                             thread_;
+    // cabeça e cauda em linhas separadas: cada uma é escrita por um lado só
+    LinhaPropria<std::atomic<std::uint64_t>>  cabeca_;
+    LinhaPropria<std::atomic<std::uint64_t>>  cauda_;
+    std::uint64_t                             cauda_vista_ = 0;   // cópia local do produtor
+};
+
+/*---------------------------------------------------
+ Formatação ({} -> próximo argumento)
+-----------------------------------------------------*/
+void anexar_valor(std::string& s, TipoArg tipo, const Valor& v) {
+    char num[32];
+    int n = 0;
+    switch (tipo) {
+        case TipoArg::INTEIRO: n = std::snprintf(num, sizeof(num), "%lld", static_cast<long long>(v.i)); break;
+        case TipoArg::NATURAL: n = std::snprintf(num, sizeof(num), "%llu", static_cast<unsigned long long>(v.u)); break;
+        case TipoArg::REAL:    n = std::snprintf(num, sizeof(num), "%.6g", v.d); break;
+        case TipoArg::TEXTO:   s += (v.s ? v.s : "(null)"); return;
+    }
+    s.append(num, static_cast<std::size_t>(n));
+}
+
+// Linha completa: "[    12.345678 ms] [T03] mensagem"
+void formatar(std::string& s, std::uint64_t ns, unsigned thread, const char* formato,
+              const TipoArg* tipos, const Valor* valores, unsigned nargs) {
+    char cabecalho[48];
+    const int n = std::snprintf(cabecalho, sizeof(cabecalho), "[%13.6f ms] [T%02u] ", ns / 1e6, thread);
+    s.append(cabecalho, static_cast<std::size_t>(n));
+    unsigned k = 0;
+    for (const char* p = formato; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && k < nargs) {
+            anexar_valor(s, tipos[k], valores[k]);
+            ++k;
+            ++p;
+        } else {
+            s += *p;
+        }
+    }
+    s += '\n';
+}
+
+/*---------------------------------------------------
+ O Logger
+-----------------------------------------------------*/
+class Logger {
+public:
+    enum class Modo { TEXTO, BINARIO };
+    enum class Politica { BLOQUEAR, DESCARTAR };
+
+    static constexpr int MAX_THREADS = 256;
+
+    Logger(std::FILE* saida, Modo modo = Modo::TEXTO, Politica politica = Politica::BLOQUEAR,
+           std::size_t capacidade_por_thread = 16384)
+        : saida_(saida), modo_(modo), politica_(politica),
+          capacidade_(potencia_de_dois(capacidade_por_thread)),
+          id_(proximo_id().fetch_add(1) + 1),
+          inicio_(std::chrono::steady_clock::now()) {
+        for (auto& a : aneis_) a.store(nullptr, std::memory_order_relaxed);
+        if (modo_ == Modo::BINARIO) std::fwrite("LOGBIN01", 1, 8, saida_);
+        escritora_ = std::thread([this] { laco_escritora(); });
+    }
+
+    // Para a escritora e esvazia o que restou
+    ~Logger() {
+        parar_.store(true, std::memory_order_release);
+        escritora_.join();
+        std::fflush(saida_);
+    }
+
+    template <typename... Args>
+    void log(const char* formato, Args... args) {
+        static_assert(sizeof...(Args) <= 4, "no máximo 4 argumentos");
+        Registro r;
+        r.ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - inicio_).count());
+        r.formato = formato;
+        r.nargs = 0;
+        (guardar(r, args), ...);
+
+        Anel& anel = meu_anel();
+        r.thread = anel.thread();
+        if (anel.tentar_colocar(r)) return;
+
+        if (politica_ == Politica::DESCARTAR) {
+            descartados_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        while (!anel.tentar_colocar(r)) std::this_thread::yield();
+    }
+
+    std::uint64_t descartados() const { return descartados_.load(); }
+    std::uint64_t escritos() const { return escritos_; }
+
+private:
+    static std::size_t potencia_de_dois(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    static std::atomic<std::uint64_t>& proximo_id() {
+        static std::atomic<std::uint64_t> id{0};
+        return id;
+    }
+
+    // Na primeira mensagem de cada thread cria o anel dela (único ponto com mutex).
+    // Cada thread guarda um mapa id do logger -> anel: com vários loggers ativos
+    // ao mesmo tempo, alternar entre eles não cria anéis novos. A chave é o id,
+    // não o endereço: um logger novo pode nascer no mesmo endereço de um que já
+    // foi destruído. O último par usado fica à parte para evitar a busca no
+    // mapa a cada mensagem.
+    Anel& meu_anel() {
+        thread_local std::uint64_t ultimo_dono = 0;
+        thread_local Anel* ultimo_anel = nullptr;
+        thread_local std::unordered_map<std::uint64_t, Anel*> meus_aneis;
+        if (ultimo_dono == id_) return *ultimo_anel;
+
+        Anel*& anel = meus_aneis[id_];
+        if (anel == nullptr) {
+            std::lock_guard<std::mutex> guarda(registro_);
+            const int id = static_cast<int>(donos_.size());
+            if (id >= MAX_THREADS) { std::fprintf(stderr, "Logger: threads demais\n"); std::abort(); }
+            donos_.push_back(std::make_unique<Anel>(capacidade_, static_cast<std::uint16_t>(omp_get_thread_num())));
+            anel = donos_.back().get();
+            aneis_[id].store(anel, std::memory_order_release);
+            num_aneis_.store(id + 1, std::memory_order_release);
+        }
+        ultimo_dono = id_;
+        ultimo_anel = anel;
+        return *anel;
+    }
+
+    void laco_escritora() {
+        std::vector<Registro> lote;
+        std::vector<std::size_t> fronteiras;   // início de cada trecho (um por anel) no lote
+        std::string texto;
+        for (;;) {
+            const bool ultima = parar_.load(std::memory_order_acquire);
+            lote.clear();
+            fronteiras.assign(1, 0);
+            const int n = num_aneis_.load(std::memory_order_acquire);
+            for (int k = 0; k < n; ++k) {
+                if (aneis_[k].load(std::memory_order_acquire)->retirar(lote)) fronteiras.push_back(lote.size());
+            }
+
+            if (!lote.empty()) {
+                // cada anel já vem em ordem de tempo: basta intercalar os trechos
+                intercalar(lote, fronteiras);
+                if (modo_ == Modo::TEXTO) escrever_texto(lote, texto);
+                else                      escrever_binario(lote, texto);
+                escritos_ += lote.size();
+            } else if (ultima) {
+                break;   // pediram para parar e não sobrou nada
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    }
+
+    // Intercala trechos ordenados dois a dois, como no merge sort: O(n log trechos)
+    static void intercalar(std::vector<Registro>& lote, std::vector<std::size_t>& fronteiras) {
+        const auto antes = [](const Registro& a, const Registro& b) { return a.ns < b.ns; };
+        while (fronteiras.size() > 2) {
+            std::size_t m = 0;
+            for (std::size_t k = 0; k + 2 < fronteiras.size(); k += 2) {
+                std::inplace_merge(lote.begin() + fronteiras[k], lote.begin() + fronteiras[k + 1],
+                                   lote.begin() + fronteiras[k + 2], antes);
+                fronteiras[m++] = fronteiras[k];
+            }
+            if (fronteiras.size() % 2 == 0) fronteiras[m++] = fronteiras[fronteiras.size() - 2];
+            fronteiras[m++] = fronteiras.back();
+            fronteiras.resize(m);
+        }
+    }
+
+    void escrever_texto(const std::vector<Registro>& lote, std::string& texto) {
+        texto.clear();
+        for (const Registro& r : lote) formatar(texto, r.ns, r.thread, r.formato, r.tipos, r.valores, r.nargs);
+        std::fwrite(texto.data(), 1, texto.size(), saida_);
+    }
+
+    // Binário: 'F' id tamanho bytes   (cada texto estático, uma vez)
+    //          'R' ns thread id_formato nargs {tipo valor}...
+    std::uint32_t id_texto(const char* s, std::string& saida) {
+        auto it = ids_.find(s);
+        if (it != ids_.end()) return it->second;
+        const std::uint32_t id = static_cast<std::uint32_t>(ids_.size());
+        const std::uint32_t len = static_cast<std::uint32_t>(std::strlen(s));
+        ids_.emplace(s, id);
+        saida += 'F';
+        saida.append(reinterpret_cast<const char*>(&id), 4);
+        saida.append(reinterpret_cast<const char*>(&len), 4);
+        saida.append(s, len);
+        return id;
+    }
+
+    void escrever_binario(const std::vector<Registro>& lote, std::string& dados) {
+        dados.clear();
+        for (const Registro& r : lote) {
+            const std::uint32_t fmt = id_texto(r.formato, dados);
+            std::uint64_t valores[4];
+            for (unsigned k = 0; k < r.nargs; ++k) {
+                valores[k] = (r.tipos[k] == TipoArg::TEXTO) ? id_texto(r.valores[k].s ? r.valores[k].s : "(null)", dados)
+                                                            : r.valores[k].u;
+            }
+            dados += 'R';
+            dados.append(reinterpret_cast<const char*>(&r.ns), 8);
+            dados.append(reinterpret_cast<const char*>(&r.thread), 2);
+            dados.append(reinterpret_cast<const char*>(&fmt), 4);
+            dados += static_cast<char>(r.nargs);
+            for (unsigned k = 0; k < r.nargs; ++k) {
+                dados += static_cast<char>(r.tipos[k]);
+                dados.append(reinterpret_cast<const char*>(&valores[k]), 8);
+            }
+        }
+        std::fwrite(dados.data(), 1, dados.size(), saida_);
+    }
+
+    std::FILE*                               saida_;
+    Modo                                     modo_;
+    Politica                                 politica_;
+    std::size_t                              capacidade_;
+    std::uint64_t                            id_;
+    std::chrono::steady_clock::time_point    inicio_;
+
+    std::mutex                               registro_;
+    std::vector<std::unique_ptr<Anel>>       donos_;
+    std::atomic<Anel*>                       aneis_[MAX_THREADS];
+    std::atomic<int>                         num_aneis_{0};
+
+    std::atomic<bool>                        parar_{false};
+    std::atomic<std::uint64_t>               descartados_{0};
+    std::uint64_t                            escritos_ = 0;   // só a escritora altera
+    std::unordered_map<const char*, std::uint32_t> ids_;      // só a escritora usa
+    std::thread                              escritora_;
+};
+
+/*---------------------------------------------------
+ Decodificador do modo binário (roda depois, fora do caminho crítico)
+-----------------------------------------------------*/
+std::int64_t decodificar(std::FILE* entrada, std::FILE* saida) {
+    char magica[8];
+    if (std::fread(magica, 1, 8, entrada) != 8 || std::memcmp(magica, "LOGBIN01", 8) != 0) return -1;
+
+    std::vector<std::string> textos;
+    std::string linha;
+    std::int64_t linhas = 0;
+    int tag;
+    while ((tag = std::fgetc(entrada)) != EOF) {
+        if (tag == 'F') {
+            std::uint32_t id, len;
+            if (std::fread(&id, 4, 1, entrada) != 1 || std::fread(&len, 4, 1, entrada) != 1) return -1;
+            std::string s(len, '\0');
+            if (len && std::fread(&s[0], 1, len, entrada) != len) return -1;
+            if (textos.size() <= id) textos.resize(id + 1);
+            textos[id] = std::move(s);
+        } else if (tag == 'R') {
+            std::uint64_t ns;
+            std::uint16_t thread;
+            std::uint32_t fmt;
+            if (std::fread(&ns, 8, 1, entrada) != 1 || std::fread(&thread, 2, 1, entrada) != 1 ||
+                std::fread(&fmt, 4, 1, entrada) != 1) return -1;
+            const int nargs = std::fgetc(entrada);
+            if (nargs < 0 || nargs > 4) return -1;
+            TipoArg tipos[4];
+            Valor valores[4];
+            for (int k = 0; k < nargs; ++k) {
+                tipos[k] = static_cast<TipoArg>(std::fgetc(entrada));
+                std::uint64_t bruto;
+                if (std::fread(&bruto, 8, 1, entrada) != 1) return -1;
+                if (tipos[k] == TipoArg::TEXTO) valores[k].s = textos.at(bruto).c_str();
+                else                            valores[k].u = bruto;
+            }
+            linha.clear();
+            formatar(linha, ns, thread, textos.at(fmt).c_str(), tipos, valores, static_cast<unsigned>(nargs));
+            std::fwrite(linha.data(), 1, linha.size(), saida);
+            ++linhas;
+        } else {
+            return -1;
+        }
+    }
+    return linhas;
+}
+
+/*---------------------------------------------------
+ Demonstração e medição
+-----------------------------------------------------*/
+// As funções de boot do 008_sections_0.1, agora registrando no logger (tempos menores)
+bool carregarBancoDeDados(Logger& log) {
+    log.log("Iniciando carregamento do Banco de Dados... (demora {} ms)", 200);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    log.log(">>> Banco de Dados CARREGADO.");
+    return true;
+}
+
+bool conectarServicoExterno(Logger& log) {
+    log.log("Iniciando conexão com API externa... (demora {} ms)", 150);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    log.log(">>> Conectado à API externa.");
+    return true;
+}
+
+bool inicializarCache(Logger& log) {
+    log.log("Iniciando inicialização do cache em memória... (demora {} ms)", 100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    log.log(">>> Cache PRONTO.");
+    return true;
+}
+
+bool lerArquivosDeConfiguracao(Logger& log) {
+    log.log("Iniciando leitura dos arquivos de configuração... (demora {} ms)", 50);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    log.log(">>> Configurações LIDAS.");
+    return true;
+}
+
+// Referência: o padrão do 002_hello4t (linha montada na thread + critical)
+double com_critical(std::FILE* saida, std::int64_t por_thread) {
+    const double t0 = omp_get_wtime();
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        std::string linha;
+        for (std::int64_t i = 0; i < por_thread; ++i) {
+            linha.clear();
+            const TipoArg tipos[3] = {TipoArg::INTEIRO, TipoArg::REAL, TipoArg::TEXTO};
+            Valor valores[3];
+            valores[0].i = i;
+            valores[1].d = i * 0.5;
+            valores[2].s = "ok";
+            formatar(linha, 0, static_cast<unsigned>(tid), "item {} processado, valor {} ({})", tipos, valores, 3);
+            #pragma omp critical
+            std::fwrite(linha.data(), 1, linha.size(), saida);
+        }
+    }
+    std::fflush(saida);
+    return omp_get_wtime() - t0;
+}
+
+double com_logger(std::FILE* saida, Logger::Modo modo, std::int64_t por_thread, double& t_produtores) {
+    const double t0 = omp_get_wtime();
+    {
+        Logger log(saida, modo);
+        #pragma omp parallel
+        {
+            for (std::int64_t i = 0; i < por_thread; ++i) {
+                log.log("item {} processado, valor {} ({})", i, i * 0.5, "ok");
+            }
+        }
+        t_produtores = omp_get_wtime() - t0;   // quando as threads de cálculo ficaram livres
+    }   // destrutor: escritora esvazia o resto
+    return omp_get_wtime() - t0;
+}
+
+std::int64_t contar_linhas(const char* arquivo) {
+    std::FILE* f = std::fopen(arquivo, "rb");
+    if (!f) return -1;
+    std::int64_t n = 0;
+    for (int ch; (ch = std::fgetc(f)) != EOF; ) n += (ch == '\n');
+    std::fclose(f);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "decodificar") == 0) {
+        if (argc < 3) { std::cerr << "Uso: " << argv[0] << " decodificar arquivo.bin\n"; return 1; }
+        std::FILE* f = std::fopen(argv[2], "rb");
+        if (!f) { std::perror(argv[2]); return 1; }
+        const std::int64_t n = decodificar(f, stdout);
+        std::fclose(f);
+        return n < 0 ? 2 : 0;
+    }
+
+    const std::int64_t MENSAGENS = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 2'000'000;
+    const std::string prefixo = (argc > 2) ? argv[2] : "012_saida_0.1";
+    const int T = omp_get_max_threads();
+    const std::int64_t por_thread = MENSAGENS / T;
+
+    // ---------------------------
+    // 1) Boot do 008_sections_0.1: linhas inteiras, em ordem de tempo
+    // ---------------------------
+    std::cout << "--- Boot com logger (stdout) ---\n" << std::flush;
+    {
+        Logger log(stdout);
+        #pragma omp parallel sections
+        {
+            #pragma omp section
+            carregarBancoDeDados(log);
+            #pragma omp section
+            conectarServicoExterno(log);
+            #pragma omp section
+            inicializarCache(log);
+            #pragma omp section
+            lerArquivosDeConfiguracao(log);
+        }
+    }
+
+    // ---------------------------
+    // 2) Laço quente: critical vs logger (texto e binário)
+    // ---------------------------
+    const std::string arq_critical = prefixo + "_critical.log";
+    const std::string arq_texto    = prefixo + ".log";
+    const std::string arq_binario  = prefixo + ".bin";
+
+    std::FILE* f = std::fopen(arq_critical.c_str(), "wb");
+    if (!f) { std::perror(arq_critical.c_str()); return 1; }
+    const double t_critical = com_critical(f, por_thread);
+    std::fclose(f);
+
+    double livre_texto = 0.0, livre_binario = 0.0;
+    f = std::fopen(arq_texto.c_str(), "wb");
+    if (!f) { std::perror(arq_texto.c_str()); return 1; }
+    const double t_texto = com_logger(f, Logger::Modo::TEXTO, por_thread, livre_texto);
+    std::fclose(f);
+
+    f = std::fopen(arq_binario.c_str(), "wb");
+    if (!f) { std::perror(arq_binario.c_str()); return 1; }
+    const double t_binario = com_logger(f, Logger::Modo::BINARIO, por_thread, livre_binario);
+    std::fclose(f);
+
+    // decodifica o binário para conferir
+    const std::string arq_decodificado = prefixo + "_bin.log";
+    std::FILE* fe = std::fopen(arq_binario.c_str(), "rb");
+    std::FILE* fs = std::fopen(arq_decodificado.c_str(), "wb");
+    const std::int64_t decodificadas = (fe && fs) ? decodificar(fe, fs) : -1;
+    if (fe) std::fclose(fe);
+    if (fs) std::fclose(fs);
+
+    const std::int64_t total = por_thread * T;
+    const bool ok = contar_linhas(arq_critical.c_str()) == total && contar_linhas(arq_texto.c_str()) == total
+                 && decodificadas == total;
+
+    auto mps = [&](double t) { return static_cast<double>(total) / t / 1e6; };
+    std::cout << "\n--- " << total << " mensagens, threads = " << T << " ---\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "                     | total (ms) | Mmsg/s total | threads livres em (ms) | Mmsg/s nas threads\n";
+    std::cout << " critical + fwrite   | " << std::setw(10) << t_critical * 1e3 << " | " << std::setw(12) << mps(t_critical)
+              << " | " << std::setw(22) << t_critical * 1e3 << " | " << std::setw(10) << mps(t_critical) << "\n";
+    std::cout << " logger texto        | " << std::setw(10) << t_texto * 1e3 << " | " << std::setw(12) << mps(t_texto)
+              << " | " << std::setw(22) << livre_texto * 1e3 << " | " << std::setw(10) << mps(livre_texto) << "\n";
+    std::cout << " logger binario      | " << std::setw(10) << t_binario * 1e3 << " | " << std::setw(12) << mps(t_binario)
+              << " | " << std::setw(22) << livre_binario * 1e3 << " | " << std::setw(10) << mps(livre_binario) << "\n";
+    std::cout << (ok ? "Todas as mensagens foram escritas (texto, critical e binario decodificado).\n"
+                     : "ERRO: numero de linhas diferente do esperado.\n");
+    std::cout << "Arquivos: " << arq_critical << ", " << arq_texto << ", " << arq_binario
+              << " (decodificado em " << arq_decodificado << ")\n";
+
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. No boot, cada linha sai inteira e na ordem em que aconteceu, mesmo
+   vindo de quatro threads; nenhuma delas tocou no stdout.
+
+2. "threads livres em": quando o laço de cálculo terminou. No logger isso
+   acontece bem antes do "total" — a escritora segue formatando em segundo
+   plano. No critical os dois números são iguais: quem calcula também
+   espera a vez de escrever.
+
+3. O modo binário é o mais barato para a escritora (não formata nada) e gera
+   arquivos menores; o texto é produzido depois com
+       ./012_saida_0.1 decodificar 012_saida_0.1.bin
+
+4. Com BLOQUEAR (padrão) nenhuma mensagem se perde: se a escritora ficar
+   para trás, a thread espera espaço no seu anel. Com DESCARTAR o laço
+   nunca espera, e logger.descartados() diz quantas mensagens caíram.
+   Em ambos, a memória é no máximo capacidade × 64 bytes por thread.
+
+5. Com um único núcleo o logger em modo texto não ganha do critical: a
+   escritora divide o núcleo com as threads de cálculo e a formatação é a
+   mesma. O ganho aparece quando há um núcleo livre para a escritora — ou
+   no modo binário, em que quase não há trabalho a fazer durante a execução.
+
+6. Uso: ./012_saida_0.1 [mensagens] [prefixo dos arquivos]
+        ./012_saida_0.1 decodificar arquivo.bin
+*/
@@ -0,0 +1,439 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 013_pool_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Persistent thread pool with spin/yield/sleep/hybrid wait policy vs fresh omp parallel regions
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Lotes pequenos: o custo de ABRIR a região paralela
+-----------------------------------------------------
+ Todos os exemplos abrem um "#pragma omp parallel" novo a cada chamada. Com
+ vetores de milhões de elementos isso não aparece. Mas um serviço que chama
+ o mesmo kernel milhares de vezes por segundo, com lotes de poucos milhares
+ de elementos, paga a cada chamada:
+   - acordar as threads do time (se estiverem dormindo, isso é o kernel do
+     sistema operacional agendando cada uma: dezenas de microssegundos);
+   - a barreira do fim da região.
+
+ O runtime do OpenMP já mantém as threads vivas entre regiões; o que muda é
+ como elas ESPERAM entre uma região e outra (OMP_WAIT_POLICY):
+   active  : giram (respondem rápido, gastam CPU)
+   passive : dormem (economizam CPU, demoram a acordar)
+   (padrão): giram um pouco e depois dormem (GOMP_SPINCOUNT no GCC)
+
+ Aqui a mesma escolha fica explícita num Pool persistente, por objeto:
+
+   Pool pool(8, Pool::Espera::HIBRIDA);
+   pool.paralelo_para(n, [&](std::int64_t ini, std::int64_t fim) {
+       for (std::int64_t i = ini; i < fim; ++i) z[i] = a * x[i] + y[i];
+   });
+
+ Políticas de espera do Pool:
+   GIRAR   : laço com pause — menor latência, um núcleo a 100% por thread
+   CEDER   : laço com yield — cede o núcleo se houver outra thread pronta
+   DORMIR  : variável de condição — zero CPU parado, acordar custa caro
+   HIBRIDA : gira 'giros' vezes e depois dorme (o padrão do libgomp)
+
+ A thread que chama participa como thread 0 (como a thread mestre do OpenMP).
+
+ A medição compara, por chamada, a região "#pragma omp parallel for" nova com
+ o Pool em cada política, para lotes de vários tamanhos. Sem OMP_WAIT_POLICY
+ definida, o programa se reexecuta três vezes (padrão, active, passive).
+
+ Uso: ./013_pool_0.0 [--threads=4] [--repeticoes=N]
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+#include "ambiente_omp.hpp"
+
+inline void pausa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/*---------------------------------------------------
+ Pool persistente
+-----------------------------------------------------*/
+class Pool {
+public:
+    enum class Espera { GIRAR, CEDER, DORMIR, HIBRIDA };
+
+    explicit Pool(int threads = omp_get_max_threads(), Espera espera = Espera::HIBRIDA, int giros = 20000)
+        : threads_(std::max(1, threads)), espera_(espera),
+          // Mais threads que núcleos: girar só atrasa quem está trabalhando, então
+          // HIBRIDA dorme direto (o libgomp faz o mesmo com GOMP_SPINCOUNT)
+          giros_(superlotado(threads_) ? 0 : giros) {
+        for (int t = 1; t < threads_; ++t) trabalhadores_.emplace_back([this, t] { laco_trabalhador(t); });
+    }
+
+    ~Pool() {
+        parar_.store(true);
+        geracao_.valor.fetch_add(1);
+        acordar(m_trabalho_, cv_trabalho_, dormindo_trabalho_.valor);
+        for (auto& t : trabalhadores_) t.join();
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    int threads() const { return threads_; }
+
+    static bool superlotado(int threads) {
+        const unsigned nucleos = std::thread::hardware_concurrency();   // 0 = desconhecido
+        return nucleos != 0 && threads > static_cast<int>(nucleos);
+    }
+
+    // Executa f(tid, threads) em todas as threads do pool (a chamadora é a 0)
+    // e só retorna quando todas terminarem. f não deve lançar exceções.
+    template <typename F>
+    void paralelo(F&& f) {
+        using Funcao = std::remove_reference_t<F>;
+        if (threads_ == 1) { f(0, 1); return; }
+
+        tarefa_ = [](void* contexto, int tid, int T) { (*static_cast<Funcao*>(contexto))(tid, T); };
+        contexto_ = const_cast<void*>(static_cast<const void*>(&f));
+        restantes_.valor.store(threads_ - 1, std::memory_order_relaxed);
+        geracao_.valor.fetch_add(1);   // publica tarefa_ e contexto_ (seq_cst)
+        acordar(m_trabalho_, cv_trabalho_, dormindo_trabalho_.valor);
+
+        f(0, threads_);
+
+        esperar([this] { return restantes_.valor.load() == 0; }, m_fim_, cv_fim_, dormindo_fim_.valor);
+    }
+
+    // Divide [0, n) em blocos contíguos iguais, como schedule(static)
+    template <typename Corpo>
+    void paralelo_para(std::int64_t n, Corpo&& corpo) {
+        paralelo([&](int tid, int T) {
+            const std::int64_t ini = n * tid / T;
+            const std::int64_t fim = n * (tid + 1) / T;
+            if (ini < fim) corpo(ini, fim);
+        });
+    }
+
+private:
+    void laco_trabalhador(int tid) {
+        std::uint64_t vista = 0;
+        for (;;) {
+            esperar([&] { return geracao_.valor.load() != vista; }, m_trabalho_, cv_trabalho_, dormindo_trabalho_.valor);
+            vista = geracao_.valor.load();
+            if (parar_.load()) return;
+            tarefa_(contexto_, tid, threads_);
+            if (restantes_.valor.fetch_sub(1) == 1) acordar(m_fim_, cv_fim_, dormindo_fim_.valor);
+        }
+    }
+
+    // Espera pronto() conforme a política. Quem vai dormir se anuncia em
+    // 'dormindo' antes de conferir a condição de novo (sob o mutex); quem
+    // muda a condição a altera antes de ler 'dormindo'. Com operações seq_cst,
+    // pelo menos um dos dois enxerga o outro: nenhum aviso se perde.
+    template <typename Pronto>
+    void esperar(Pronto pronto, std::mutex& m, std::condition_variable& cv, std::atomic<int>& dormindo) {
+        if (espera_ != Espera::DORMIR) {
+            for (int k = 0;; ++k) {
+                if (pronto()) return;
+                if (espera_ == Espera::HIBRIDA && k >= giros_) break;
+                if (espera_ == Espera::CEDER) std::this_thread::yield();
+                else pausa();
+            }
+        }
+        std::unique_lock<std::mutex> lk(m);
+        dormindo.fetch_add(1);
+        cv.wait(lk, pronto);
+        dormindo.fetch_sub(1);
+    }
+
+    static void acordar(std::mutex& m, std::condition_variable& cv, std::atomic<int>& dormindo) {
+        if (dormindo.load() > 0) {
+            std::lock_guard<std::mutex> guarda(m);
+            cv.notify_all();
+        }
+    }
+
+    const int                           threads_;
+    const Espera                        espera_;
+    const int                           giros_;
+    std::vector<std::thread>            trabalhadores_;
+
+    void (*tarefa_)(void*, int, int) = nullptr;   // sem std::function: nenhuma alocação por chamada
+    void* contexto_ = nullptr;
+
+    // Escritos por lados diferentes: cada um na sua linha de cache
+    LinhaPropria<std::atomic<std::uint64_t>> geracao_;          // muda a cada chamada
+    LinhaPropria<std::atomic<int>>           restantes_;        // trabalhadores ainda ocupados
+    LinhaPropria<std::atomic<int>>           dormindo_trabalho_;
+    LinhaPropria<std::atomic<int>>           dormindo_fim_;
+    std::atomic<bool>                        parar_{false};
+
+    std::mutex              m_trabalho_, m_fim_;
+    std::condition_variable cv_trabalho_, cv_fim_;
+};
+
+const char* nome_espera(Pool::Espera e) {
+    switch (e) {
+        case Pool::Espera::GIRAR:  return "girar";
+        case Pool::Espera::CEDER:  return "ceder";
+        case Pool::Espera::DORMIR: return "dormir";
+        default:                   return "hibrida";
+    }
+}
+
+/*---------------------------------------------------
+ Kernels (lotes pequenos, chamados muitas vezes)
+-----------------------------------------------------*/
+// Expressão vetorial: z = a*x + y
+struct Lote {
+    std::vector<double> x, y, z;
+    explicit Lote(std::int64_t n) : x(n), y(n), z(n) {
+        for (std::int64_t i = 0; i < n; ++i) { x[i] = 0.5 * (i % 100); y[i] = 1.0 + (i % 7); }
+    }
+};
+
+void vetor_omp(Lote& l, int T) {
+    const std::int64_t n = static_cast<std::int64_t>(l.x.size());
+    const double* x = l.x.data(); const double* y = l.y.data(); double* z = l.z.data();
+    #pragma omp parallel for num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) z[i] = 2.5 * x[i] + y[i];
+}
+
+void vetor_pool(Lote& l, Pool& pool) {
+    const double* x = l.x.data(); const double* y = l.y.data(); double* z = l.z.data();
+    pool.paralelo_para(static_cast<std::int64_t>(l.x.size()), [=](std::int64_t ini, std::int64_t fim) {
+        for (std::int64_t i = ini; i < fim; ++i) z[i] = 2.5 * x[i] + y[i];
+    });
+}
+
+// Redução: soma de z (parciais por thread, sem false sharing)
+double soma_omp(const Lote& l, int T) {
+    const std::int64_t n = static_cast<std::int64_t>(l.z.size());
+    const double* z = l.z.data();
+    double s = 0.0;
+    #pragma omp parallel for num_threads(T) schedule(static) reduction(+:s)
+    for (std::int64_t i = 0; i < n; ++i) s += z[i];
+    return s;
+}
+
+double soma_pool(const Lote& l, Pool& pool, PerThread<double>& parciais) {
+    const double* z = l.z.data();
+    const std::int64_t n = static_cast<std::int64_t>(l.z.size());
+    pool.paralelo([&](int tid, int T) {
+        double s = 0.0;
+        for (std::int64_t i = n * tid / T; i < n * (tid + 1) / T; ++i) s += z[i];
+        parciais[tid] = s;
+    });
+    return parciais.soma();
+}
+
+/*---------------------------------------------------
+ Medição
+-----------------------------------------------------*/
+// Microssegundos por chamada (kernel vetorial seguido da redução)
+template <typename F>
+double us_por_chamada(F&& chamada, int repeticoes, double& checagem) {
+    for (int r = 0; r < std::min(repeticoes, 100); ++r) checagem = chamada();   // aquecimento
+    const double t0 = omp_get_wtime();
+    for (int r = 0; r < repeticoes; ++r) checagem = chamada();
+    return (omp_get_wtime() - t0) * 1e6 / repeticoes;
+}
+
+bool opcao(const char* arg, const char* nome, std::string& valor) {
+    const std::size_t len = std::strlen(nome);
+    if (std::strncmp(arg, nome, len) != 0 || arg[len] != '=') return false;
+    valor = arg + len + 1;
+    return true;
+}
+
+// Sem OMP_WAIT_POLICY definida: roda uma cópia do programa para cada política
+// (só no Linux; nos demais sistemas mede apenas o ambiente atual).
+// Devolve -1 se este processo deve medir ele mesmo; senão, o código de saída
+// do programa: 0 só se todas as cópias terminaram normalmente com 0.
+int rodar_filhos(char* argv[]) {
+    if (std::getenv("OMP_WAIT_POLICY") || std::getenv("AULAS_OMP_REEXEC")) return -1;
+#if defined(__linux__)
+    const char* politicas[] = {nullptr, "active", "passive"};
+    int codigo = 0;
+    for (const char* p : politicas) {
+        std::cout.flush();
+        const int rc = rodar_copia(argv, "OMP_WAIT_POLICY", p);
+        if (rc == 0) continue;
+        std::cerr << "ERRO: copia com OMP_WAIT_POLICY = " << (p ? p : "(padrao)");
+        if (rc < 0)        std::cerr << " nao foi criada ou nao terminou normalmente\n";
+        else if (rc > 128) std::cerr << " morreu com o sinal " << rc - 128 << "\n";
+        else               std::cerr << " terminou com codigo " << rc << "\n";
+        codigo = 1;
+    }
+    return codigo;
+#else
+    (void)argv;
+    std::cerr << "[aviso] rode de novo com OMP_WAIT_POLICY=active e OMP_WAIT_POLICY=passive para comparar\n";
+    return -1;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    int threads = omp_get_max_threads();
+    int repeticoes = 0;   // 0 = automático pelo tamanho do lote
+    for (int k = 1; k < argc; ++k) {
+        std::string v;
+        if      (opcao(argv[k], "--threads", v))    threads = std::max(1, std::atoi(v.c_str()));
+        else if (opcao(argv[k], "--repeticoes", v)) repeticoes = std::max(1, std::atoi(v.c_str()));
+        else {
+            std::cerr << "Argumento desconhecido: " << argv[k] << "\n";
+            return 1;
+        }
+    }
+
+    const int codigo_filhos = rodar_filhos(argv);
+    if (codigo_filhos >= 0) return codigo_filhos;
+
+    const char* wait_policy = std::getenv("OMP_WAIT_POLICY");
+    const int nucleos = static_cast<int>(std::thread::hardware_concurrency());
+    std::cout << "\n=== OMP_WAIT_POLICY = " << (wait_policy ? wait_policy : "(padrao)")
+              << ", threads = " << threads << ", nucleos = " << nucleos << " ===\n";
+    std::cout << "microssegundos por chamada (vetor z = a*x + y seguido da soma de z)\n";
+    std::cout << "-----------------------------------------------------------------------------------------\n";
+    std::cout << "       n |   serial | omp parallel |  pool girar |  pool ceder | pool dormir | pool hibrida\n";
+    std::cout << "-----------------------------------------------------------------------------------------\n";
+
+    const Pool::Espera esperas[] = {Pool::Espera::GIRAR, Pool::Espera::CEDER, Pool::Espera::DORMIR, Pool::Espera::HIBRIDA};
+    bool ok = true;
+    for (std::int64_t n : {0LL, 1024LL, 16384LL, 262144LL}) {
+        Lote lote(n);
+        const int R = repeticoes ? repeticoes : static_cast<int>(std::max<std::int64_t>(100, 200'000'000 / (n + 10'000)));
+
+        double ref = 0.0;
+        const double t_serial = us_por_chamada([&] {
+            const double* x = lote.x.data(); const double* y = lote.y.data(); double* z = lote.z.data();
+            for (std::int64_t i = 0; i < n; ++i) z[i] = 2.5 * x[i] + y[i];
+            double s = 0.0;
+            for (std::int64_t i = 0; i < n; ++i) s += z[i];
+            return s;
+        }, R, ref);
+
+        // Pool primeiro: com OMP_WAIT_POLICY=active as threads do OpenMP
+        // continuariam girando depois das regiões e atrapalhariam o pool.
+        double t_pool[4];
+        for (int e = 0; e < 4; ++e) {
+            // Girar com mais threads que núcleos: quem espera ocupa o núcleo de quem trabalha
+            if (esperas[e] == Pool::Espera::GIRAR && Pool::superlotado(threads)) { t_pool[e] = -1.0; continue; }
+            Pool pool(threads, esperas[e]);
+            PerThread<double> parciais(threads);
+            double s = 0.0;
+            t_pool[e] = us_por_chamada([&] { vetor_pool(lote, pool); return soma_pool(lote, pool, parciais); }, R, s);
+            ok = ok && std::abs(s - ref) <= 1e-9 * std::abs(ref);
+        }
+
+        double s_omp = 0.0;
+        const double t_omp = us_por_chamada([&] { vetor_omp(lote, threads); return soma_omp(lote, threads); }, R, s_omp);
+        ok = ok && std::abs(s_omp - ref) <= 1e-9 * std::abs(ref);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << " " << std::setw(7) << n << " | " << std::setw(8) << t_serial << " | " << std::setw(12) << t_omp;
+        for (int e = 0; e < 4; ++e) {
+            std::cout << " | " << std::setw(11 + (e == 3));
+            if (t_pool[e] < 0) std::cout << "-";
+            else std::cout << t_pool[e];
+        }
+        std::cout << "\n";
+    }
+    std::cout << "-----------------------------------------------------------------------------------------\n";
+    if (Pool::superlotado(threads)) std::cout << "(pool girar omitido: mais threads que nucleos)\n";
+    std::cout << (ok ? "Resultados conferidos com a versao serial.\n" : "ERRO: resultados diferentes da versao serial.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. n = 0 mede só o custo de abrir e fechar: duas regiões (vetor + soma) por
+   chamada. Com threads girando (pool girar/hibrida, omp active) isso fica em
+   poucos microssegundos; com threads dormindo (pool dormir, omp passive),
+   em dezenas — o custo de o sistema operacional acordar cada thread.
+
+2. Em lotes de 1024 elementos o trabalho é menor que a abertura da região:
+   a versão serial ganha de todas. Em 16384 o pool girando já compensa, a
+   região nova com threads dormindo ainda não. Em 262144 todas empatam:
+   o custo fixo some diante do trabalho.
+
+3. HIBRIDA fica perto de GIRAR quando as chamadas vêm seguidas (a próxima
+   chega antes de os giros acabarem) e perto de DORMIR quando o serviço
+   fica ocioso — sem ocupar os núcleos à toa. É o mesmo compromisso do
+   padrão do libgomp; GOMP_SPINCOUNT ajusta quanto o OpenMP gira.
+
+4. GIRAR com mais threads que núcleos é desastroso: a thread que espera
+   ocupa o núcleo que a thread que trabalha precisaria. Por isso é omitido
+   nesse caso, e a HIBRIDA deixa de girar (dorme direto) quando o pool tem
+   mais threads que núcleos.
+
+5. Num serviço real, um único Pool (ou um único time OpenMP) deve ser usado
+   por todos os kernels: dois grupos de threads girando ao mesmo tempo
+   disputam os mesmos núcleos.
+*/
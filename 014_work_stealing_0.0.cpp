@@ -0,0 +1,477 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 014_work_stealing_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Work-stealing range scheduler (per-thread deques, splittable ranges) vs static/dynamic/guided
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Roubo de trabalho (work stealing)
+-----------------------------------------------------
+ No 006_sincronizacao_0.6 metade das equações tem raízes reais e metade não.
+ Com o Bhaskara puro o custo por equação é quase o mesmo. Quando acrescentamos
+ refinamento das raízes (Newton) ou saída complexa, o custo por item passa a
+ variar MUITO — e não sabemos de antemão onde estão os itens caros.
+
+   schedule(static)  : cada thread recebe n/T itens fixos. Se os caros caírem
+                       num só bloco, as outras threads ficam paradas esperando.
+   schedule(dynamic) : cada thread pega 'grão' itens de um contador global.
+                       Equilibra, mas todo pedaço passa pelo mesmo contador.
+   schedule(guided)  : pedaços grandes no começo, pequenos no fim. Ruim se os
+                       itens caros estiverem no começo.
+
+ O escalonador daqui (EscalonadorRoubo):
+   1) cada thread começa com o seu bloco estático, numa DEQUE só dela;
+   2) a dona trabalha pela base da deque: enquanto a faixa for maior que o
+      grão, divide ao meio, guarda a metade de cima na deque e segue com a
+      de baixo (divisão preguiçosa);
+   3) quem fica sem trabalho ROUBA do topo da deque de outra thread — a faixa
+      mais antiga, que é a maior. Um roubo leva muito trabalho de uma vez.
+ Sem desequilíbrio ninguém rouba: o custo é o de um static. Com desequilíbrio
+ o trabalho migra para quem está livre, sem contador global.
+
+ Uso dentro de uma região paralela, como um "omp for nowait":
+
+   EscalonadorRoubo esc(n, 256);
+   #pragma omp parallel
+   {
+       esc.executar([&](std::int64_t ini, std::int64_t fim) { ... });
+   }
+
+ ou pelas funções prontas para_roubando(n, grao, corpo) e
+ reduzir_roubando(n, grao, inicial, parcial, combinar).
+
+ Uso: ./014_work_stealing_0.0 [N >= 1]
+*/
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#include <iomanip>
+#include "per_thread.hpp"
+
+inline void pausa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+struct Faixa {
+    std::int64_t ini;
+    std::int64_t fim;
+};
+
+/*---------------------------------------------------
+ Escalonador
+-----------------------------------------------------*/
+class EscalonadorRoubo {
+public:
+    EscalonadorRoubo(std::int64_t n, std::int64_t grao, int max_threads = omp_get_max_threads())
+        : n_(n), grao_(std::max<std::int64_t>(1, grao)), deques_(std::max(1, max_threads)) {
+        for (auto& d : deques_) omp_init_lock(&d.valor.lock);
+        restantes_.valor.store(n_);
+    }
+
+    ~EscalonadorRoubo() {
+        for (auto& d : deques_) omp_destroy_lock(&d.valor.lock);
+    }
+
+    EscalonadorRoubo(const EscalonadorRoubo&) = delete;
+    EscalonadorRoubo& operator=(const EscalonadorRoubo&) = delete;
+
+    // Chamado por TODAS as threads do time. Sem barreira no fim (como nowait).
+    // Cada escalonador percorre [0, n) uma única vez.
+    template <typename Corpo>
+    void executar(Corpo&& corpo) {
+        const int tid = omp_get_thread_num();
+        const int T = std::min(omp_get_num_threads(), static_cast<int>(deques_.size()));
+        if (tid < T) empilhar(tid, {n_ * tid / T, n_ * (tid + 1) / T});
+        // Ninguém rouba antes de todas as deques receberem o seu bloco inicial
+        #pragma omp barrier
+        if (tid >= T) return;   // time maior que o escalonador: a thread só assiste
+
+        std::uint64_t semente = 0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(tid + 1);
+        int falhas = 0;
+        for (;;) {
+            Faixa f;
+            if (!desempilhar(tid, f) && !roubar(tid, T, semente, f)) {
+                if (restantes_.valor.load(std::memory_order_acquire) == 0) return;
+                // alguém ainda está com a última faixa: espera e tenta de novo
+                pausa();
+                if (++falhas % 64 == 0) std::this_thread::yield();
+                continue;
+            }
+            falhas = 0;
+            while (f.fim - f.ini > grao_) {
+                const std::int64_t meio = f.ini + (f.fim - f.ini) / 2;
+                empilhar(tid, {meio, f.fim});
+                f.fim = meio;
+            }
+            corpo(f.ini, f.fim);
+            restantes_.valor.fetch_sub(f.fim - f.ini, std::memory_order_acq_rel);
+        }
+    }
+
+    std::int64_t roubos() const { return roubos_.valor.load(); }
+
+private:
+    struct Deque {
+        omp_lock_t         lock;
+        std::deque<Faixa>  faixas;       // base = back (dona), topo = front (ladrões)
+        std::atomic<int>   tamanho{0};   // cópia de faixas.size() para espiar sem o lock
+    };
+
+    void empilhar(int tid, Faixa f) {
+        Deque& d = deques_[tid].valor;
+        omp_set_lock(&d.lock);
+        d.faixas.push_back(f);
+        d.tamanho.store(static_cast<int>(d.faixas.size()), std::memory_order_relaxed);
+        omp_unset_lock(&d.lock);
+    }
+
+    bool desempilhar(int tid, Faixa& f) {
+        Deque& d = deques_[tid].valor;
+        omp_set_lock(&d.lock);
+        const bool tem = !d.faixas.empty();
+        if (tem) {
+            f = d.faixas.back();
+            d.faixas.pop_back();
+            d.tamanho.store(static_cast<int>(d.faixas.size()), std::memory_order_relaxed);
+        }
+        omp_unset_lock(&d.lock);
+        return tem;
+    }
+
+    // Tenta as outras threads a partir de uma vítima aleatória
+    bool roubar(int tid, int T, std::uint64_t& semente, Faixa& f) {
+        if (T == 1) return false;
+        semente ^= semente << 13; semente ^= semente >> 7; semente ^= semente << 17;   // xorshift64
+        const int inicio = static_cast<int>(semente % static_cast<std::uint64_t>(T));
+        for (int k = 0; k < T; ++k) {
+            const int vitima = (inicio + k) % T;
+            if (vitima == tid) continue;
+            Deque& d = deques_[vitima].valor;
+            if (d.tamanho.load(std::memory_order_relaxed) == 0) continue;   // só uma dica, conferida abaixo
+            omp_set_lock(&d.lock);
+            const bool tem = !d.faixas.empty();
+            if (tem) {
+                f = d.faixas.front();
+                d.faixas.pop_front();
+                d.tamanho.store(static_cast<int>(d.faixas.size()), std::memory_order_relaxed);
+            }
+            omp_unset_lock(&d.lock);
+            if (tem) {
+                roubos_.valor.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::int64_t                        n_;
+    const std::int64_t                        grao_;
+    std::vector<LinhaPropria<Deque>>          deques_;
+    LinhaPropria<std::atomic<std::int64_t>>   restantes_;
+    LinhaPropria<std::atomic<std::int64_t>>   roubos_;
+};
+
+// Laço paralelo completo: abre a região, percorre [0, n) e espera todas as threads
+template <typename Corpo>
+void para_roubando(std::int64_t n, std::int64_t grao, Corpo&& corpo) {
+    EscalonadorRoubo esc(n, grao);
+    #pragma omp parallel
+    esc.executar(corpo);
+}
+
+// Redução: parcial(ini, fim) devolve o resultado de uma faixa; combinar junta dois
+template <typename T, typename Parcial, typename Combinar>
+T reduzir_roubando(std::int64_t n, std::int64_t grao, T inicial, Parcial parcial, Combinar combinar) {
+    EscalonadorRoubo esc(n, grao);
+    PerThread<T> acumulado(omp_get_max_threads(), inicial);
+    #pragma omp parallel
+    {
+        T& meu = acumulado.local();
+        esc.executar([&](std::int64_t ini, std::int64_t fim) { meu = combinar(meu, parcial(ini, fim)); });
+    }
+    return acumulado.combinar(inicial, combinar);
+}
+
+/*---------------------------------------------------
+ O kernel: Bhaskara com refinamento de Newton
+-----------------------------------------------------
+ iteracoes[i] = quantas vezes refinar as raízes da equação i (o "custo").
+ Sem raízes reais, a saída é a parte real e a imaginária.
+*/
+struct Lote {
+    std::vector<double> a, b, c, x1, x2;
+    std::vector<int>    iteracoes;
+    explicit Lote(std::int64_t n) : a(n, 1.0), b(n), c(n), x1(n), x2(n), iteracoes(n) {
+        for (std::int64_t i = 0; i < n; ++i) {
+            b[i] = (i % 2 == 0) ? -7.0 : 2.0;   // mesmo padrão do 006_sincronizacao_0.6
+            c[i] = (i % 2 == 0) ? 10.0 : 5.0;
+        }
+    }
+};
+
+inline double refinar(double a, double b, double c, double x, int k) {
+    for (int j = 0; j < k; ++j) {
+        const double d = 2 * a * x + b;
+        if (d == 0.0) break;
+        x -= (a * x * x + b * x + c) / d;
+    }
+    return x;
+}
+
+inline void resolver(Lote& l, std::int64_t i) {
+    const double a = l.a[i], b = l.b[i], c = l.c[i];
+    const double delta = b * b - 4 * a * c;
+    const int k = l.iteracoes[i];
+    if (delta < 0) {
+        // raízes complexas: x = re ± i·im (o refinamento aqui só multiplica o custo)
+        double im = std::sqrt(-delta) / (2 * a);
+        for (int j = 0; j < k; ++j) im = 0.5 * (im + (-delta / (4 * a * a)) / im);
+        l.x1[i] = -b / (2 * a);
+        l.x2[i] = im;
+        return;
+    }
+    const double raiz = std::sqrt(delta);
+    l.x1[i] = refinar(a, b, c, (-b + raiz) / (2 * a), k);
+    l.x2[i] = refinar(a, b, c, (-b - raiz) / (2 * a), k);
+}
+
+/*---------------------------------------------------
+ Cargas de trabalho (custo por item)
+-----------------------------------------------------*/
+std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void preparar_carga(Lote& l, int carga) {
+    const std::int64_t n = static_cast<std::int64_t>(l.iteracoes.size());
+    for (std::int64_t i = 0; i < n; ++i) {
+        int k = 0;
+        switch (carga) {
+            case 0: k = 8; break;                                             // uniforme
+            case 1: k = (i % 2 == 0) ? 16 : 0; break;                         // alternado (006_0.6)
+            case 2: k = static_cast<int>(64 * i / n); break;                  // rampa
+            case 3: k = (i >= n / 10 && i < n / 10 + n / 100) ? 1200 : 4; break;   // 1% concentrado
+            default: {                                                        // cauda pesada
+                const double u = (splitmix64(static_cast<std::uint64_t>(i)) >> 11) * 0x1.0p-53;
+                k = static_cast<int>(std::min(4000.0, 2.0 / std::pow(u + 1e-12, 0.7)));
+            }
+        }
+        l.iteracoes[i] = k;
+    }
+}
+
+const char* nome_carga(int carga) {
+    static const char* nomes[] = {"uniforme", "alternado", "rampa", "1% concentrado", "cauda pesada"};
+    return nomes[carga];
+}
+
+/*---------------------------------------------------
+ Medição
+-----------------------------------------------------*/
+enum class Escalonamento { STATIC, DYNAMIC, GUIDED, ROUBO };
+
+struct Resultado {
+    double tempo = 0.0;
+    double desequilibrio = 0.0;   // maior tempo ocupado de thread / média (1.0 = perfeito)
+    double soma = 0.0;
+};
+
+constexpr std::int64_t GRAO = 256;
+
+Resultado rodar(Lote& l, Escalonamento e) {
+    const std::int64_t n = static_cast<std::int64_t>(l.a.size());
+    PerThread<double> ocupada;   // tempo de cada thread DENTRO do corpo (sem esperas)
+    Resultado r;
+
+    // Mesmo corpo para os quatro escalonamentos: uma faixa de até GRAO itens
+    auto corpo = [&](std::int64_t ini, std::int64_t fim) {
+        const double inicio = omp_get_wtime();
+        for (std::int64_t i = ini; i < fim; ++i) resolver(l, i);
+        ocupada.local() += omp_get_wtime() - inicio;
+    };
+    // omp for sobre faixas de GRAO itens: static = blocos contíguos por thread,
+    // dynamic/guided com tamanho 1 em faixas = dynamic/guided(GRAO) em itens
+    const std::int64_t faixas = (n + GRAO - 1) / GRAO;
+    auto faixa = [&](std::int64_t f) { corpo(f * GRAO, std::min(n, (f + 1) * GRAO)); };
+
+    const double t0 = omp_get_wtime();
+    if (e == Escalonamento::ROUBO) {
+        EscalonadorRoubo esc(n, GRAO);
+        #pragma omp parallel
+        esc.executar(corpo);
+    } else {
+        #pragma omp parallel
+        {
+            switch (e) {
+                case Escalonamento::STATIC:
+                    #pragma omp for schedule(static) nowait
+                    for (std::int64_t f = 0; f < faixas; ++f) faixa(f);
+                    break;
+                case Escalonamento::DYNAMIC:
+                    #pragma omp for schedule(dynamic, 1) nowait
+                    for (std::int64_t f = 0; f < faixas; ++f) faixa(f);
+                    break;
+                default:
+                    #pragma omp for schedule(guided, 1) nowait
+                    for (std::int64_t f = 0; f < faixas; ++f) faixa(f);
+            }
+        }
+    }
+    r.tempo = omp_get_wtime() - t0;
+
+    const double maior = ocupada.combinar(0.0, [](double a, double b) { return std::max(a, b); });
+    r.desequilibrio = maior / (ocupada.soma() / ocupada.size());
+
+    // Redução com o mesmo escalonador (soma das raízes)
+    r.soma = reduzir_roubando(n, 4096, 0.0,
+        [&](std::int64_t ini, std::int64_t fim) {
+            double s = 0.0;
+            for (std::int64_t i = ini; i < fim; ++i) s += l.x1[i] + l.x2[i];
+            return s;
+        },
+        [](double a, double b) { return a + b; });
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t N = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : (1 << 20);
+    if (N < 1) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 1]\n";
+        return 1;
+    }
+    const int T = omp_get_max_threads();
+
+    std::cout << "Bhaskara + refinamento de Newton, N = " << N << ", threads = " << T
+              << ", grao = " << GRAO << "\n";
+    std::cout << "tempo em ms (desequilibrio: maior tempo ocupado de thread / media; 1.00 = perfeito)\n";
+    std::cout << "--------------------------------------------------------------------------------------------------\n";
+    std::cout << " carga          |      static       |      dynamic      |      guided       |  roubo de trabalho\n";
+    std::cout << "--------------------------------------------------------------------------------------------------\n";
+
+    Lote lote(N);
+    bool ok = true;
+    for (int carga = 0; carga < 5; ++carga) {
+        preparar_carga(lote, carga);
+
+        // Referência serial (resultados por item idênticos em qualquer escalonamento)
+        for (std::int64_t i = 0; i < N; ++i) resolver(lote, i);
+        const std::vector<double> ref1 = lote.x1, ref2 = lote.x2;
+        double soma_ref = 0.0;
+        for (std::int64_t i = 0; i < N; ++i) soma_ref += ref1[i] + ref2[i];
+
+        std::cout << " " << std::left << std::setw(14) << nome_carga(carga) << std::right;
+        for (Escalonamento e : {Escalonamento::STATIC, Escalonamento::DYNAMIC, Escalonamento::GUIDED, Escalonamento::ROUBO}) {
+            std::fill(lote.x1.begin(), lote.x1.end(), 0.0);
+            std::fill(lote.x2.begin(), lote.x2.end(), 0.0);
+            const Resultado r = rodar(lote, e);
+            ok = ok && lote.x1 == ref1 && lote.x2 == ref2
+                    && std::abs(r.soma - soma_ref) <= 1e-9 * std::abs(soma_ref);
+            std::cout << " | " << std::fixed << std::setprecision(2) << std::setw(8) << r.tempo * 1e3
+                      << " (" << std::setw(5) << r.desequilibrio << ")";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "--------------------------------------------------------------------------------------------------\n";
+    std::cout << (ok ? "Raizes e somas conferidas com a versao serial.\n" : "ERRO: resultados diferentes da versao serial.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. uniforme e alternado: o custo médio por bloco é o mesmo em todas as
+   threads; static é o melhor (nenhum custo de escalonamento) e o roubo
+   empata com ele — ninguém fica sem trabalho, ninguém rouba.
+
+2. rampa (custo crescente): static deixa a última thread bem acima da
+   média. guided se sai bem por sorte: os pedaços grandes do começo são os
+   baratos. Com a rampa ao contrário seria o pior dos quatro. dynamic e
+   roubo equilibram nos dois sentidos.
+
+3. 1% concentrado: todos os itens caros caem no bloco de uma thread no
+   static (e num dos primeiros pedaços grandes no guided), que fica várias
+   vezes acima da média. No roubo, as outras threads roubam metades desse
+   bloco até ele ficar do tamanho do grão.
+
+4. dynamic também equilibra, mas cada pedaço de 256 itens passa pelo mesmo
+   contador atômico; com muitas threads e itens baratos isso aparece. No
+   roubo, a contenção só existe entre a vítima e o ladrão, e só quando há
+   desequilíbrio.
+
+5. Com 1 thread todos os escalonamentos são iguais (desequilíbrio 1.00).
+   Com mais threads que núcleos o tempo total não muda e o desequilíbrio
+   fica ruidoso (o tempo ocupado inclui os intervalos em que o sistema
+   tirou a thread do núcleo): rode numa máquina com vários núcleos.
+
+6. O desequilíbrio soma, por thread, só o tempo DENTRO do corpo (cada
+   faixa de GRAO itens). Não conta a espera no fim: no roubo as threads
+   sem trabalho ficam girando até restantes_ chegar a zero, e medir até a
+   saída de executar daria 1.00 sempre. Por isso os omp for também
+   percorrem faixas de GRAO itens, com o mesmo corpo cronometrado.
+*/
@@ -0,0 +1,501 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 015_expressoes_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Expression templates: a = x*x + y*y + z*z as one fused omp parallel for simd loop, no temporaries
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Expressões vetoriais sem vetores temporários
+-----------------------------------------------------
+ Em 003/004/005 o laço
+     a[i] = x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+ é escrito à mão. Com uma classe de vetor "comum", que sobrecarrega + e *
+ devolvendo um vetor novo, a mesma conta  a = x*x + y*y + z*z  vira:
+     t1 = x*x;  t2 = y*y;  t3 = t1 + t2;  t4 = z*z;  a = t3 + t4;
+ cinco laços, quatro vetores temporários alocados e percorridos na memória.
+ Para vetores grandes o custo é a memória: cada temporário é escrito e
+ lido de volta da RAM.
+
+ EXPRESSION TEMPLATES: x*x + y*y + z*z não calcula nada. Devolve um objeto
+ pequeno cujo TIPO descreve a árvore da expressão:
+     Binaria<Soma, Binaria<Soma, Binaria<Produto, Vetor, Vetor>, ...>, ...>
+ e cujo operator[](i) calcula só o elemento i. A conta acontece na
+ atribuição  a = expr , num único laço
+     #pragma omp parallel for simd
+     for (i...) a[i] = expr[i];
+ que o compilador expande (inline) em  x[i]*x[i] + y[i]*y[i] + z[i]*z[i]:
+ o mesmo código do laço escrito à mão.
+
+ eval(expr) faz o mesmo, mas escolhe o PLANO pelo tamanho da expressão:
+   - custo = n × (operações por elemento);
+   - poucas threads (ou nenhuma região paralela) para expressões pequenas,
+     onde abrir a região custaria mais que a conta (ver 013_pool_0.0);
+   - blocos contíguos por thread, múltiplos de 8 doubles (64 bytes), para
+     duas threads nunca escreverem na mesma linha de cache (os dados do
+     Vetor são alinhados a 64 bytes: cada bloco começa no início de uma linha);
+   - escrita não temporal (escrita_nt.hpp) quando os vetores lidos e o
+     escrito não cabem na última cache: o destino é só escrito, então não
+     precisa ser lido para a cache antes (write-allocate).
+
+ Cuidado: a expressão guarda REFERÊNCIAS para os vetores. Não guarde em
+ 'auto' uma expressão que usa um Vetor temporário:
+     auto e = eval(x) * 2.0;   // o Vetor de eval(x) morre no fim da linha
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+#include <omp.h>
+#include <iomanip>
+
+#include "escrita_nt.hpp"
+
+namespace expr {
+
+/*---------------------------------------------------
+ Plano de execução
+-----------------------------------------------------*/
+struct Plano {
+    int          threads;
+    std::int64_t bloco;     // elementos por pedaço do schedule(static, bloco)
+    bool         streaming = false;   // escrita não temporal no destino
+};
+
+// Trabalho mínimo (n × custo) que justifica mais uma thread: ~10 µs de conta
+constexpr double TRABALHO_POR_THREAD = 32768.0;
+
+// leituras = vetores lidos por elemento (o destino soma mais um)
+inline Plano planejar(std::size_t n, int custo, int leituras = 1, Escrita escrita = Escrita::AUTOMATICA) {
+    const double trabalho = static_cast<double>(n) * std::max(custo, 1);
+    const int T = static_cast<int>(std::clamp(trabalho / TRABALHO_POR_THREAD, 1.0,
+                                              static_cast<double>(omp_get_max_threads())));
+    const std::int64_t por_thread = (static_cast<std::int64_t>(n) + T - 1) / T;
+    const bool nt = usar_streaming(escrita, n * sizeof(double) * static_cast<std::size_t>(leituras + 1));
+    return {T, std::max<std::int64_t>(8, (por_thread + 7) / 8 * 8), nt};
+}
+
+/*---------------------------------------------------
+ Nós da árvore
+-----------------------------------------------------*/
+template <typename E>
+struct Expressao {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+class Vetor;
+
+// Vetores são guardados por referência (nada é copiado); os outros nós, que
+// são pequenos e em geral temporários, por valor.
+template <typename T> struct Guarda         { using tipo = const T; };
+template <>           struct Guarda<Vetor>  { using tipo = const Vetor&; };
+
+struct Escalar : Expressao<Escalar> {
+    static constexpr int custo = 0;
+    static constexpr int leituras = 0;
+    double v;
+    explicit Escalar(double valor) : v(valor) {}
+    double operator[](std::size_t) const { return v; }
+    std::size_t size() const { return 0; }   // 0 = vale para qualquer tamanho
+};
+
+// Operações: custo aproximado em "somas"
+struct Soma      { static constexpr int custo = 1; static double aplicar(double a, double b) { return a + b; } };
+struct Subtracao { static constexpr int custo = 1; static double aplicar(double a, double b) { return a - b; } };
+struct Produto   { static constexpr int custo = 1; static double aplicar(double a, double b) { return a * b; } };
+struct Divisao   { static constexpr int custo = 4; static double aplicar(double a, double b) { return a / b; } };
+struct Negacao   { static constexpr int custo = 1; static double aplicar(double a) { return -a; } };
+struct Raiz      { static constexpr int custo = 8; static double aplicar(double a) { return std::sqrt(a); } };
+struct Modulo    { static constexpr int custo = 1; static double aplicar(double a) { return std::fabs(a); } };
+
+template <typename Op, typename L, typename R>
+struct Binaria : Expressao<Binaria<Op, L, R>> {
+    static constexpr int custo = L::custo + R::custo + Op::custo;
+    static constexpr int leituras = L::leituras + R::leituras;   // x*x conta x duas vezes: limite superior
+    typename Guarda<L>::tipo l;
+    typename Guarda<R>::tipo r;
+
+    Binaria(const L& esquerda, const R& direita) : l(esquerda), r(direita) {
+        assert(l.size() == 0 || r.size() == 0 || l.size() == r.size());
+    }
+    double operator[](std::size_t i) const { return Op::aplicar(l[i], r[i]); }
+    std::size_t size() const { return l.size() ? l.size() : r.size(); }
+};
+
+template <typename Op, typename A>
+struct Unaria : Expressao<Unaria<Op, A>> {
+    static constexpr int custo = A::custo + Op::custo;
+    static constexpr int leituras = A::leituras;
+    typename Guarda<A>::tipo a;
+
+    explicit Unaria(const A& operando) : a(operando) {}
+    double operator[](std::size_t i) const { return Op::aplicar(a[i]); }
+    std::size_t size() const { return a.size(); }
+};
+
+/*---------------------------------------------------
+ Vetor: o único nó que guarda dados
+-----------------------------------------------------
+ std::vector<double> só garante 16 bytes de alinhamento; com este alocador
+ o primeiro elemento fica no início de uma linha de 64 bytes, e os blocos
+ do plano (múltiplos de 8 doubles) também.
+*/
+template <typename T>
+struct AlocadorLinha {
+    using value_type = T;
+    static constexpr std::align_val_t ALINHAMENTO{64};
+
+    AlocadorLinha() = default;
+    template <typename U> AlocadorLinha(const AlocadorLinha<U>&) {}
+
+    T*   allocate(std::size_t n)           { return static_cast<T*>(::operator new(n * sizeof(T), ALINHAMENTO)); }
+    void deallocate(T* p, std::size_t)     { ::operator delete(p, ALINHAMENTO); }
+
+    template <typename U> bool operator==(const AlocadorLinha<U>&) const { return true; }
+    template <typename U> bool operator!=(const AlocadorLinha<U>&) const { return false; }
+};
+
+class Vetor : public Expressao<Vetor> {
+public:
+    static constexpr int custo = 1;   // uma leitura
+    static constexpr int leituras = 1;
+
+    explicit Vetor(std::size_t n = 0, double valor = 0.0) : dados_(n, valor) {}
+
+    // Construir ou atribuir a partir de uma expressão = avaliar com o plano automático
+    template <typename E>
+    Vetor(const Expressao<E>& e) : dados_(e.self().size()) {
+        atribuir(e.self(), planejar(size(), E::custo, E::leituras));
+    }
+
+    template <typename E>
+    Vetor& operator=(const Expressao<E>& e) {
+        // Cada a[i] só depende dos operandos na posição i: a = a*2 + b é seguro
+        if (size() != e.self().size()) dados_.resize(e.self().size());
+        atribuir(e.self(), planejar(size(), E::custo, E::leituras));
+        return *this;
+    }
+
+    // O laço fundido: a expressão inteira é expandida aqui dentro
+    template <typename E>
+    void atribuir(const E& e, const Plano& p) {
+        double* saida = dados_.data();
+        const std::int64_t n = static_cast<std::int64_t>(dados_.size());
+        if (p.streaming) {
+            // Um bloco do plano por vez, linhas inteiras gravadas direto na memória
+            const std::int64_t nblocos = (n + p.bloco - 1) / p.bloco;
+            #pragma omp parallel for num_threads(p.threads) schedule(static) if(p.threads > 1)
+            for (std::int64_t b = 0; b < nblocos; ++b) {
+                preencher_nt(saida, b * p.bloco, std::min(n, (b + 1) * p.bloco),
+                             [&e](std::int64_t i) { return e[i]; });
+            }
+            return;
+        }
+        #pragma omp parallel for simd num_threads(p.threads) schedule(static, p.bloco) if(p.threads > 1)
+        for (std::int64_t i = 0; i < n; ++i) saida[i] = e[i];
+    }
+
+    double  operator[](std::size_t i) const { return dados_[i]; }
+    double& operator[](std::size_t i)       { return dados_[i]; }
+    std::size_t   size() const { return dados_.size(); }
+    double*       data()       { return dados_.data(); }
+    const double* data() const { return dados_.data(); }
+
+private:
+    std::vector<double, AlocadorLinha<double>> dados_;
+};
+
+/*---------------------------------------------------
+ Operadores e funções
+-----------------------------------------------------*/
+#define EXPR_OPERADOR(op, Op)                                                                   \
+    template <typename L, typename R>                                                           \
+    Binaria<Op, L, R> operator op(const Expressao<L>& l, const Expressao<R>& r) {               \
+        return Binaria<Op, L, R>(l.self(), r.self());                                           \
+    }                                                                                           \
+    template <typename L>                                                                       \
+    Binaria<Op, L, Escalar> operator op(const Expressao<L>& l, double r) {                      \
+        return Binaria<Op, L, Escalar>(l.self(), Escalar(r));                                   \
+    }                                                                                           \
+    template <typename R>                                                                       \
+    Binaria<Op, Escalar, R> operator op(double l, const Expressao<R>& r) {                      \
+        return Binaria<Op, Escalar, R>(Escalar(l), r.self());                                   \
+    }
+
+EXPR_OPERADOR(+, Soma)
+EXPR_OPERADOR(-, Subtracao)
+EXPR_OPERADOR(*, Produto)
+EXPR_OPERADOR(/, Divisao)
+#undef EXPR_OPERADOR
+
+template <typename A> Unaria<Negacao, A> operator-(const Expressao<A>& a) { return Unaria<Negacao, A>(a.self()); }
+template <typename A> Unaria<Raiz, A>    sqrt(const Expressao<A>& a)      { return Unaria<Raiz, A>(a.self()); }
+template <typename A> Unaria<Modulo, A>  abs(const Expressao<A>& a)       { return Unaria<Modulo, A>(a.self()); }
+
+// Avaliação explícita: plano automático pelo tamanho, ou plano dado
+template <typename E>
+Plano plano(const Expressao<E>& e, Escrita escrita = Escrita::AUTOMATICA) {
+    return planejar(e.self().size(), E::custo, E::leituras, escrita);
+}
+
+template <typename E>
+Vetor eval(const Expressao<E>& e, const Plano& p) {
+    Vetor v(e.self().size());
+    v.atribuir(e.self(), p);
+    return v;
+}
+
+template <typename E>
+Vetor eval(const Expressao<E>& e) { return eval(e, plano(e)); }
+
+// Redução fundida: soma(x*x + y*y) não cria vetor nenhum
+template <typename E>
+double soma(const Expressao<E>& expressao) {
+    const E& e = expressao.self();
+    const Plano p = planejar(e.size(), E::custo + 1);
+    const std::int64_t n = static_cast<std::int64_t>(e.size());
+    double s = 0.0;
+    #pragma omp parallel for simd num_threads(p.threads) schedule(static, p.bloco) if(p.threads > 1) reduction(+:s)
+    for (std::int64_t i = 0; i < n; ++i) s += e[i];
+    return s;
+}
+
+template <typename E>
+double norma(const Expressao<E>& e) { return std::sqrt(soma(e * e)); }
+
+}  // namespace expr
+
+/*---------------------------------------------------
+ Para comparar: vetor que devolve um temporário a cada operação
+-----------------------------------------------------*/
+struct VetorIngenuo {
+    std::vector<double> d;
+};
+
+template <typename F>
+VetorIngenuo elemento_a_elemento(std::size_t n, F f) {
+    VetorIngenuo r{std::vector<double>(n)};
+    double* saida = r.d.data();
+    #pragma omp parallel for simd schedule(static)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(n); ++i) saida[i] = f(i);
+    return r;
+}
+
+VetorIngenuo operator+(const VetorIngenuo& a, const VetorIngenuo& b) {
+    const double* pa = a.d.data(); const double* pb = b.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return pa[i] + pb[i]; });
+}
+VetorIngenuo operator*(const VetorIngenuo& a, const VetorIngenuo& b) {
+    const double* pa = a.d.data(); const double* pb = b.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return pa[i] * pb[i]; });
+}
+VetorIngenuo operator*(double k, const VetorIngenuo& a) {
+    const double* pa = a.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return k * pa[i]; });
+}
+VetorIngenuo operator/(const VetorIngenuo& a, const VetorIngenuo& b) {
+    const double* pa = a.d.data(); const double* pb = b.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return pa[i] / pb[i]; });
+}
+VetorIngenuo operator+(const VetorIngenuo& a, double k) {
+    const double* pa = a.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return pa[i] + k; });
+}
+VetorIngenuo raiz(const VetorIngenuo& a) {
+    const double* pa = a.d.data();
+    return elemento_a_elemento(a.d.size(), [=](std::int64_t i) { return std::sqrt(pa[i]); });
+}
+
+/*---------------------------------------------------
+ Medição
+-----------------------------------------------------*/
+template <typename F>
+double melhor_ms(F f, int repeticoes) {
+    double m = 1e30;
+    for (int r = 0; r < repeticoes; ++r) {
+        const double t0 = omp_get_wtime();
+        f();
+        m = std::min(m, omp_get_wtime() - t0);
+    }
+    return m * 1e3;
+}
+
+bool iguais(const expr::Vetor& a, const std::vector<double>& b) {
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        if (std::abs(a[i] - b[i]) > 1e-12 * std::max(1.0, std::abs(b[i]))) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    using expr::Vetor;
+    const std::int64_t N_MAX = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 10'000'000;
+
+    std::cout << "a = x*x + y*y + z*z   e   u = 2*x / sqrt(x*x + y*y + z*z + 1)\n";
+    std::cout << "threads disponiveis = " << omp_get_max_threads() << ", tempos em ms (melhor de 5)\n";
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+    std::cout << "         n | plano (thr x bloco) |  a: manual | a: temporarios | a: expressao |  u: temporarios | u: expressao\n";
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+
+    bool ok = true;
+    for (std::int64_t n = 1000; n <= N_MAX; n *= 100) {
+        Vetor x(n), y(n), z(n), a(n), u(n);
+        VetorIngenuo xi{std::vector<double>(n)}, yi{std::vector<double>(n)}, zi{std::vector<double>(n)};
+        for (std::int64_t i = 0; i < n; ++i) {
+            x[i] = xi.d[i] = std::sin(0.001 * i);
+            y[i] = yi.d[i] = std::cos(0.001 * i);
+            z[i] = zi.d[i] = 0.5 + (i % 10) * 0.1;
+        }
+        const int R = 5;
+
+        // 1) À mão, como no 004_loop_for_paralell
+        std::vector<double> a_manual(n);
+        const double t_manual = melhor_ms([&] {
+            const double* px = x.data(); const double* py = y.data(); const double* pz = z.data();
+            double* pa = a_manual.data();
+            #pragma omp parallel for simd schedule(static)
+            for (std::int64_t i = 0; i < n; ++i) pa[i] = px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i];
+        }, R);
+
+        // 2) Um temporário por operação
+        VetorIngenuo ai, ui;
+        const double t_temp_a = melhor_ms([&] { ai = xi * xi + yi * yi + zi * zi; }, R);
+        const double t_temp_u = melhor_ms([&] { ui = 2.0 * xi / raiz(xi * xi + yi * yi + zi * zi + 1.0); }, R);
+
+        // 3) Expression templates: um laço só, nenhum temporário
+        const double t_expr_a = melhor_ms([&] { a = x * x + y * y + z * z; }, R);
+        const double t_expr_u = melhor_ms([&] { u = 2.0 * x / expr::sqrt(x * x + y * y + z * z + 1.0); }, R);
+
+        ok = ok && iguais(a, a_manual) && iguais(a, ai.d) && iguais(u, ui.d);
+
+        const expr::Plano p = expr::plano(x * x + y * y + z * z);
+        std::cout << std::fixed << std::setprecision(3)
+                  << " " << std::setw(9) << n
+                  << " | " << std::setw(5) << p.threads << " x " << std::setw(8) << p.bloco << (p.streaming ? " nt" : "   ")
+                  << " | " << std::setw(10) << t_manual
+                  << " | " << std::setw(14) << t_temp_a
+                  << " | " << std::setw(12) << t_expr_a
+                  << " | " << std::setw(15) << t_temp_u
+                  << " | " << std::setw(12) << t_expr_u << "\n";
+    }
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+
+    // Escrita normal x não temporal no maior n: mesma expressão, só muda o plano
+    {
+        const std::int64_t n = N_MAX;
+        Vetor x(n, 1.0), y(n, 2.0), z(n, 0.5), a(n);
+        const auto e = x * x + y * y + z * z;
+        expr::Plano normal = expr::plano(e, Escrita::NORMAL);
+        expr::Plano nt     = expr::plano(e, Escrita::STREAMING);
+        const double t_normal = melhor_ms([&] { a.atribuir(e, normal); }, 5);
+        const double t_nt     = melhor_ms([&] { a.atribuir(e, nt); }, 5);
+        for (std::int64_t i = 0; i < n; ++i) ok = ok && a[i] == 5.25;
+
+        // Contagem STREAM: 3 vetores lidos + 1 escrito = 32 B por elemento
+        const double bytes = 32.0 * static_cast<double>(n);
+        std::cout << "\nEscrita do destino, n = " << n << " (" << bytes / (1 << 20) << " MB movidos, ultima cache "
+                  << tamanho_ultima_cache() / (1 << 20) << " MB, automatica: "
+                  << (expr::plano(e).streaming ? "streaming" : "normal") << ")\n";
+        std::cout << "  normal   : " << std::setprecision(3) << t_normal << " ms  " << bytes / t_normal * 1e-6 << " GB/s\n";
+        std::cout << "  streaming: " << t_nt << " ms  " << bytes / t_nt * 1e-6 << " GB/s  ("
+                  << t_normal / t_nt << "x)\n\n";
+    }
+
+    // Encadeando: normalizar (x, y, z) e escalar, com a norma calculada por redução fundida
+    const std::int64_t n = std::min<std::int64_t>(N_MAX, 1'000'000);
+    Vetor x(n), y(n), z(n);
+    for (std::int64_t i = 0; i < n; ++i) { x[i] = 1.0 + i % 3; y[i] = 2.0; z[i] = 0.5 * (i % 5); }
+    const double nx = expr::norma(x);
+    const Vetor xn = expr::eval(x / nx);            // plano automático
+    const double nova = expr::norma(xn);            // deve ser 1
+    std::cout << "norma(x) = " << nx << ", norma(x / norma(x)) = " << std::setprecision(12) << nova << "\n";
+    ok = ok && std::abs(nova - 1.0) < 1e-9;
+
+    std::cout << (ok ? "Resultados conferidos (manual, temporarios e expressao).\n" : "ERRO: resultados diferentes.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. "a: expressao" empata com "a: manual": depois do inline, o compilador vê
+   o mesmo laço. Os tipos da árvore existem só em tempo de compilação.
+   Quando o plano marca "nt" (vetores maiores que a última cache) a
+   expressão fica um pouco MAIS rápida que o laço manual: ver item 6.
+
+2. "a: temporarios" faz 5 laços e aloca 4 vetores: para n grande fica
+   várias vezes mais lento — o gargalo é ler e escrever a memória, e a
+   versão com temporários move cerca de 4x mais bytes. Em u a diferença
+   aumenta (mais operações, mais temporários).
+
+3. Para n = 1000 o plano escolhe 1 thread: a conta inteira custa menos que
+   abrir uma região paralela, e o if(p.threads > 1) nem abre a região.
+   Para n grande, todas as threads e um bloco contíguo por thread.
+
+4. soma() e norma() usam a mesma ideia para reduções: norma(x) percorre x
+   uma vez, sem criar x*x.
+
+5. Compile com -O2 ou -O3: sem otimização nada é expandido e cada operator[]
+   vira uma chamada de função.
+
+6. Escrita normal x streaming: com o destino gravado direto na memória o
+   laço deixa de ler a antes de escrever (32 em vez de 40 B por elemento
+   de tráfego real); o ganho esperado fica perto de 1.2x para vetores bem
+   maiores que a cache. Para vetores que cabem na cache a política
+   automática mantém a escrita normal: o resultado continua na cache para
+   a próxima expressão.
+*/
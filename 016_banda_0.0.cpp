@@ -0,0 +1,539 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 016_banda_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Bandwidth benchmark: bytes moved, GB/s, GFLOP/s and fraction of a local STREAM-triad peak
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Banda de memória: quando mais threads deixam de ajudar?
+-----------------------------------------------------
+ O 005_loop_for_paralell_time mede só o tempo total e por thread de
+ a = x*x + y*y + z*z com 1M elementos (32 MB): não dá para saber se o laço
+ está limitado pela CONTA ou pela MEMÓRIA.
+
+ Este programa varre:
+   - o tamanho do conjunto de trabalho (todos os vetores do kernel), de
+     32 KiB (cabe no L1) até --max-mb (padrão 2048 MB, bem acima do L3);
+   - o número de threads, 1, 2, 4, ... até todas.
+
+ Para cada kernel e cada ponto informa:
+   bytes movidos  = elementos × bytes por elemento (contagem do STREAM:
+                    cada vetor lido ou escrito conta uma vez);
+   GB/s           = bytes movidos / tempo;
+   GFLOP/s        = operações de ponto flutuante / tempo;
+   % do pico      = GB/s / banda do STREAM triad medida AQUI, com todas as
+                    threads e vetores de pelo menos 4x o L3 (regra do STREAM).
+
+ Kernels:
+   copia    c = a               16 B/elem  0 flop
+   escala   b = k*c             16 B/elem  1 flop
+   soma     c = a + b           24 B/elem  1 flop
+   triad    a = b + k*c         24 B/elem  2 flops
+   expr     a = x*x+y*y+z*z     32 B/elem  5 flops   (004/005)
+   reducao  s += x              8 B/elem   1 flop    (007_reduction)
+   copia_nt, triad_nt, expr_nt: os mesmos laços com escrita não temporal
+   no vetor de saída (escrita_nt.hpp), sem o write-allocate.
+
+ Todos têm menos de 1 flop por byte: fora das caches são limitados pela
+ memória. Quando o GB/s chega perto do pico, novas threads só disputam o
+ mesmo barramento. O resumo final mostra, para cada kernel e tamanho, a
+ menor quantidade de threads que já atinge 90% da melhor banda.
+
+ Os vetores são alocados sem inicializar (alinhados a 64 bytes) e
+ inicializados em paralelo com o mesmo schedule(static) da medição
+ (primeiro toque, ver 011_numa_0.0).
+
+ Compilar:
+   g++ -O3 -march=native -fopenmp 016_banda_0.0.cpp -o 016_banda_0.0
+
+ Executar:
+   ./016_banda_0.0
+   ./016_banda_0.0 --max-mb=8192 --threads=1,2,4,8,16
+   ./016_banda_0.0 --formato=csv > banda.csv
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <omp.h>
+#if defined(__linux__)
+#include <unistd.h>         // sysconf (_SC_LEVEL*_CACHE_SIZE é extensão da glibc)
+#endif
+
+#include "escrita_nt.hpp"
+
+/*---------------------------------------------------
+ Vetores alinhados e sem inicialização
+-----------------------------------------------------*/
+struct Liberar {
+    void operator()(double* p) const { std::free(p); }
+};
+using Buffer = std::unique_ptr<double[], Liberar>;
+
+Buffer alocar(std::int64_t n) {
+    const std::size_t bytes = (static_cast<std::size_t>(n) * sizeof(double) + 63) / 64 * 64;
+    double* p = static_cast<double*>(std::aligned_alloc(64, std::max<std::size_t>(bytes, 64)));
+    if (!p) throw std::bad_alloc();
+    return Buffer(p);
+}
+
+/*---------------------------------------------------
+ Kernels
+-----------------------------------------------------
+ v[0..3] são os vetores do kernel. Valores iniciais: v0 = 1, v1 = 2,
+ v2 = 0.5, v3 = 1.5. Cada kernel escreve num vetor que não lê, então
+ repetir o kernel dá sempre o mesmo resultado (fácil de conferir).
+*/
+constexpr double K = 3.0;
+
+struct Kernel {
+    const char* nome;
+    int         vetores;           // quantos vetores o kernel usa
+    int         bytes_por_elem;    // contagem STREAM
+    int         flops_por_elem;
+    double    (*executar)(double* const* v, std::int64_t n, int T);   // devolve o escalar (reducao)
+    double      esperado;          // valor de cada elemento da saída (ou da média, na reducao)
+    int         saida;             // índice do vetor escrito (-1: nenhum)
+};
+
+double copia(double* const* v, std::int64_t n, int T) {
+    const double* a = v[0]; double* c = v[2];
+    #pragma omp parallel for simd num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) c[i] = a[i];
+    return 0.0;
+}
+
+double escala(double* const* v, std::int64_t n, int T) {
+    const double* c = v[2]; double* b = v[1];
+    #pragma omp parallel for simd num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) b[i] = K * c[i];
+    return 0.0;
+}
+
+double soma(double* const* v, std::int64_t n, int T) {
+    const double* a = v[0]; const double* b = v[1]; double* c = v[2];
+    #pragma omp parallel for simd num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) c[i] = a[i] + b[i];
+    return 0.0;
+}
+
+double triad(double* const* v, std::int64_t n, int T) {
+    const double* b = v[1]; const double* c = v[2]; double* a = v[0];
+    #pragma omp parallel for simd num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) a[i] = b[i] + K * c[i];
+    return 0.0;
+}
+
+double expressao(double* const* v, std::int64_t n, int T) {
+    const double* x = v[1]; const double* y = v[2]; const double* z = v[3]; double* a = v[0];
+    #pragma omp parallel for simd num_threads(T) schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) a[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+    return 0.0;
+}
+
+double reducao(double* const* v, std::int64_t n, int T) {
+    const double* x = v[0];
+    double s = 0.0;
+    #pragma omp parallel for simd num_threads(T) schedule(static) reduction(+:s)
+    for (std::int64_t i = 0; i < n; ++i) s += x[i];
+    return s / static_cast<double>(n);
+}
+
+// Versões com escrita não temporal: um bloco contíguo por thread, como o schedule(static)
+double copia_nt(double* const* v, std::int64_t n, int T) {
+    const double* a = v[0];
+    preencher_nt_paralelo(v[2], n, T, [a](std::int64_t i) { return a[i]; });
+    return 0.0;
+}
+
+double triad_nt(double* const* v, std::int64_t n, int T) {
+    const double* b = v[1]; const double* c = v[2];
+    preencher_nt_paralelo(v[0], n, T, [b, c](std::int64_t i) { return b[i] + K * c[i]; });
+    return 0.0;
+}
+
+double expressao_nt(double* const* v, std::int64_t n, int T) {
+    const double* x = v[1]; const double* y = v[2]; const double* z = v[3];
+    preencher_nt_paralelo(v[0], n, T, [x, y, z](std::int64_t i) { return x[i] * x[i] + y[i] * y[i] + z[i] * z[i]; });
+    return 0.0;
+}
+
+const Kernel KERNELS[] = {
+    {"copia",   3, 16, 0, copia,     1.0,               2},
+    {"escala",  3, 16, 1, escala,    K * 0.5,           1},
+    {"soma",    3, 24, 1, soma,      1.0 + 2.0,         2},
+    {"triad",   3, 24, 2, triad,     2.0 + K * 0.5,     0},
+    {"expr",    4, 32, 5, expressao, 4.0 + 0.25 + 2.25, 0},
+    {"reducao", 1,  8, 1, reducao,   1.0,              -1},
+    {"copia_nt", 3, 16, 0, copia_nt,     1.0,               2},
+    {"triad_nt", 3, 24, 2, triad_nt,     2.0 + K * 0.5,     0},
+    {"expr_nt",  4, 32, 5, expressao_nt, 4.0 + 0.25 + 2.25, 0},
+};
+
+void inicializar(double* const* v, int vetores, std::int64_t n, int T) {
+    static const double INICIAL[4] = {1.0, 2.0, 0.5, 1.5};
+    for (int k = 0; k < vetores; ++k) {
+        double* p = v[k];
+        const double valor = INICIAL[k];
+        #pragma omp parallel for simd num_threads(T) schedule(static)
+        for (std::int64_t i = 0; i < n; ++i) p[i] = valor;
+    }
+}
+
+bool conferir(const Kernel& k, double* const* v, std::int64_t n, double escalar) {
+    if (k.saida < 0) return std::abs(escalar - k.esperado) < 1e-9;
+    const double* s = v[k.saida];
+    std::int64_t erros = 0;
+    #pragma omp parallel for reduction(+:erros)
+    for (std::int64_t i = 0; i < n; ++i) erros += (s[i] != k.esperado);
+    return erros == 0;
+}
+
+/*---------------------------------------------------
+ Medição de um ponto (kernel, tamanho, threads)
+-----------------------------------------------------*/
+struct Ponto {
+    const char*  kernel;
+    std::int64_t bytes_conjunto;   // tamanho de todos os vetores
+    std::int64_t n;
+    int          threads;
+    double       bytes_movidos;    // por execução
+    double       segundos;         // melhor execução
+    double       gbs;
+    double       gflops;
+    double       fracao_pico;
+    bool         correto;
+};
+
+// Repetições: ~1 GiB movido por ponto, entre 3 e 2000 execuções
+int repeticoes_para(double bytes_movidos) {
+    return static_cast<int>(std::clamp(1073741824.0 / bytes_movidos, 3.0, 2000.0));
+}
+
+Ponto medir(const Kernel& k, std::int64_t bytes_conjunto, int T, double pico) {
+    const std::int64_t n = std::max<std::int64_t>(1, bytes_conjunto / (k.vetores * 8));
+    Buffer b[4];
+    double* v[4] = {nullptr, nullptr, nullptr, nullptr};
+    for (int j = 0; j < k.vetores; ++j) { b[j] = alocar(n); v[j] = b[j].get(); }
+    inicializar(v, k.vetores, n, T);
+
+    Ponto p{};
+    p.kernel         = k.nome;
+    p.bytes_conjunto = bytes_conjunto;
+    p.n              = n;
+    p.threads        = T;
+    p.bytes_movidos  = static_cast<double>(n) * k.bytes_por_elem;
+
+    double escalar = k.executar(v, n, T);   // aquecimento (páginas, caches, threads)
+    double melhor = 1e30;
+    const int R = repeticoes_para(p.bytes_movidos);
+    for (int r = 0; r < R; ++r) {
+        const double t0 = omp_get_wtime();
+        escalar = k.executar(v, n, T);
+        melhor = std::min(melhor, omp_get_wtime() - t0);
+    }
+    p.segundos    = melhor;
+    p.gbs         = p.bytes_movidos / melhor * 1e-9;
+    p.gflops      = static_cast<double>(n) * k.flops_por_elem / melhor * 1e-9;
+    p.fracao_pico = pico > 0.0 ? p.gbs / pico : 0.0;
+    p.correto     = conferir(k, v, n, escalar);
+    return p;
+}
+
+/*---------------------------------------------------
+ Caches e formatação
+-----------------------------------------------------*/
+struct Caches {
+    long l1, l2, l3;
+};
+
+// Sem sysconf com essas chaves (ex.: MinGW/Windows) valem os padrões abaixo
+Caches ler_caches() {
+    Caches c{0, 0, 0};
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    c = {sysconf(_SC_LEVEL1_DCACHE_SIZE), sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE)};
+#endif
+    if (c.l1 <= 0) c.l1 = 32L << 10;    // sysconf devolve 0 ou -1 quando não sabe
+    if (c.l2 <= 0) c.l2 = 1L << 20;
+    if (c.l3 <= 0) c.l3 = 32L << 20;
+    return c;
+}
+
+const char* nivel(std::int64_t bytes, const Caches& c) {
+    if (bytes <= c.l1) return "L1";
+    if (bytes <= c.l2) return "L2";
+    if (bytes <= c.l3) return "L3";
+    return "RAM";
+}
+
+std::string tamanho(double bytes) {
+    const char* unidades[] = {"B", "KiB", "MiB", "GiB"};
+    int u = 0;
+    while (bytes >= 1024.0 && u < 3) { bytes /= 1024.0; ++u; }
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(bytes < 10.0 && u > 0 ? 1 : 0) << bytes << " " << unidades[u];
+    return s.str();
+}
+
+/*--------------------------------------------
+ Argumentos
+-------------------------------------------*/
+template <typename T>
+std::vector<T> lista(const std::string& texto) {
+    std::vector<T> valores;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        std::stringstream conv(item);
+        T v{};
+        conv >> v;
+        valores.push_back(v);
+    }
+    return valores;
+}
+
+bool opcao(const char* arg, const char* nome, std::string& valor) {
+    const std::size_t len = std::strlen(nome);
+    if (std::strncmp(arg, nome, len) != 0 || arg[len] != '=') return false;
+    valor = arg + len + 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::int64_t max_mb = 2048;
+    std::string formato = "tabela";
+    std::vector<int> threads;
+
+    for (int k = 1; k < argc; ++k) {
+        std::string v;
+        if      (opcao(argv[k], "--max-mb", v))  max_mb = std::max<std::int64_t>(1, std::strtoll(v.c_str(), nullptr, 10));
+        else if (opcao(argv[k], "--threads", v)) threads = lista<int>(v);
+        else if (opcao(argv[k], "--formato", v)) formato = v;
+        else {
+            std::cerr << "Argumento desconhecido: " << argv[k] << "\n";
+            return 1;
+        }
+    }
+    for (int t : threads) {
+        if (t <= 0) {
+            std::cerr << "--threads: cada valor deve ser >= 1 (recebido " << t << ")\n";
+            return 1;
+        }
+    }
+    if (formato != "tabela" && formato != "csv") {
+        std::cerr << "--formato: use tabela ou csv (recebido " << formato << ")\n";
+        return 1;
+    }
+
+    // padrão: 1, 2, 4, ... até o número de threads disponíveis
+    if (threads.empty()) {
+        for (int t = 1; t < omp_get_max_threads(); t *= 2) threads.push_back(t);
+        threads.push_back(omp_get_max_threads());
+    }
+    const int T_MAX = *std::max_element(threads.begin(), threads.end());
+    const std::int64_t max_bytes = max_mb << 20;
+    const Caches caches = ler_caches();
+
+    // ---------------------------
+    // 1) Pico local: STREAM triad, todas as threads, cada vetor >= 4x o L3
+    // ---------------------------
+    const Kernel& triad_k = KERNELS[3];
+    const std::int64_t conjunto_pico = std::min<std::int64_t>(max_bytes, 3 * 4 * static_cast<std::int64_t>(caches.l3));
+    const Ponto pico = medir(triad_k, conjunto_pico, T_MAX, 0.0);
+    const bool pico_curto = conjunto_pico < 3 * 4 * static_cast<std::int64_t>(caches.l3);
+
+    // ---------------------------
+    // 2) Varredura: 32 KiB, 128 KiB, ... até max_bytes, para cada kernel e T
+    // ---------------------------
+    std::vector<std::int64_t> conjuntos;
+    for (std::int64_t w = 32 << 10; w < max_bytes; w *= 4) conjuntos.push_back(w);
+    conjuntos.push_back(max_bytes);
+
+    std::vector<Ponto> pontos;
+    bool ok = pico.correto;
+    for (const Kernel& k : KERNELS) {
+        for (std::int64_t w : conjuntos) {
+            for (int T : threads) {
+                pontos.push_back(medir(k, w, T, pico.gbs));
+                ok = ok && pontos.back().correto;
+            }
+        }
+    }
+
+    if (formato == "csv") {
+        std::cout << "kernel,bytes_conjunto,n,threads,bytes_movidos,segundos,gbs,gflops,fracao_pico,correto\n";
+        for (const Ponto& p : pontos) {
+            std::cout << p.kernel << "," << p.bytes_conjunto << "," << p.n << "," << p.threads << ","
+                      << p.bytes_movidos << "," << p.segundos << "," << p.gbs << "," << p.gflops << ","
+                      << p.fracao_pico << "," << (p.correto ? 1 : 0) << "\n";
+        }
+        return ok ? 0 : 1;
+    }
+
+    std::cout << "Caches: L1 " << tamanho(caches.l1) << ", L2 " << tamanho(caches.l2)
+              << ", L3 " << tamanho(caches.l3) << "   threads: ate " << T_MAX << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Pico local (STREAM triad, " << T_MAX << " threads, " << tamanho(conjunto_pico) << "): "
+              << pico.gbs << " GB/s\n";
+    if (pico_curto) std::cout << "  aviso: --max-mb menor que 3 x 4 x L3; o pico pode incluir efeito de cache\n";
+
+    std::cout << "\n-------------------------------------------------------------------------------------------\n";
+    std::cout << " kernel   |  conjunto  | nivel | thr |   bytes/exec |  tempo (us) |    GB/s | GFLOP/s | % pico\n";
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+    for (const Ponto& p : pontos) {
+        std::cout << " " << std::left << std::setw(8) << p.kernel << std::right
+                  << " | " << std::setw(10) << tamanho(static_cast<double>(p.bytes_conjunto))
+                  << " | " << std::setw(5) << nivel(p.bytes_conjunto, caches)
+                  << " | " << std::setw(3) << p.threads
+                  << " | " << std::setw(12) << tamanho(p.bytes_movidos)
+                  << " | " << std::setw(11) << p.segundos * 1e6
+                  << " | " << std::setw(7) << p.gbs
+                  << " | " << std::setw(7) << p.gflops
+                  << " | " << std::setw(5) << std::setprecision(0) << 100.0 * p.fracao_pico << "%"
+                  << std::setprecision(2) << (p.correto ? "" : "  [FALHA]") << "\n";
+    }
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+
+    // ---------------------------
+    // 3) Saturação: menor T que já atinge 90% da melhor banda daquele tamanho
+    // ---------------------------
+    std::cout << "\nSaturacao (menor numero de threads com >= 90% da melhor banda)\n";
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+    const std::size_t por_kernel = conjuntos.size() * threads.size();
+    for (std::size_t kk = 0; kk < std::size(KERNELS); ++kk) {
+        std::cout << " " << std::left << std::setw(8) << KERNELS[kk].nome << std::right << " |";
+        for (std::size_t c = 0; c < conjuntos.size(); ++c) {
+            const Ponto* linha = &pontos[kk * por_kernel + c * threads.size()];
+            double melhor = 0.0;
+            for (std::size_t t = 0; t < threads.size(); ++t) melhor = std::max(melhor, linha[t].gbs);
+            int satura = linha[0].threads;
+            for (std::size_t t = 0; t < threads.size(); ++t) {
+                if (linha[t].gbs >= 0.9 * melhor) { satura = linha[t].threads; break; }
+            }
+            std::cout << " " << tamanho(static_cast<double>(conjuntos[c])) << ": " << satura;
+            if (c + 1 < conjuntos.size()) std::cout << ",";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+
+    // ---------------------------
+    // 4) Escrita não temporal: ganho no maior conjunto, para cada T
+    // ---------------------------
+    auto buscar = [&](const char* nome, int T) -> const Ponto* {
+        for (const Ponto& p : pontos) {
+            if (std::strcmp(p.kernel, nome) == 0 && p.bytes_conjunto == conjuntos.back() && p.threads == T) return &p;
+        }
+        return nullptr;
+    };
+    std::cout << "\nEscrita nao temporal no maior conjunto (" << tamanho(static_cast<double>(conjuntos.back()))
+              << "): GB/s normal -> streaming\n";
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+    const char* pares[][2] = {{"copia", "copia_nt"}, {"triad", "triad_nt"}, {"expr", "expr_nt"}};
+    for (const auto& par : pares) {
+        std::cout << " " << std::left << std::setw(8) << par[0] << std::right << " |";
+        for (int T : threads) {
+            const Ponto* normal = buscar(par[0], T);
+            const Ponto* nt     = buscar(par[1], T);
+            std::cout << "  T=" << T << ": " << normal->gbs << " -> " << nt->gbs
+                      << " (" << nt->gbs / normal->gbs << "x)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+
+    std::cout << (ok ? "Resultados conferidos.\n" : "ERRO: algum kernel produziu resultado errado.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. Nos tamanhos L1/L2 o "% pico" passa de 100%: a banda das caches é
+   muito maior que a da RAM. O pico de referência é o da MEMÓRIA.
+
+2. Na faixa RAM os kernels de streaming param de ganhar com poucas
+   threads (em geral 4 a 8 por soquete): é ali que o resumo de saturação
+   mostra um T menor que o máximo. Mais threads depois disso só gastam
+   energia. Nos tamanhos de cache o ganho continua quase linear, porque
+   cada núcleo tem seu L1/L2.
+
+3. Nos tamanhos pequenos (32 KiB) mais threads podem PIORAR: o tempo de
+   abrir a região paralela (microssegundos) é maior que o próprio laço.
+
+4. A contagem de bytes é a do STREAM e não inclui o "write-allocate": ao
+   escrever num vetor, a CPU primeiro lê a linha da memória para a cache.
+   O tráfego real de copia/escala é 24 B/elem e o de triad 32 B/elem; por
+   isso o GB/s desses kernels fica abaixo do que o hardware move de fato.
+   As versões _nt eliminam essa leitura: na faixa RAM o ganho esperado é
+   ~1.5x na copia (24 -> 16 B), ~1.33x na triad e ~1.25x na expr. Nos
+   tamanhos de cache elas PERDEM, porque a saída sai da cache. Com poucas
+   threads a memória não chega a saturar e o ganho fica abaixo desses
+   valores; compare as linhas _nt com as normais no seu servidor.
+
+5. "expr" (o laço do 004/005) tem 5 flops para 32 bytes: mesmo com SIMD
+   continua limitado pela memória fora das caches; seu GFLOP/s é ~0.16 x GB/s.
+
+6. Com um único núcleo só existe T = 1 e a coluna de saturação é
+   trivial; a curva só aparece numa máquina com vários núcleos.
+*/
@@ -0,0 +1,708 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : 017_precisao_mista_0.0.cpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Mixed precision: float32 kernels with error bounds and automatic double-precision fallback
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*-------------------------------------
+ * NOTICE
+ *-------------------------------------
+ * Parallel Programming Examples in C++ (OpenMP)
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * This product includes software developed by Rodrigo Gonçalves Pinto.
+ *
+ * Academic Attribution:
+ * If you use this software in academic or scientific work, please cite:
+ *   Pinto, R. G. (2025). Parallel Programming Examples in C++ using OpenMP.
+ *   ORCID: https://orcid.org/0009-0008-8360-9538
+ *   University of São Paulo (USP) or University of Brasília (UnB).
+ *
+ * Any distribution of this software or derivative works must reproduce
+ * this NOTICE file.
+ */
+
+/*---------------------------------------------------
+ Precisão mista: float quando basta, double quando precisa
+-----------------------------------------------------
+ Todos os exemplos usam double. Um float tem 24 bits de mantissa (~7
+ dígitos) contra 53 (~16): para salários (R$ com centavos, até milhões)
+ e normas de vetores isso costuma bastar, e em troca
+   - cabem 2x mais valores em cada registrador SIMD (16 floats no AVX-512);
+   - cada valor ocupa 4 bytes: metade do tráfego de memória.
+
+ O risco é usar float onde ele NÃO basta. Por isso cada kernel em float
+ devolve, junto com o resultado, um LIMITE DE ERRO calculado durante a
+ própria conta. Se o limite passar da tolerância pedida, o resultado é
+ refeito em double a partir dos dados originais (e a saída diz que foi).
+
+ Os kernels são templates: A = tipo das contas, T = tipo armazenado.
+     estatistica<float>(x_float, ...)    conta em float
+     estatistica<double>(x_double, ...)  referência e recálculo
+
+ 1. Somas (média, desvio, norma): SOMA EM BLOCOS
+    Um float somado em laço acumula erro proporcional a n: depois de 2^24
+    parcelas de 1.0, somar 1.0 não muda mais nada. Aqui cada bloco de 128
+    valores é somado em float, em 16 pistas SIMD (8 parcelas por pista e
+    4 níveis para juntar as pistas, como numa soma pareada), e os blocos
+    são acumulados em DOUBLE. O erro em float fica preso dentro do bloco:
+        |erro| <= γ(12) · Σ|xᵢ|,   γ(h) = h·u / (1 - h·u),  u = 2⁻²⁴
+    independente de n e do número de threads (~7·10⁻⁷ relativo para
+    valores positivos). O erro de converter cada valor para float também
+    é somado ao limite (Σ|δᵢ|, medido na conversão).
+
+ 2. a = x*x + y*y + z*z: cada elemento tem erro relativo de poucos u,
+    EXCETO quando o float estoura (|x| > 1.8·10¹⁹) ou quando o resultado
+    cai abaixo do menor float normal. Esses elementos são marcados e só
+    eles são refeitos em double.
+
+ 3. Bhaskara (forma estável do 009): Δ é calculado em double a partir dos
+    floats (b² e 4ac de floats são EXATOS em double), as raízes em float.
+    Cada equação calcula seu número de condição κ (quanto o erro das
+    entradas em float se amplifica nas raízes); equações mal condicionadas
+    (raízes quase duplas, Δ perto de zero) ou com estouro são marcadas e
+    refeitas em double a partir dos coeficientes originais.
+
+ Compilar:
+   g++ -O3 -march=native -fopenmp -fno-math-errno -fno-trapping-math 017_precisao_mista_0.0.cpp -o 017_precisao_mista_0.0
+   (-fno-trapping-math deixa o compilador calcular os dois lados dos "?:" do
+   Bhaskara sem se preocupar com exceções de ponto flutuante; sem ele o laço
+   não vetoriza, como o kernel_simd_estavel do 009)
+
+ Executar (N >= 1000 opcional, padrão 10 milhões; tolerância relativa > 0 opcional, padrão 1e-6):
+   ./017_precisao_mista_0.0
+   ./017_precisao_mista_0.0 20000000 1e-5
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <iomanip>
+#include <omp.h>
+
+/*---------------------------------------------------
+ Unidade de arredondamento e limites
+-----------------------------------------------------*/
+template <typename T>
+constexpr double U = std::numeric_limits<T>::epsilon() / 2;   // 2⁻²⁴ (float), 2⁻⁵³ (double)
+
+inline double gama(int h, double u) { return h * u / (1.0 - h * u); }
+
+constexpr std::int64_t BLOCO  = 128;
+constexpr int          PISTAS = 16;
+constexpr int          H_BLOCO = BLOCO / PISTAS + 4;   // 8 somas por pista + 4 níveis entre as 16 pistas
+
+// Abaixo disto o float não serve nem para guardar a entrada: vai direto para double
+constexpr double TOLERANCIA_MINIMA_FLOAT = 16 * U<float>;
+inline bool float_basta(double tolerancia) { return tolerancia >= TOLERANCIA_MINIMA_FLOAT; }
+
+inline bool dentro(double limite, double valor, double tolerancia) {
+    return std::isfinite(valor) && limite <= tolerancia * std::fabs(valor);
+}
+
+/*---------------------------------------------------
+ Dados convertidos para float
+-----------------------------------------------------
+ A conversão mede o erro que ela mesma introduz: Σ|δᵢ| e Σδᵢ², com
+ δᵢ = float(xᵢ) - xᵢ. Esses totais entram nos limites de erro.
+*/
+struct DadosFloat {
+    std::vector<float> v;
+    double erro_abs  = 0.0;
+    double erro_quad = 0.0;
+    bool   finitos   = true;   // nenhum valor estourou o float
+};
+
+DadosFloat para_float(const std::vector<double>& x) {
+    DadosFloat d;
+    d.v.resize(x.size());
+    const std::int64_t n = static_cast<std::int64_t>(x.size());
+    const double* in = x.data();
+    float* out = d.v.data();
+
+    double ea = 0.0, eq = 0.0;
+    long long estouros = 0;
+    #pragma omp parallel for simd schedule(static) reduction(+:ea, eq, estouros)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const float f = static_cast<float>(in[i]);
+        out[i] = f;
+        const double e = static_cast<double>(f) - in[i];
+        ea += std::fabs(e);
+        eq += e * e;
+        estouros += !(std::fabs(f) <= std::numeric_limits<float>::max());
+    }
+    d.erro_abs  = ea;
+    d.erro_quad = eq;
+    d.finitos   = (estouros == 0);
+    return d;
+}
+
+/*---------------------------------------------------
+ Soma em blocos: Σ f(xᵢ) e Σ |f(xᵢ)|
+-----------------------------------------------------
+ Dentro do bloco: 16 acumuladores do tipo A (o compilador os põe num
+ registrador SIMD). Entre blocos: double, com reduction do OpenMP.
+*/
+struct Soma {
+    double soma     = 0.0;
+    double soma_abs = 0.0;
+};
+
+template <typename A, typename T, typename F>
+Soma soma_blocos(const T* x, std::int64_t n, F f) {
+    const std::int64_t nblocos = (n + BLOCO - 1) / BLOCO;
+    double s = 0.0, sa = 0.0;
+
+    #pragma omp parallel for schedule(static) reduction(+:s, sa)
+    for (std::int64_t b = 0; b < nblocos; ++b) {
+        const T* p = x + b * BLOCO;
+        const std::int64_t len = std::min(BLOCO, n - b * BLOCO);
+        A acc[PISTAS] = {};
+        A acc_abs[PISTAS] = {};
+
+        std::int64_t i = 0;
+        for (; i + PISTAS <= len; i += PISTAS) {
+            #pragma omp simd
+            for (int k = 0; k < PISTAS; ++k) {
+                const A v = f(p[i + k]);
+                acc[k]     += v;
+                acc_abs[k] += std::fabs(v);
+            }
+        }
+        for (int k = 0; i + k < len; ++k) {       // sobra do último bloco: no máximo 1 parcela por pista
+            const A v = f(p[i + k]);
+            acc[k]     += v;
+            acc_abs[k] += std::fabs(v);
+        }
+        for (int w = PISTAS / 2; w > 0; w /= 2) {  // junta as pistas em árvore
+            for (int k = 0; k < w; ++k) {
+                acc[k]     += acc[k + w];
+                acc_abs[k] += acc_abs[k + w];
+            }
+        }
+        s  += acc[0];
+        sa += acc_abs[0];
+    }
+    return {s, sa};
+}
+
+// Erro absoluto de uma soma em blocos de n termos com h operações por termo,
+// mais o pior caso de underflow (cada operação perde até meio subnormal).
+template <typename A>
+double limite_soma(const Soma& s, std::int64_t n, int h) {
+    return gama(h, U<A>) * s.soma_abs + static_cast<double>(n) * h * std::numeric_limits<A>::denorm_min();
+}
+
+// Erro de √v' quando |v' - v| <= lim:  |√v' - √v| = |v' - v| / (√v' + √v),
+// com √v >= √(v' - lim); e nunca mais que √lim.
+inline double limite_raiz(double v_calculado, double lim) {
+    const double base = std::sqrt(v_calculado) + std::sqrt(std::max(0.0, v_calculado - lim));
+    return base > 0.0 ? std::min(lim / base, std::sqrt(lim)) : std::sqrt(lim);
+}
+
+/*---------------------------------------------------
+ Média e desvio-padrão (007_reduction_0.1)
+-----------------------------------------------------*/
+struct Estatistica {
+    double media = 0.0, desvio = 0.0;
+    double limite_media = 0.0, limite_desvio = 0.0;   // limites ABSOLUTOS de erro
+    const char* precisao = "double";
+    bool recalculada = false;
+};
+
+template <typename A, typename T>
+Estatistica estatistica(const T* x, std::int64_t n, double erro_abs = 0.0, double erro_quad = 0.0) {
+    Estatistica e;
+    e.precisao = sizeof(A) == sizeof(float) ? "float" : "double";
+
+    const Soma s1 = soma_blocos<A>(x, n, [](T v) { return static_cast<A>(v); });
+    const double lim_soma = limite_soma<A>(s1, n, H_BLOCO);
+    e.media        = s1.soma / static_cast<double>(n);
+    e.limite_media = (lim_soma + erro_abs) / static_cast<double>(n);
+
+    // Segunda passada com μ arredondado para A: Σ(x - μ')² = Σ(x - μ)² + n(μ' - μ)²
+    const A mu = static_cast<A>(e.media);
+    const Soma s2 = soma_blocos<A>(x, n, [mu](T v) { const A d = static_cast<A>(v) - mu; return d * d; });
+    const double var   = s2.soma / static_cast<double>(n);
+    const double d_mu  = U<A> * std::fabs(e.media) + lim_soma / static_cast<double>(n);
+    const double lim_v = limite_soma<A>(s2, n, H_BLOCO + 3) / static_cast<double>(n) + d_mu * d_mu;
+    e.desvio = std::sqrt(var);
+
+    e.limite_desvio = limite_raiz(var, lim_v) + std::sqrt(erro_quad / static_cast<double>(n));   // conversão: <= rms(δ)
+    return e;
+}
+
+// Misto: float se o limite couber na tolerância; senão, double sobre os dados originais
+Estatistica estatistica_mista(const DadosFloat& d, const double* original, double tolerancia) {
+    const std::int64_t n = static_cast<std::int64_t>(d.v.size());
+    if (float_basta(tolerancia) && d.finitos) {
+        const Estatistica e = estatistica<float>(d.v.data(), n, d.erro_abs, d.erro_quad);
+        if (dentro(e.limite_media, e.media, tolerancia) && dentro(e.limite_desvio, e.desvio, tolerancia)) return e;
+    }
+    Estatistica e = estatistica<double>(original, n);
+    e.recalculada = true;
+    return e;
+}
+
+/*---------------------------------------------------
+ Norma euclidiana ‖x‖ = √(Σ xᵢ²)
+-----------------------------------------------------*/
+struct Norma {
+    double valor = 0.0, limite = 0.0;
+    const char* precisao = "double";
+    bool recalculada = false;
+};
+
+template <typename A, typename T>
+Norma norma(const T* x, std::int64_t n, double erro_quad = 0.0) {
+    Norma r;
+    r.precisao = sizeof(A) == sizeof(float) ? "float" : "double";
+    const Soma s = soma_blocos<A>(x, n, [](T v) { const A a = static_cast<A>(v); return a * a; });
+    const double lim_s = limite_soma<A>(s, n, H_BLOCO + 1);
+    r.valor  = std::sqrt(s.soma);
+    r.limite = limite_raiz(s.soma, lim_s) + std::sqrt(erro_quad);   // conversão: |‖x + δ‖ - ‖x‖| <= ‖δ‖
+    return r;
+}
+
+Norma norma_mista(const DadosFloat& d, const double* original, double tolerancia) {
+    const std::int64_t n = static_cast<std::int64_t>(d.v.size());
+    if (float_basta(tolerancia) && d.finitos) {
+        const Norma r = norma<float>(d.v.data(), n, d.erro_quad);
+        if (dentro(r.limite, r.valor, tolerancia)) return r;   // estouro: valor = inf, não passa
+    }
+    Norma r = norma<double>(original, n);
+    r.recalculada = true;
+    return r;
+}
+
+/*---------------------------------------------------
+ a = x*x + y*y + z*z (004/005)
+-----------------------------------------------------
+ Entradas em float, saída em double. Um elemento precisa de double quando
+ o resultado em float estoura ou fica abaixo do menor float normal com
+ alguma entrada não nula (underflow). Fora disso o erro relativo é de
+ poucos u (ver observação 4), abaixo de qualquer tolerância >= 16u.
+*/
+template <typename A, typename T>
+void expressao(const T* x, const T* y, const T* z, double* a, std::int64_t n) {
+    #pragma omp parallel for simd schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        const A xi = x[i], yi = y[i], zi = z[i];
+        a[i] = xi * xi + yi * yi + zi * zi;
+    }
+}
+
+inline bool fora_do_float(float r, float x, float y, float z) {
+    return !(r <= std::numeric_limits<float>::max()) ||
+           (r < std::numeric_limits<float>::min() && (x != 0.0f || y != 0.0f || z != 0.0f));
+}
+
+// Devolve quantos elementos foram refeitos em double. A primeira passada
+// conta as marcas por bloco; a segunda só visita os blocos marcados.
+std::int64_t expressao_mista(const float* x, const float* y, const float* z,
+                             const double* xd, const double* yd, const double* zd,
+                             double* a, std::int64_t n, double tolerancia) {
+    if (!float_basta(tolerancia)) {
+        expressao<double>(xd, yd, zd, a, n);
+        return n;
+    }
+    constexpr std::int64_t BLOCO_MARCAS = 4096;
+    const std::int64_t nblocos = (n + BLOCO_MARCAS - 1) / BLOCO_MARCAS;
+    std::vector<std::int32_t> marcas(nblocos);
+
+    std::int64_t refazer = 0;
+    #pragma omp parallel for schedule(static) reduction(+:refazer)
+    for (std::int64_t b = 0; b < nblocos; ++b) {
+        const std::int64_t fim = std::min(n, (b + 1) * BLOCO_MARCAS);
+        std::int32_t m = 0;
+        #pragma omp simd reduction(+:m)
+        for (std::int64_t i = b * BLOCO_MARCAS; i < fim; ++i) {
+            const float r = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+            a[i] = r;
+            m += fora_do_float(r, x[i], y[i], z[i]);
+        }
+        marcas[b] = m;
+        refazer += m;
+    }
+    if (refazer == 0) return 0;
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (std::int64_t b = 0; b < nblocos; ++b) {
+        if (marcas[b] == 0) continue;
+        const std::int64_t fim = std::min(n, (b + 1) * BLOCO_MARCAS);
+        for (std::int64_t i = b * BLOCO_MARCAS; i < fim; ++i) {
+            if (fora_do_float(static_cast<float>(a[i]), x[i], y[i], z[i]))
+                a[i] = xd[i] * xd[i] + yd[i] * yd[i] + zd[i] * zd[i];
+        }
+    }
+    return refazer;
+}
+
+/*---------------------------------------------------
+ Bhaskara, forma estável (009_bhaskara_lote_0.0, modo ESTAVEL)
+-----------------------------------------------------
+ Δ sempre em double:
+   - de floats: b² e 4ac são exatos em double (24 + 24 bits < 53), então
+     Δ tem UM arredondamento;
+   - de doubles: algoritmo de Kahan com FMA (o mesmo do 009).
+*/
+inline double discriminante(float a, float b, float c) {
+    const double bd = b;
+    return bd * bd - (4.0 * a) * static_cast<double>(c);
+}
+
+inline double discriminante(double a, double b, double c) {
+    const double quatro_a = 4 * a;
+    const double w = quatro_a * c;
+    const double e = std::fma(-quatro_a, c, w);
+    return std::fma(b, b, -w) + e;
+}
+
+constexpr std::uint8_t REFAZER = 255;   // marca na coluna classe: refazer em double
+
+// Uma equação. marcar = true: devolve REFAZER se o erro pode passar da
+// tolerância embutida em limite_kappa (caminho float); marcar = false: nunca marca.
+// É inline para que o laço simd de resolver_lote e o laço de refazer do
+// misto usem o mesmo código sem abrir outra região paralela.
+template <typename T>
+inline void resolver_equacao(T a, T b, T c, double& x1, double& x2, std::uint8_t& classe,
+                             bool marcar, T limite_kappa) {
+    const double delta = discriminante(a, b, c);
+    const bool   ok    = !(delta < 0);
+    const T raiz = std::sqrt(std::fabs(static_cast<T>(delta)));   // só é usada se ok
+
+    const T q         = T(-0.5) * (b + std::copysign(raiz, b));
+    const T x_grande  = q / a;
+    const T x_pequena = (q != 0) ? c / q : T(0);
+    const bool b_negativo = std::signbit(b);
+    const T r1 = ok ? (b_negativo ? x_grande : x_pequena) : T(0);
+    const T r2 = ok ? (b_negativo ? x_pequena : x_grande) : T(0);
+    x1 = r1;
+    x2 = r2;
+
+    // κ(r) = (|a|r² + |b||r| + |c|) / (|r|·√Δ), testado sem dividir:
+    // raiz dupla (√Δ = 0) e estouro (inf/NaN) reprovam
+    const T n1 = std::fabs(a) * r1 * r1 + std::fabs(b * r1) + std::fabs(c);
+    const T n2 = std::fabs(a) * r2 * r2 + std::fabs(b * r2) + std::fabs(c);
+    const bool kappa_ok = (n1 <= limite_kappa * std::fabs(r1) * raiz) && (n2 <= limite_kappa * std::fabs(r2) * raiz);
+
+    // Sem raízes: refaz se o arredondamento das entradas puder mudar o sinal de Δ
+    const double escala = static_cast<double>(b) * b + std::fabs((4.0 * a) * static_cast<double>(c));
+    const bool incerta = marcar && (ok ? !kappa_ok : (-delta <= 4 * U<T> * escala));
+    classe = incerta ? REFAZER : static_cast<std::uint8_t>(ok + (delta > 0));
+}
+
+// tolerancia > 0: marca com REFAZER as equações cujo erro pode passar dela
+// (caminho float); tolerancia = 0: não marca nada (caminho double).
+template <typename T>
+void resolver_lote(const T* a, const T* b, const T* c, double* x1, double* x2, std::uint8_t* classe,
+                   std::int64_t n, double tolerancia) {
+    // Erro relativo das raízes <= (κ + 8)·u: a conta em T erra ~8u, e o erro
+    // de arredondar as entradas para T é amplificado por κ
+    const bool marcar = tolerancia > 0.0;
+    const T limite_kappa = static_cast<T>(tolerancia / U<T>) - 8;
+
+    #pragma omp parallel for simd schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        resolver_equacao(a[i], b[i], c[i], x1[i], x2[i], classe[i], marcar, limite_kappa);
+    }
+}
+
+// Misto: resolve em float; as equações marcadas são refeitas em double com os coeficientes originais
+std::int64_t resolver_lote_misto(const float* af, const float* bf, const float* cf,
+                                 const double* a, const double* b, const double* c,
+                                 double* x1, double* x2, std::uint8_t* classe,
+                                 std::int64_t n, double tolerancia) {
+    if (!float_basta(tolerancia)) {
+        resolver_lote(a, b, c, x1, x2, classe, n, 0.0);
+        return n;
+    }
+    resolver_lote(af, bf, cf, x1, x2, classe, n, tolerancia);
+
+    std::int64_t refeitas = 0;
+    #pragma omp parallel for schedule(static) reduction(+:refeitas)
+    for (std::int64_t i = 0; i < n; ++i) {
+        if (classe[i] != REFAZER) continue;
+        resolver_equacao(a[i], b[i], c[i], x1[i], x2[i], classe[i], false, 0.0);
+        ++refeitas;
+    }
+    return refeitas;
+}
+
+// Referência em long double (009), sem limite de tempo
+std::pair<long double, long double> referencia_long_double(double a, double b, double c) {
+    const long double la = a, lb = b, lc = c;
+    const long double delta = lb * lb - 4 * la * lc;
+    if (delta < 0) return {0.0L, 0.0L};
+    const long double q = -0.5L * (lb + std::copysign(std::sqrt(delta), lb));
+    const long double grande = q / la, pequena = (q != 0) ? lc / q : 0.0L;
+    return (lb < 0) ? std::make_pair(grande, pequena) : std::make_pair(pequena, grande);
+}
+
+double erro_relativo(double x, long double ref) {
+    if (ref == 0) return std::fabs(x);
+    return static_cast<double>(std::fabs((x - ref) / ref));
+}
+
+/*---------------------------------------------------
+ Medição e relatório
+-----------------------------------------------------*/
+template <typename F>
+double melhor_ms(F f, int repeticoes = 5) {
+    double m = 1e30;
+    for (int r = 0; r < repeticoes; ++r) {
+        const double t0 = omp_get_wtime();
+        f();
+        m = std::min(m, omp_get_wtime() - t0);
+    }
+    return m * 1e3;
+}
+
+void linha(const char* caso, double t_double, double t_misto, double erro, double limite, const std::string& precisao) {
+    std::cout << " " << std::left << std::setw(30) << caso << std::right << std::fixed << std::setprecision(2)
+              << " | " << std::setw(9) << t_double << " | " << std::setw(9) << t_misto
+              << " | " << std::setw(5) << t_double / t_misto << "x"
+              << std::scientific << std::setprecision(1)
+              << " | " << std::setw(9) << erro << " | " << std::setw(9) << limite
+              << " | " << precisao << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    const std::int64_t N   = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 10'000'000;
+    const double tolerancia = (argc > 2) ? std::strtod(argv[2], nullptr) : 1e-6;
+    // N >= 1000: cada caso difícil plantado (estouro do float, quase raiz dupla,
+    // b = -1e20 a cada 1000 equações) aparece pelo menos uma vez
+    if (N < 1000 || !(tolerancia > 0.0) || !std::isfinite(tolerancia)) {
+        std::cerr << "Uso: " << argv[0] << " [N >= 1000] [tolerancia relativa > 0]\n";
+        return 1;
+    }
+
+    std::cout << "Precisao mista: N = " << N << ", threads = " << omp_get_max_threads()
+              << ", tolerancia relativa = " << tolerancia << "\n";
+    if (!float_basta(tolerancia)) std::cout << "(tolerancia abaixo de 16u do float: tudo sera feito em double)\n";
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+    std::cout << " caso                           | double ms |  misto ms | ganho |  erro rel | limite rel| usado\n";
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+
+    bool ok = true;
+
+    // ---------------------------
+    // 1) Salários (007_reduction_0.1): média e desvio
+    // ---------------------------
+    {
+        std::vector<double> salarios(N);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < N; ++i) salarios[i] = 4000.0 + (i % 100) * 20.0 + (i % 37) * 0.37;
+        const DadosFloat sf = para_float(salarios);
+
+        Estatistica ref, mista;
+        const double t_d = melhor_ms([&] { ref = estatistica<double>(salarios.data(), N); });
+        const double t_m = melhor_ms([&] { mista = estatistica_mista(sf, salarios.data(), tolerancia); });
+        const double erro_media  = std::fabs(mista.media - ref.media) / ref.media;
+        const double erro_desvio = std::fabs(mista.desvio - ref.desvio) / ref.desvio;
+        const std::string usado = std::string(mista.precisao) + (mista.recalculada ? " (recalculado)" : "");
+        linha("salarios: media", t_d, t_m, erro_media, mista.limite_media / ref.media, usado);
+        linha("salarios: desvio", t_d, t_m, erro_desvio, mista.limite_desvio / ref.desvio, usado);
+        ok = ok && erro_media <= tolerancia && erro_desvio <= tolerancia;
+
+        // Para comparar: o mesmo float com um acumulador só por thread
+        const float* x = sf.v.data();
+        float soma_ingenua = 0.0f;
+        #pragma omp parallel for simd schedule(static) reduction(+:soma_ingenua)
+        for (std::int64_t i = 0; i < N; ++i) soma_ingenua += x[i];
+        std::cout << " " << std::left << std::setw(30) << "  (media em float ingenuo)" << std::right
+                  << " |           |           |       | " << std::scientific << std::setprecision(1) << std::setw(9)
+                  << std::fabs(soma_ingenua / N - ref.media) / ref.media << " |           |\n";
+    }
+
+    // ---------------------------
+    // 2) Lançamentos a débito e crédito: a soma quase se anula (cancelamento)
+    // ---------------------------
+    {
+        std::vector<double> lancamentos(N);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < N; ++i) {
+            const double valor = 10000.0 + (i % 400) * 0.25;      // múltiplos de 0.25: exatos em float
+            lancamentos[i] = (i % 2 == 0) ? valor : -(valor - 0.25 * (i % 3 == 0));
+        }
+        const DadosFloat lf = para_float(lancamentos);
+
+        Estatistica ref, mista;
+        const double t_d = melhor_ms([&] { ref = estatistica<double>(lancamentos.data(), N); });
+        const double t_m = melhor_ms([&] { mista = estatistica_mista(lf, lancamentos.data(), tolerancia); });
+        const double erro = std::fabs(mista.media - ref.media) / std::fabs(ref.media);
+        linha("lancamentos +/-: media", t_d, t_m, erro, mista.limite_media / std::fabs(ref.media),
+              std::string(mista.precisao) + (mista.recalculada ? " (recalculado)" : ""));
+        ok = ok && erro <= tolerancia && mista.recalculada;
+    }
+
+    // ---------------------------
+    // 3) Normas: comum e com componentes enormes (o quadrado estoura o float)
+    // ---------------------------
+    for (int caso = 0; caso < 2; ++caso) {
+        std::vector<double> v(N);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < N; ++i) v[i] = std::sin(0.001 * static_cast<double>(i)) * (caso ? 1e20 : 1.0);
+        const DadosFloat vf = para_float(v);
+
+        Norma ref, mista;
+        const double t_d = melhor_ms([&] { ref = norma<double>(v.data(), N); });
+        const double t_m = melhor_ms([&] { mista = norma_mista(vf, v.data(), tolerancia); });
+        const double erro = std::fabs(mista.valor - ref.valor) / ref.valor;
+        linha(caso ? "norma (componentes ~1e20)" : "norma", t_d, t_m, erro, mista.limite / ref.valor,
+              std::string(mista.precisao) + (mista.recalculada ? " (recalculado)" : ""));
+        ok = ok && erro <= tolerancia && (!float_basta(tolerancia) || mista.recalculada == (caso == 1));
+    }
+
+    // ---------------------------
+    // 4) a = x*x + y*y + z*z com 2 elementos a cada 10⁵ fora da faixa do float
+    // ---------------------------
+    {
+        std::vector<double> x(N), y(N), z(N), a_ref(N), a(N);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < N; ++i) {
+            const double escala = (i % 100000 == 0) ? 1e25 : (i % 100000 == 1) ? 1e-25 : 1.0;
+            x[i] = std::sin(0.001 * i) * escala;
+            y[i] = std::cos(0.001 * i) * escala;
+            z[i] = 0.5 * escala;
+        }
+        const DadosFloat xf = para_float(x), yf = para_float(y), zf = para_float(z);
+
+        std::int64_t refeitos = 0;
+        const double t_d = melhor_ms([&] { expressao<double>(x.data(), y.data(), z.data(), a_ref.data(), N); });
+        const double t_m = melhor_ms([&] {
+            refeitos = expressao_mista(xf.v.data(), yf.v.data(), zf.v.data(), x.data(), y.data(), z.data(),
+                                       a.data(), N, tolerancia);
+        });
+        double erro = 0.0;
+        #pragma omp parallel for schedule(static) reduction(max:erro)
+        for (std::int64_t i = 0; i < N; ++i) erro = std::max(erro, std::fabs(a[i] - a_ref[i]) / a_ref[i]);
+        linha("a = x*x + y*y + z*z", t_d, t_m, erro, float_basta(tolerancia) ? gama(7, U<float>) : gama(5, U<double>),
+              float_basta(tolerancia) ? "float, " + std::to_string(refeitos) + " elem. em double" : "double");
+        ok = ok && erro <= tolerancia &&
+             (!float_basta(tolerancia) || refeitos == (N + 99999) / 100000 + (N + 99998) / 100000);
+    }
+
+    // ---------------------------
+    // 5) Bhaskara em lote: 009 + equações difíceis
+    // ---------------------------
+    {
+        std::vector<double> a(N), b(N), c(N), x1(N), x2(N), m1(N), m2(N);
+        std::vector<std::uint8_t> cl(N), mc(N);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t i = 0; i < N; ++i) {
+            a[i] = 1.0;
+            switch (i % 8) {
+                case 4: case 5: b[i] = 2.0; c[i] = 5.0; break;          // sem raízes reais
+                case 6:         b[i] = -1e4; c[i] = 1.0; break;         // raízes 1e4 e 1e-4
+                case 7:
+                    if (i % 1000 == 7)       { b[i] = -2.0; c[i] = 1.0 - 0x1p-30; }   // quase raiz dupla
+                    else if (i % 1000 == 15) { b[i] = -1e20; c[i] = 1.0; }           // b² estoura o float
+                    else                     { b[i] = -3.0; c[i] = 2.0; }
+                    break;
+                default:        b[i] = -7.0; c[i] = 10.0; break;        // raízes 5 e 2
+            }
+        }
+        const DadosFloat af = para_float(a), bf = para_float(b), cf = para_float(c);
+
+        std::int64_t refeitas = 0;
+        const double t_d = melhor_ms([&] { resolver_lote(a.data(), b.data(), c.data(), x1.data(), x2.data(), cl.data(), N, 0.0); });
+        const double t_m = melhor_ms([&] {
+            refeitas = resolver_lote_misto(af.v.data(), bf.v.data(), cf.v.data(), a.data(), b.data(), c.data(),
+                                           m1.data(), m2.data(), mc.data(), N, tolerancia);
+        });
+
+        double erro = 0.0, erro_double = 0.0;
+        long long classes_erradas = 0;
+        #pragma omp parallel for schedule(static) reduction(max:erro, erro_double) reduction(+:classes_erradas)
+        for (std::int64_t i = 0; i < N; ++i) {
+            const auto ref = referencia_long_double(a[i], b[i], c[i]);
+            erro        = std::max({erro, erro_relativo(m1[i], ref.first), erro_relativo(m2[i], ref.second)});
+            erro_double = std::max({erro_double, erro_relativo(x1[i], ref.first), erro_relativo(x2[i], ref.second)});
+            classes_erradas += (mc[i] != cl[i]);
+        }
+        linha("bhaskara (estavel)", t_d, t_m, erro, 8 * (float_basta(tolerancia) ? U<float> : U<double>),
+              float_basta(tolerancia) ? "float, " + std::to_string(refeitas) + " eq. em double" : "double");
+        std::cout << "   (erro do double: " << std::scientific << std::setprecision(1) << erro_double
+                  << ", classes diferentes: " << classes_erradas << ")\n";
+        ok = ok && erro <= tolerancia && classes_erradas == 0;
+    }
+    std::cout << "------------------------------------------------------------------------------------------------\n";
+    std::cout << (ok ? "Todos os resultados dentro da tolerancia.\n" : "ERRO: resultado fora da tolerancia.\n");
+    return ok ? 0 : 1;
+}
+
+/*
+-----------------------------------------------
+Observações sobre a execução do código:
+-----------------------------------------------
+
+1. "ganho" compara o kernel em double sobre dados double com o kernel
+   misto sobre dados float (a conversão é feita uma vez, fora da medição:
+   é o que se ganha GUARDANDO os dados em float). Para N grande os laços
+   são limitados pela memória e o ganho tende a 2x (metade dos bytes).
+
+2. A média em float com um acumulador por thread ("media em float
+   ingenuo") tem erro que cresce com o número de parcelas por thread, até
+   ~(N/T)·u: com N = 2·10⁶ fica perto de 4·10⁻⁵ e com N = 10⁷ e 1 thread
+   chega a ~2·10⁻⁴. A soma em blocos fica na 7ª casa, abaixo do limite
+   calculado, e não muda com N nem com o número de threads (o float só
+   soma dentro de blocos de 128 valores).
+
+3. "lancamentos +/-" é o caso em que o float NÃO basta: Σ|x| é milhares de
+   vezes maior que |Σx|, o limite passa da tolerância e a média é refeita
+   em double sobre os dados originais. O tempo "misto" inclui as duas
+   passadas: quando o float não basta, tentar custa ~1/3 a mais.
+
+4. Em a = x*x + y*y + z*z cada elemento tem 5 arredondamentos em float
+   (3 produtos e 2 somas de positivos), mais 2u de arredondar as entradas
+   para float (o quadrado dobra o erro relativo): erro <= γ(7) ≈ 4·10⁻⁷.
+   Os elementos com 1e25 (estouro) e 1e-25 (underflow) são refeitos em
+   double; os demais ficam com o resultado em float.
+
+5. Bhaskara: as equações quase duplas e as com b = -1e20 são marcadas e
+   refeitas em double. As equações x² - 10⁴x + 1 NÃO são: na forma estável
+   κ ≈ 2 e o float acerta as duas raízes com ~7 dígitos. O ganho aqui é
+   pequeno (~1,1x): Δ continua em double, e a conversão float <-> double
+   custa quase o que se economiza. Sem -march=native o std::fma do caminho
+   double vira chamada de biblioteca e o "ganho" fica exagerado; sem
+   -fno-trapping-math nenhum dos dois caminhos vetoriza.
+
+6. Com tolerância 1e-8 (abaixo de 16u do float) nada roda em float: o
+   programa detecta isso antes de começar e usa double em tudo (a coluna
+   "misto" mede então a mesma conta da coluna "double").
+*/
@@ -0,0 +1,133 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : ambiente_omp.hpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Apply OMP_* environment defaults that the runtime only reads at load time (re-exec on Linux, hint elsewhere)
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*---------------------------------------------------
+ Variáveis OMP_* que só valem na carga do programa
+-----------------------------------------------------
+ Algumas variáveis de ambiente do OpenMP são lidas UMA vez, quando o
+ runtime carrega, antes do main: OMP_CANCELLATION, OMP_MAX_TASK_PRIORITY,
+ OMP_PROC_BIND, OMP_PLACES, OMP_WAIT_POLICY... Não existe função para
+ ligá-las depois (omp_get_cancellation() só consulta).
+
+ garantir_ambiente_omp() recebe os padrões que o exemplo precisa:
+   - se o usuário já definiu todas, não faz nada (a escolha dele vale);
+   - no Linux, define as que faltam, AVISA no stderr e reexecuta o próprio
+     binário (/proc/self/exe) uma única vez — AULAS_OMP_REEXEC evita laço;
+   - nos demais sistemas (ex.: MinGW/Windows), só mostra o que definir e
+     segue com o ambiente atual.
+
+ rodar_copia() roda o programa como processo filho com uma variável
+ trocada e devolve o código de saída dele (013_pool_0.0 compara políticas
+ assim). Só existe no Linux (#if defined(__linux__)).
+
+ Uso:
+     int main(int argc, char* argv[]) {
+         garantir_ambiente_omp(argv, {{"OMP_CANCELLATION", "true"}});
+         ...
+     }
+
+ Exemplos que usam: 005_loop_for_paralell_time, 007_reduction_0.1,
+ 007_reduction_0.7, 008_sections_0.2, 008_sections_0.3, 011_numa_0.0 e
+ 013_pool_0.0.
+*/
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+#if defined(__linux__)
+#include <unistd.h>         // execv, fork, setenv
+#include <sys/wait.h>       // waitpid
+#endif
+
+struct VariavelOmp {
+    const char* nome;
+    const char* valor;   // padrão usado quando o usuário não definiu
+};
+
+// Retorna normalmente quando nada falta, quando este processo já é a
+// reexecução, fora do Linux ou se execv falhar; senão não retorna.
+inline void garantir_ambiente_omp(char* argv[], std::initializer_list<VariavelOmp> variaveis) {
+    if (std::getenv("AULAS_OMP_REEXEC")) return;
+    bool falta = false;
+    for (const VariavelOmp& v : variaveis) falta = falta || std::getenv(v.nome) == nullptr;
+    if (!falta) return;
+
+#if defined(__linux__)
+    std::fprintf(stderr, "[aviso] reexecutando com");
+    for (const VariavelOmp& v : variaveis) {
+        if (std::getenv(v.nome)) continue;
+        setenv(v.nome, v.valor, 1);
+        std::fprintf(stderr, " %s=%s", v.nome, v.valor);
+    }
+    std::fprintf(stderr, " (defina as variaveis para evitar)\n");
+    setenv("AULAS_OMP_REEXEC", "1", 1);
+    std::fflush(stdout);
+    execv("/proc/self/exe", argv);
+    std::fprintf(stderr, "[aviso] execv falhou; seguindo com o ambiente atual\n");
+#else
+    (void)argv;
+    std::fprintf(stderr, "[aviso] para o efeito completo, defina antes de executar:");
+    for (const VariavelOmp& v : variaveis) {
+        if (!std::getenv(v.nome)) std::fprintf(stderr, " %s=%s", v.nome, v.valor);
+    }
+    std::fprintf(stderr, "\n");
+#endif
+}
+
+#if defined(__linux__)
+// Roda uma cópia do programa com nome=valor (valor nullptr: ambiente herdado)
+// e espera por ela. Devolve o código de saída da cópia, 128 + sinal se ela
+// morreu por um sinal, ou -1 se o processo não pôde ser criado.
+inline int rodar_copia(char* argv[], const char* nome, const char* valor) {
+    std::fflush(stdout);
+    const pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        if (valor) setenv(nome, valor, 1);
+        setenv("AULAS_OMP_REEXEC", "1", 1);
+        execv("/proc/self/exe", argv);
+        _exit(127);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid) return -1;
+    if (WIFEXITED(status))   return WEXITSTATUS(status);
+    if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    return -1;
+}
+#endif
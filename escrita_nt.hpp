@@ -0,0 +1,165 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : escrita_nt.hpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  Non-temporal (streaming) stores for write-once outputs, switched on above a last-level-cache threshold
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*---------------------------------------------------
+ Escrita não temporal (streaming stores)
+-----------------------------------------------------
+ Em  a[i] = x[i]*x[i] + y[i]*y[i] + z[i]*z[i]  o vetor a só é ESCRITO.
+ Mesmo assim, uma escrita normal primeiro LÊ a linha de a da memória para
+ a cache (write-allocate), escreve nela e, mais tarde, a devolve à memória:
+     lidos:   x, y, z e a   (32 B por elemento)
+     escritos: a            ( 8 B por elemento)
+ Um quarto da banda é gasto lendo um valor que vai ser sobrescrito, e as
+ linhas de a ainda expulsam x, y, z da cache.
+
+ A escrita NÃO TEMPORAL (movntpd no x86) junta a linha inteira num buffer
+ de escrita (write-combining) e a manda direto para a memória, sem ler e
+ sem ocupar a cache.
+
+ Só compensa quando a saída NÃO cabe na cache: se o resultado for lido
+ logo em seguida e couber no L3, a escrita normal o deixa lá de graça.
+ Por isso a política AUTOMATICA liga o streaming só quando o que o laço
+ toca passa do tamanho da última cache.
+
+ O OpenMP 5 tem  #pragma omp simd nontemporal(a), mas o GCC 12 aceita e
+ ignora a cláusula; aqui a escrita é feita com _mm_stream_pd (SSE2, presente
+ em todo x86-64). Fora do x86 as funções fazem escrita normal.
+
+ Uso:
+     if (usar_streaming(Escrita::AUTOMATICA, bytes_tocados)) {
+         #pragma omp parallel for schedule(static)
+         for (bloco...) preencher_nt(a, inicio, fim, [&](std::int64_t i) { return x[i] * x[i]; });
+     }
+     ou simplesmente  preencher_nt_paralelo(a, n, threads, valor);
+
+ Exemplos que usam: 009_bhaskara_lote_0.0, 015_expressoes_0.0 e 016_banda_0.0.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+
+#if defined(__linux__)
+#include <unistd.h>         // sysconf (_SC_LEVEL3_CACHE_SIZE é extensão da glibc)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ESCRITA_NT_X86 1
+#endif
+
+enum class Escrita { NORMAL, STREAMING, AUTOMATICA };
+
+inline const char* nome_escrita(Escrita e) {
+    switch (e) {
+        case Escrita::NORMAL:     return "normal";
+        case Escrita::STREAMING:  return "streaming";
+        case Escrita::AUTOMATICA: return "automatica";
+    }
+    return "?";
+}
+
+// Tamanho da última cache (L3, ou L2 se não houver L3); 32 MB se o sistema
+// não souber ou não tiver sysconf com essas chaves (ex.: MinGW/Windows)
+inline std::size_t tamanho_ultima_cache() {
+    static const std::size_t tamanho = [] {
+        long t = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+        t = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (t <= 0) t = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        return t > 0 ? static_cast<std::size_t>(t) : std::size_t{32} << 20;
+    }();
+    return tamanho;
+}
+
+// AUTOMATICA: streaming só se entradas + saídas não couberem na última cache
+inline bool usar_streaming(Escrita e, std::size_t bytes_tocados) {
+    if (e != Escrita::AUTOMATICA) return e == Escrita::STREAMING;
+    return bytes_tocados > tamanho_ultima_cache();
+}
+
+inline bool alinhado_linha(const void* p) {
+    return (reinterpret_cast<std::uintptr_t>(p) & 63) == 0;
+}
+
+// Grava 8 doubles (uma linha) em destino, alinhado a 64 bytes, sem passar pela cache
+inline void guardar_linha_nt(double* destino, const double* linha) {
+#ifdef ESCRITA_NT_X86
+    for (int k = 0; k < 8; k += 2) _mm_stream_pd(destino + k, _mm_loadu_pd(linha + k));
+#else
+    for (int k = 0; k < 8; ++k) destino[k] = linha[k];
+#endif
+}
+
+// As escritas NT não seguem a ordem das demais: a cerca as torna visíveis
+// antes de qualquer escrita posterior (ex.: a barreira do fim do laço).
+inline void cerca_nt() {
+#ifdef ESCRITA_NT_X86
+    _mm_sfence();
+#endif
+}
+
+// saida[i] = valor(i) para i em [inicio, fim): escrita normal até a primeira
+// linha alinhada, linhas inteiras com escrita NT, escrita normal na sobra.
+template <typename F>
+inline void preencher_nt(double* saida, std::int64_t inicio, std::int64_t fim, F valor) {
+    std::int64_t i = inicio;
+    for (; i < fim && !alinhado_linha(saida + i); ++i) saida[i] = valor(i);
+    for (; i + 8 <= fim; i += 8) {
+        alignas(64) double linha[8];
+        #pragma omp simd
+        for (int k = 0; k < 8; ++k) linha[k] = valor(i + k);
+        guardar_linha_nt(saida + i, linha);
+    }
+    for (; i < fim; ++i) saida[i] = valor(i);
+    cerca_nt();
+}
+
+// Mesmo laço dividido entre threads em um bloco contíguo por thread,
+// com fronteiras múltiplas de 8 elementos (nenhuma linha dividida entre threads).
+template <typename F>
+inline void preencher_nt_paralelo(double* saida, std::int64_t n, int threads, F valor) {
+    const std::int64_t por_thread = ((n + threads - 1) / threads + 7) / 8 * 8;
+    #pragma omp parallel for num_threads(threads) schedule(static) if(threads > 1)
+    for (int t = 0; t < threads; ++t) {
+        const std::int64_t inicio = std::min(n, t * por_thread);
+        preencher_nt(saida, inicio, std::min(n, inicio + por_thread), valor);
+    }
+}
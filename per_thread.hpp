@@ -0,0 +1,135 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : per_thread.hpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  PerThread<T>: one cache-line-aligned slot per thread, with combine/reduce (no false sharing)
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*---------------------------------------------------
+ False sharing (compartilhamento falso)
+-----------------------------------------------------
+ O cache não trabalha com bytes soltos, e sim com LINHAS (64 bytes na
+ maioria dos x86 e ARM). Em
+     std::vector<double> thread_time(T);
+     thread_time[tid] += ...;
+ cada thread escreve só no SEU elemento, mas 8 doubles vizinhos dividem a
+ mesma linha: cada escrita invalida a cópia da linha nos outros núcleos e
+ a linha fica "pulando" de núcleo em núcleo. O resultado está certo, só
+ que lento — e piora com o número de threads.
+
+ PerThread<T> dá a cada thread uma posição alinhada ao tamanho da linha
+ (std::hardware_destructive_interference_size), então duas threads nunca
+ escrevem na mesma linha.
+
+ Uso:
+     PerThread<double> tempo;                 // uma posição por thread, zerada
+     #pragma omp parallel
+     {
+         tempo.local() += ...;                // posição da thread atual
+     }
+     double total = tempo.soma();             // ou tempo.combinar(inicial, op)
+     double t3    = tempo[3];                 // posição da thread 3
+
+ O número de posições é fixado na construção (padrão: omp_get_max_threads()
+ NAQUELE momento). Uma região com mais threads que isso — num_threads(n)
+ maior, ou omp_set_num_threads() chamado depois — acessaria fora do vetor:
+ construa com o tamanho da equipe que vai usar. Em compilação de depuração
+ (sem -DNDEBUG) local() e operator[] conferem o índice com assert.
+
+ Exemplos que usam: 005_loop_for_paralell_time, 006_sincronizacao_0.5,
+ 006_sincronizacao_0.8 (medição do ganho) e 007_reduction_0.7.
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <vector>
+#include <omp.h>
+
+// O GCC avisa (-Winterference-size) que o valor pode mudar com -mtune: aqui ele
+// só define o layout dentro do próprio programa, não uma ABI pública.
+#ifdef __cpp_lib_hardware_interference_size
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+constexpr std::size_t TAMANHO_LINHA_CACHE = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+constexpr std::size_t TAMANHO_LINHA_CACHE = 64;
+#endif
+
+// Um valor sozinho na sua linha de cache (ocupa múltiplos de TAMANHO_LINHA_CACHE bytes)
+template <typename T>
+struct alignas(TAMANHO_LINHA_CACHE) LinhaPropria {
+    T valor{};
+};
+
+template <typename T>
+class PerThread {
+public:
+    // Por padrão, uma posição para cada thread que uma região paralela pode ter
+    explicit PerThread(int threads = omp_get_max_threads(), const T& inicial = T{})
+        : slots_(threads > 0 ? threads : 1, LinhaPropria<T>{inicial}) {}
+
+    // Posição da thread que está executando (dentro de uma região paralela).
+    // A equipe não pode ter mais threads que size().
+    T&       local()       { return (*this)[omp_get_thread_num()]; }
+    const T& local() const { return (*this)[omp_get_thread_num()]; }
+
+    T&       operator[](int t)       { assert(t >= 0 && t < size()); return slots_[t].valor; }
+    const T& operator[](int t) const { assert(t >= 0 && t < size()); return slots_[t].valor; }
+
+    int size() const { return static_cast<int>(slots_.size()); }
+
+    // Combina todas as posições em ordem de thread: op(op(op(inicial, [0]), [1]), ...)
+    template <typename Op>
+    T combinar(T inicial, Op op) const {
+        for (const auto& s : slots_) inicial = op(inicial, s.valor);
+        return inicial;
+    }
+
+    T soma() const { return combinar(T{}, std::plus<>{}); }
+
+    void preencher(const T& valor) {
+        for (auto& s : slots_) s.valor = valor;
+    }
+
+private:
+    // C++17: std::vector respeita o alignas do tipo (new alinhado)
+    std::vector<LinhaPropria<T>> slots_;
+};
@@ -0,0 +1,82 @@
+/*-------------------------------------------------------------------------------------------------------------------------
+ * File Name : vetor_numa.hpp
+ * Author    : Prof. Rodrigo Gonçalves Pinto
+ * Institution: University of Brasília (UnB) / University of São Paulo (USP) /IESB /SENAC
+ * Course    : Parallel and Distributed Programming
+ * Objective :  VetorNuma<T>: std::vector that does not touch its pages on construction (NUMA first-touch)
+ * Semester  : 2026/2
+ * Version   : 1.0
+ *
+ * History:
+ *   Creation date : 2026-10-17
+ *   Update date   : 2026-10-17
+ *   Updated by    : Rodrigo Gonçalves Pinto
+ *   Changes made  : First version.
+ --------------------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------
+ * Apache License, Version 2.0
+ *-------------------------------------
+ * Copyright (c) 2023–2026 Rodrigo Gonçalves Pinto
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications: Please maintain all change logs in the "History" section above.
+ */
+
+/*---------------------------------------------------
+ Alocador que NÃO inicializa os elementos
+-----------------------------------------------------
+ std::vector<T>(N) chama construct(p) para cada elemento, e o construct
+ padrão faz "T()", que para double é 0.0 -> escreve em todas as páginas,
+ numa única thread. Pela regra do primeiro toque (ver 011_numa_0.0) todas
+ as páginas ficam no nó NUMA dessa thread.
+
+ Aqui construct(p) sem argumentos faz "new (p) T" (inicialização default):
+ para tipos simples não gera nenhuma escrita. Quem usa VetorNuma precisa
+ inicializar os elementos em paralelo, com o MESMO schedule(static) dos
+ laços de cálculo:
+
+     VetorNuma<double> x(N);                  // nenhuma página tocada
+     #pragma omp parallel for schedule(static)
+     for (int i = 0; i < N; ++i) x[i] = ...;  // cada thread toca o seu pedaço
+     ...
+     #pragma omp parallel for schedule(static)
+     for (int i = 0; i < N; ++i) ... x[i] ... // mesmo pedaço, memória local
+
+ Exemplos que usam: 005_loop_for_paralell_time, 007_reduction_0.1 e 011_numa_0.0.
+*/
+
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <typename T>
+struct AlocadorSemInit : std::allocator<T> {
+    template <typename U> struct rebind { using other = AlocadorSemInit<U>; };
+
+    AlocadorSemInit() = default;
+    template <typename U> AlocadorSemInit(const AlocadorSemInit<U>&) {}
+
+    template <typename U>
+    void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+};
+
+template <typename T>
+using VetorNuma = std::vector<T, AlocadorSemInit<T>>;